@@ -15,7 +15,8 @@ int main(int argc, char** argv) {
   options.add_options()
     ("h,help", "Show help")
     ("d,debug", "Debug level (0: nothing, 1: error, 2: warning)", cxxopts::value<int>(), "LEVEL")
-    ("e,error-exit", "Exit on first error");
+    ("e,error-exit", "Exit on first error")
+    ("memory-stats", "Write the memory used per heap and category, with its peak, to FILE as JSON at exit", cxxopts::value<std::string>(), "FILE");
   ;
   // clang-format on
 
@@ -36,6 +37,7 @@ int main(int argc, char** argv) {
   vkl::DebugOption debugOption = {
       .debugLevel  = debugLevel,
       .exitOnError = result.count("error-exit") > 0,
+      .memoryStats = result.count("memory-stats") ? result["memory-stats"].as<std::string>() : "",
   };
 
   vkl::ParticleSystem app("vkLavaMpm", debugOption);
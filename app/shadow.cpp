@@ -16,9 +16,19 @@ int main(int argc, char** argv) {
   options.add_options()
     ("h,help", "Show help")
     ("m,model", "Path to a model to visualize (if not specified draw a triangle)", cxxopts::value<std::string>(), "FILE");
+  options.add_options("Model")
+    ("no-cache", "Always parse the model, don't read nor write the .vkmesh cache")
+    ("cache-dir", "Directory of the .vkmesh cache (default: next to the model)", cxxopts::value<std::string>(), "DIR")
+    ("compact", "Upload quantized vertices (16-bit positions, octahedral normals, half UVs)")
+    ("optimize", "Reorder the mesh for the vertex cache, overdraw and vertex fetch (cached separately)")
+    ("meshlets", "Split the mesh in meshlets of 64 vertices and 124 triangles, with their culling bounds")
+    ("lod", "Build simplified levels of detail, chosen per pass from their error on screen")
+    ("stream-textures", "Upload the small mip levels of the textures first, the others as the screen needs them")
+    ("out-of-core", "Keep the mesh on disk, split in clusters streamed to the device as they come into view");
   options.add_options("Dev")
     ("d,debug", "Debug level (0: nothing, 1: error, 2: warning)", cxxopts::value<int>(), "LEVEL")
-    ("e,error-exit", "Exit on first error");
+    ("e,error-exit", "Exit on first error")
+    ("memory-stats", "Write the memory used per heap and category, with its peak, to FILE as JSON at exit", cxxopts::value<std::string>(), "FILE");
   ;
   // clang-format on
 
@@ -48,11 +58,23 @@ int main(int argc, char** argv) {
   vkl::DebugOption debugOption = {
       .debugLevel  = debugLevel,
       .exitOnError = result.count("error-exit") > 0,
+      .memoryStats = result.count("memory-stats") ? result["memory-stats"].as<std::string>() : "",
+  };
+
+  vkl::ModelOption modelOption = {
+      .useCache       = result.count("no-cache") == 0,
+      .cacheDir       = result.count("cache-dir") ? result["cache-dir"].as<std::string>() : "",
+      .vertexFormat   = result.count("compact") ? vkl::VertexFormat::Compact : vkl::VertexFormat::Float,
+      .optimize       = result.count("optimize") > 0,
+      .meshlets       = result.count("meshlets") > 0,
+      .lod            = result.count("lod") > 0,
+      .streamTextures = result.count("stream-textures") > 0,
+      .outOfCore      = result.count("out-of-core") > 0,
   };
 
   vkl::ShadowMapping::initialize();
 
-  vkl::ShadowMapping app("vk3DLoader", debugOption, modelPath);
+  vkl::ShadowMapping app("vk3DLoader", debugOption, modelPath, modelOption);
 
   try {
     app.run();
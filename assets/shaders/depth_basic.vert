@@ -1,10 +1,8 @@
 #version 450
 #extension GL_ARB_separate_shader_objects : enable
 
+// Only the position stream is bound in the depth pass
 layout(location = 0) in vec3 positions;
-layout(location = 1) in vec3 normals;
-layout(location = 2) in vec3 colors;
-layout(location = 3) in vec2 texCoords;
 
 struct UniformBufferObject {
   mat4 depthMVP;
@@ -0,0 +1,20 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+// Position stream of CompactVertex, see depth_basic.vert for the float layout
+layout(location = 0) in vec4 positions;  // unorm, in the model bounding box
+
+struct UniformBufferObject {
+  mat4 depthMVP;
+};
+
+layout(binding = 0) uniform UBO { UniformBufferObject ubo; };
+
+layout(push_constant) uniform Quantization {
+  vec4 offset;
+  vec4 scale;
+} quant;
+
+out gl_PerVertex { vec4 gl_Position; };
+
+void main() { gl_Position = ubo.depthMVP * vec4(quant.offset.xyz + positions.xyz * quant.scale.xyz, 1.0); }
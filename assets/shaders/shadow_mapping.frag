@@ -1,10 +1,10 @@
 #version 450
 #extension GL_ARB_separate_shader_objects : enable
+#extension GL_EXT_nonuniform_qualifier : require
 
 /**
  * in
  */
-layout(binding = 3) uniform sampler2D texturename;
 
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;
@@ -16,6 +16,9 @@ layout(location = 6) in vec2 inTexCoords;
 
 // layout(constant_id = 0) const bool enabledShadowMap = true;
 
+// Only with --stream-textures, nothing reads the feedback otherwise
+layout(constant_id = 0) const bool writeFeedback = false;
+
 // peut etre input_attachment_index = index in pInputAttachments
 // layout(input_attachment_index = 0, binding = 1) uniform subpassInput inputColor;
 // layout(input_attachment_index = 0, binding = 1) uniform subpassInput inputDepth;
@@ -31,9 +34,24 @@ struct Material {
   vec3 DiffuseColor;
   vec3 SpecularColor;
   float Shininess;
+  uint TextureIndex;
+};
+
+layout(std430, binding = 2) readonly buffer Materials { Material u_Materials[]; };
+
+// Read back to stream the levels of each texture, see TextureFeedback
+struct TextureFeedback {
+  uint samples;
+  uint minLod;  // in 1/16 of a level, from 16 levels above the first one of the view
 };
 
-layout(binding = 2) uniform M { Material u_Material; };
+layout(std430, binding = 3) buffer Feedback { TextureFeedback feedback[]; };
+
+// Every texture of the model, sized when the descriptor sets are allocated
+layout(binding = 4) uniform sampler2D textures[];
+
+// After the quantization of the vertex stage
+layout(push_constant) uniform Draw { layout(offset = 32) uint materialIndex; } draw;
 
 /**
  * out
@@ -95,17 +113,33 @@ void main() {
   vec3 N = normalize(inNormal);
   vec3 L = normalize(inLightVec);
 
+  Material material = u_Materials[draw.materialIndex];
+
   float dist        = length(inLightVec);
   dist              = dist * dist;
   float attenuation = 1.0 / dist;
 
-  vec3 diffuseColor  = u_Material.DiffuseColor * Lambert(N, L);
-  vec3 specularColor = u_Material.SpecularColor * Phong(N, L, V, u_Material.Shininess);
+  vec3 diffuseColor  = material.DiffuseColor * Lambert(N, L);
+  vec3 specularColor = material.SpecularColor * Phong(N, L, V, material.Shininess);
   vec3 directColor   = (diffuseColor + specularColor) * lightColor * attenuation;
 
-  vec3 indirectColor = u_Material.AmbientColor;
+  vec3 indirectColor = material.AmbientColor;
   vec3 color         = directColor + indirectColor;
-  vec4 texel = texture(texturename, inTexCoords);
+
+  // The material comes from a push constant, so the index is the same for the whole draw
+  const uint textureIndex = material.TextureIndex;
+  vec4 texel              = texture(textures[textureIndex], inTexCoords);
+
+  if (writeFeedback) {
+    // Outside of the branch on the fragment, the derivatives need the whole quad
+    float lod = textureQueryLod(textures[textureIndex], inTexCoords).y;
+
+    // One fragment out of 16 is enough to tell how fine the texture is seen
+    if ((uint(gl_FragCoord.x) & 3u) == 0u && (uint(gl_FragCoord.y) & 3u) == 0u) {
+      atomicAdd(feedback[textureIndex].samples, 1u);
+      atomicMin(feedback[textureIndex].minLod, uint(clamp(lod + 16.0, 0.0, 32.0) * 16.0));
+    }
+  }
   color = mix(color, texel.xyz, texel.a);
 
   // Apply shadow mapping
@@ -116,5 +150,5 @@ void main() {
   color = pow(color, vec3(1.0 / 2.2));
 
   outColor =  vec4(color, 1.0);
-  // outColor =  texture(texturename, inTexCoords);
+  // outColor =  texture(textures[material.TextureIndex], inTexCoords);
 }
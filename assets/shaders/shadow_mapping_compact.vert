@@ -0,0 +1,63 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+// CompactVertex, see shadow_mapping.vert for the float layout
+layout(location = 0) in vec4 inPositions;  // unorm, in the model bounding box
+layout(location = 1) in vec2 inNormals;    // octahedral
+layout(location = 2) in vec2 texCoords;
+
+struct UniformBufferObject {
+  mat4 model;
+  mat4 view;
+  mat4 proj;
+  mat4 depthBiasMVP;
+  vec3 lightPos;
+};
+
+layout(binding = 0) uniform UBO { UniformBufferObject ubo; };
+
+layout(push_constant) uniform Quantization {
+  vec4 offset;
+  vec4 scale;
+} quant;
+
+layout(location = 0) out vec3 outPosition;
+layout(location = 1) out vec3 outNormal;
+layout(location = 2) out vec4 outShadowCoord;
+layout(location = 3) out vec3 outLightPos;
+layout(location = 4) out vec3 outLightVec;
+layout(location = 5) out vec3 outViewVec;
+layout(location = 6) out vec2 outTexCoords;
+
+out gl_PerVertex { vec4 gl_Position; };
+
+const mat4 biasMat = mat4(0.5, 0.0, 0.0, 0.0, 0.0, 0.5, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.5, 0.5, 0.0, 1.0);
+
+vec3 octDecode(vec2 e) {
+  vec3 n  = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+  float t = max(-n.z, 0.0);
+  n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+  return normalize(n);
+}
+
+void main(void) {
+  const vec3 cameraPos = vec3(2);
+
+  vec3 positions = quant.offset.xyz + inPositions.xyz * quant.scale.xyz;
+  vec3 normals   = octDecode(inNormals);
+
+  vec3 ModPos = vec3(ubo.model * vec4(positions, 1.0));
+
+  outPosition = ModPos;
+  outNormal   = vec3(transpose(inverse(ubo.model)) * vec4(normals, 0.0));
+  gl_Position = ubo.proj * ubo.view * vec4(ModPos, 1);
+
+  outShadowCoord = (biasMat * ubo.depthBiasMVP) * vec4(ModPos, 1);
+  outLightPos    = ubo.lightPos;
+
+  vec3 lPos   = mat3(ubo.model) * ubo.lightPos;
+  outLightVec = lPos - ModPos;
+  outViewVec  = cameraPos - ModPos;
+
+  outTexCoords= texCoords;
+}
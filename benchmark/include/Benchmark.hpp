@@ -0,0 +1,54 @@
+/**
+ * @file Benchmark.hpp
+ * @brief Small helpers shared by the benchmarks
+ */
+
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+  /**
+   * @brief Run func several times and return the best time, in milliseconds
+   */
+  template <typename F> double measure(F&& func, int iterations = 5) {
+    double best = std::numeric_limits<double>::max();
+
+    for (int i = 0; i < iterations; ++i) {
+      const auto start = std::chrono::high_resolution_clock::now();
+      func();
+      const auto end = std::chrono::high_resolution_clock::now();
+
+      best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    return best;
+  }
+
+  /**
+   * @brief Files given on the command line, or every file of directory with the extension
+   */
+  inline std::vector<std::string> inputs(int argc, char** argv, const std::string& directory,
+                                         const std::string& extension) {
+    std::vector<std::string> files(argv + 1, argv + argc);
+
+    if (files.empty() && std::filesystem::is_directory(directory)) {
+      for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.path().extension() == extension) files.push_back(entry.path().string());
+      }
+      std::sort(files.begin(), files.end());
+    }
+
+    return files;
+  }
+
+}  // namespace bench
+
+#endif  // BENCHMARK_HPP
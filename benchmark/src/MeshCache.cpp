@@ -0,0 +1,50 @@
+/**
+ * Compare a cold model load (OBJ parsing, indexing and cache writing) with a warm one (.vkmesh cache read).
+ *
+ * Usage: MeshCacheBenchmark [model.obj ...]
+ * Without argument, every model of assets/models is loaded (run it from the root of the repository).
+ * Caches are written in a temporary directory, the assets are left untouched.
+ */
+
+#include <Benchmark.hpp>
+#include <common/Model.hpp>
+#include <common/loader/MeshCache.hpp>
+
+#include <cstdio>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+int main(int argc, char** argv) {
+  const std::vector<std::string> models = bench::inputs(argc, argv, "assets/models", ".obj");
+
+  if (models.empty()) {
+    std::fprintf(stderr, "No model found, run from the repository root or give .obj files\n");
+    return 1;
+  }
+
+  const vkl::ModelOption option = {
+      .useCache = true,
+      .cacheDir = (fs::temp_directory_path() / "vkl_mesh_cache_benchmark").string(),
+  };
+
+  std::printf("%-40s %10s %10s %10s %8s\n", "model", "size (KB)", "cold (ms)", "warm (ms)", "speedup");
+
+  for (const std::string& model : models) {
+    const std::string cachePath = vkl::MeshCache::Path(model, option.cacheDir);
+
+    const double coldTime = bench::measure([&]() {
+      fs::remove(cachePath);
+      vkl::Model::LoadMesh(model, option);
+    });
+
+    const double warmTime = bench::measure([&]() { vkl::Model::LoadMesh(model, option); });
+
+    std::printf("%-40s %10ju %10.2f %10.2f %7.2fx\n", fs::path(model).filename().string().c_str(),
+                static_cast<uintmax_t>(fs::file_size(model) / 1024), coldTime, warmTime, coldTime / warmTime);
+  }
+
+  fs::remove_all(option.cacheDir);
+
+  return 0;
+}
@@ -0,0 +1,45 @@
+/**
+ * Time of the CPU mip chain generation, the fallback of the device blits, on large textures.
+ *
+ * Usage: MipmapBenchmark [size ...]
+ * Without argument, square textures of 1024, 2048 and 4096 texels are generated.
+ */
+
+#include <Benchmark.hpp>
+#include <common/image/Mipmap.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+  std::vector<uint32_t> sizes;
+  for (int i = 1; i < argc; ++i) sizes.push_back(static_cast<uint32_t>(std::stoul(argv[i])));
+  if (sizes.empty()) sizes = {1024, 2048, 4096};
+
+  std::printf("%-12s %8s %12s %12s %12s\n", "size", "levels", "linear (ms)", "sRGB (ms)", "MTexel/s");
+
+  for (uint32_t size : sizes) {
+    std::vector<uint8_t> source(size_t(size) * size * 4);
+    for (size_t i = 0; i < source.size(); ++i) source[i] = static_cast<uint8_t>(std::rand());
+
+    const uint32_t levels = vkl::image::mipLevels(size, size);
+    std::vector<uint8_t> pixels;
+
+    const double linearTime = bench::measure([&]() {
+      pixels = source;
+      vkl::image::buildMipChain(pixels, size, size, levels, false);
+    });
+    const double srgbTime = bench::measure([&]() {
+      pixels = source;
+      vkl::image::buildMipChain(pixels, size, size, levels, true);
+    });
+
+    std::printf("%-12s %8u %12.2f %12.2f %12.1f\n", (std::to_string(size) + "x" + std::to_string(size)).c_str(), levels,
+                linearTime, srgbTime, double(size) * size / 1e3 / srgbTime);
+  }
+
+  return 0;
+}
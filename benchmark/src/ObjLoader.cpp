@@ -0,0 +1,44 @@
+/**
+ * Compare tinyobj::LoadObj with ObjLoader::Load.
+ *
+ * Usage: ObjLoaderBenchmark [model.obj ...]
+ * Without argument, every model of assets/models is loaded (run it from the root of the repository).
+ */
+
+#define TINYOBJLOADER_IMPLEMENTATION
+#include <tiny_obj_loader.h>
+
+#include <Benchmark.hpp>
+#include <common/loader/ObjLoader.hpp>
+
+#include <cstdio>
+#include <filesystem>
+
+int main(int argc, char** argv) {
+  const std::vector<std::string> models = bench::inputs(argc, argv, "assets/models", ".obj");
+
+  if (models.empty()) {
+    std::fprintf(stderr, "No model found, run from the repository root or give .obj files\n");
+    return 1;
+  }
+
+  std::printf("%-40s %10s %12s %12s %8s\n", "model", "size (KB)", "tinyobj (ms)", "ObjLoader (ms)", "speedup");
+
+  for (const std::string& model : models) {
+    const double tinyobjTime = bench::measure([&]() {
+      tinyobj::attrib_t attrib;
+      std::vector<tinyobj::shape_t> shapes;
+      std::vector<tinyobj::material_t> materials;
+      std::string err;
+      tinyobj::LoadObj(&attrib, &shapes, &materials, &err, model.c_str());
+    });
+
+    const double objLoaderTime = bench::measure([&]() { vkl::ObjLoader::Load(model); });
+
+    std::printf("%-40s %10ju %12.2f %14.2f %7.2fx\n", std::filesystem::path(model).filename().string().c_str(),
+                static_cast<uintmax_t>(std::filesystem::file_size(model) / 1024), tinyobjTime, objLoaderTime,
+                tinyobjTime / objLoaderTime);
+  }
+
+  return 0;
+}
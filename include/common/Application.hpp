@@ -15,6 +15,7 @@
 #include <common/SwapChain.hpp>            // for SwapChain
 #include <common/SyncObjects.hpp>          // for SyncObjects
 #include <common/Window.hpp>               // for Window
+#include <chrono>                          // for steady_clock
 #include <string>                          // for allocator, string
 #include <iostream>
 // clang-format on
@@ -36,6 +37,7 @@ namespace vkl {
   struct DebugOption {
     int debugLevel;
     bool exitOnError;
+    std::string memoryStats;  // JSON file the memory statistics are written to at exit, none if empty
   };
 
   class Application : public NoCopy, NoMove {
@@ -45,7 +47,8 @@ namespace vkl {
         android_app* androidApp,
 #endif
         const std::string& appName,
-        const DebugOption& debugOption);
+        const DebugOption& debugOption,
+        const DeviceRequirements& deviceRequirements = {});
 
 #ifndef __ANDROID__
     static void initialize() {
@@ -61,6 +64,9 @@ namespace vkl {
 #endif
 
   protected:
+    // Taken before anything else is created, to measure the startup
+    const std::chrono::steady_clock::time_point launchTime = std::chrono::steady_clock::now();
+
     Instance instance;
     DebugUtilsMessenger debugMessenger;
     Window window;
@@ -68,11 +74,19 @@ namespace vkl {
     SwapChain swapChain;
     SyncObjects syncObjects;
 
+    const std::string memoryStatsPath;
+
     size_t currentFrame = 0;
 
     VkResult prepareFrame(bool useFences, bool& framebufferResized, uint32_t& imageIndex);
     void submitFrame(bool useFences, bool& framebufferResized, const uint32_t& imageIndex);
 
+    /**
+     * @brief Write the statistics of the device memory to DebugOption::memoryStats, with their peaks, if it is set
+     * @throw Throws an exception if the file can't be written
+     */
+    void writeMemoryStats() const;
+
     virtual void recreateSwapChain(bool& framebufferResized) = 0;
   };
 }  // namespace vkl
@@ -10,6 +10,7 @@
 #include <common/VulkanHeader.hpp>  // for VkDescriptorSet, VkDescriptorSet_T
 #include <common/NoCopy.hpp>       // for NoCopy
 #include <common/image/Image.hpp>
+#include <cstdint>               // for uint32_t
 #include <vector>                // for vector
 namespace vkl { class DescriptorPool; }
 namespace vkl { class DescriptorSetLayout; }
@@ -32,7 +33,17 @@ namespace vkl {
                    const std::vector<const IUniformBuffers*>& uniformBuffers);
     // ~DescriptorSets(); no need destructor because VkDescriptorSet is deleted when pool is deleted
 
-    inline const VkDescriptorSet& descriptor(int index) const { return m_descriptorSets.at(index); }
+    /**
+     * @brief The set of the image, a single set is shared by all of them
+     */
+    inline const VkDescriptorSet& descriptor(int index) const {
+      return m_descriptorSets.at(m_descriptorSets.size() == 1 ? 0 : index);
+    }
+
+    /**
+     * @brief The offsets to bind the set with for the image, one per dynamic uniform buffer in binding order
+     */
+    std::vector<uint32_t> dynamicOffsets(int index) const;
 
     void recreate();
 
@@ -46,7 +57,11 @@ namespace vkl {
     const std::vector<const IBuffer*>& m_buffers;
     const std::vector<const IUniformBuffers*>& m_uniformBuffers;
 
-    void allocateDescriptorSets();
+    /**
+     * @param count One per image of the swap chain, or one for all if they only differ by dynamic offsets
+     * @param variableDescriptorCount Size of the last binding of the layout, when it is variable
+     */
+    void allocateDescriptorSets(size_t count, uint32_t variableDescriptorCount = 0);
     virtual void createDescriptorSets() = 0;
   };
 }  // namespace vkl
@@ -7,16 +7,27 @@
 #define DEVICE_HPP
 
 // clang-format off
-#include <common/VulkanHeader.hpp>    // for VkPhysicalDevice, VkQueue, VkDevice
+#include <common/VulkanHeader.hpp>    // for VkPhysicalDevice, VkQueue, VkDevice, VkPhysicalDeviceFeatures
 #include <common/NoCopy.hpp>         // for NoCopy
 #include <common/QueueFamily.hpp>  // for QueueFamilyIndices
+#include <memory>                  // for unique_ptr
 #include <vector>                  // for vector
 namespace vkl { class Instance; }
+namespace vkl { class MemoryAllocator; }
+namespace vkl { class SamplerCache; }
 namespace vkl { class Window; }
 // clang-format on
 
 namespace vkl {
 
+  /**
+   * @brief What an application needs from the device beyond drawing to the window, devices without it are skipped
+   */
+  struct DeviceRequirements {
+    bool textureArray    = false;  // an array of textures sized when the descriptor set is allocated, Vulkan 1.2
+    bool textureFeedback = false;  // stores and atomics in the fragment shader
+  };
+
   /**
    * @brief  A class which allows to manage devices.
    *
@@ -26,13 +37,38 @@ namespace vkl {
    */
   class Device : public NoCopy {
   public:
-    Device(const Instance& instance, const Window& window, const std::vector<const char*>& extensions);
+    Device(const Instance& instance,
+           const Window& window,
+           const std::vector<const char*>& extensions,
+           const DeviceRequirements& requirements = {});
     ~Device();
 
     inline const VkPhysicalDevice& physical() const { return m_physical; }
     inline const VkDevice& logical() const { return m_logical; }
     inline const QueueFamilyIndices& queueFamilyIndices() const { return m_indices; }
 
+    /**
+     * @brief Features enabled on the logical device, those the application uses when the physical device has them
+     */
+    inline const VkPhysicalDeviceFeatures& features() const { return m_features; }
+
+    inline const VkPhysicalDeviceLimits& limits() const { return m_properties.limits; }
+
+    /**
+     * @brief Whether VK_EXT_memory_budget is enabled, enabled whenever the device has it and Vulkan 1.1
+     */
+    inline bool memoryBudget() const { return m_memoryBudget; }
+
+    /**
+     * @brief The samplers shared by the images of the device
+     */
+    inline SamplerCache& samplers() const { return *m_samplers; }
+
+    /**
+     * @brief The memory of the buffers and images of the device
+     */
+    inline MemoryAllocator& allocator() const { return *m_allocator; }
+
     inline const VkQueue& graphicsQueue() const { return m_graphicsQueue; }
     inline const VkQueue& computeQueue() const { return m_computeQueue; }
     inline const VkQueue& transferQueue() const { return m_transferQueue; }
@@ -41,6 +77,12 @@ namespace vkl {
   private:
     VkPhysicalDevice m_physical;
     VkDevice m_logical;
+    VkPhysicalDeviceFeatures m_features;
+    VkPhysicalDeviceDescriptorIndexingFeatures m_descriptorIndexing;
+    VkPhysicalDeviceProperties m_properties;
+    bool m_memoryBudget;
+    std::unique_ptr<SamplerCache> m_samplers;
+    std::unique_ptr<MemoryAllocator> m_allocator;
 
     const Instance& m_instance;
     const Window& m_window;
@@ -55,11 +97,20 @@ namespace vkl {
     static uint32_t GetQueueFamilyIndex(const std::vector<VkQueueFamilyProperties>& families,
                                         const VkQueueFlagBits& queueFlags);
 
-    static VkPhysicalDevice PickPhysicalDevice(const VkInstance& instance,
+    static VkPhysicalDevice PickPhysicalDevice(const Instance& instance,
                                                const VkSurfaceKHR& surface,
-                                               const std::vector<const char*>& requiredExtensions);
+                                               const std::vector<const char*>& requiredExtensions,
+                                               const DeviceRequirements& requirements);
+
+    static bool IsDeviceSuitable(const Instance& instance,
+                                 const VkPhysicalDevice& device,
+                                 const VkSurfaceKHR& surface,
+                                 const DeviceRequirements& requirements);
 
-    static bool IsDeviceSuitable(const VkPhysicalDevice& device, const VkSurfaceKHR& surface);
+    /**
+     * @brief Whether the device can sample from an array of textures sized when the descriptor set is allocated
+     */
+    static bool SupportsTextureArray(const Instance& instance, const VkPhysicalDevice& device);
   };
 }  // namespace vkl
 
@@ -33,6 +33,11 @@ namespace vkl {
 
     void recreate();
 
+    /**
+     * @brief The memory of the device per heap and category, current and peak, inside an ImGui window
+     */
+    void drawMemoryStats() const;
+
   private:
     VkDescriptorPool imGuiDescriptorPool;
 
@@ -9,6 +9,7 @@
 // clang-format off
 #include <common/VulkanHeader.hpp>  // for VkInstance, VkInstance_T
 #include <common/NoCopy.hpp>       // for NoCopy
+#include <cstdint>               // for uint32_t
 #include <string>                // for string
 #include <vector>                // for vector
 // clang-format on
@@ -28,12 +29,18 @@ namespace vkl {
     inline const VkInstance& handle() const { return m_instance; }
     inline bool validationLayersEnabled() const { return m_enableValidationLayers; }
 
+    /**
+     * @brief The version the instance was created with, the loader's up to 1.2
+     */
+    inline uint32_t apiVersion() const { return m_apiVersion; }
+
     static const std::vector<const char*> ValidationLayers;
     static const std::vector<const char*> DeviceExtensions;
 
   private:
     VkInstance m_instance;
     bool m_enableValidationLayers;
+    uint32_t m_apiVersion;
 
     /**
      * @brief Checks that the validation layers specified in Instance :: ValidationLayers are well supported.
@@ -9,26 +9,176 @@
 
 #include <common/struct/Material.hpp>
 #include <common/image/Texture.hpp>
+#include <common/image/TextureCache.hpp>
 #include <common/CommandPool.hpp>
+#include <common/buffer/ClusterStreamer.hpp>
+#include <common/buffer/IndexBuffer.hpp>
+#include <common/buffer/MeshletBuffer.hpp>
+#include <common/buffer/StagingHeap.hpp>
+#include <common/buffer/StagingRing.hpp>
+#include <common/buffer/VertexBuffer.hpp>
+#include <common/loader/ClusterFile.hpp>
+#include <common/mesh/Frustum.hpp>
+#include <common/mesh/Lod.hpp>
+#include <common/mesh/MeshData.hpp>
+#include <common/mesh/Meshlet.hpp>
+#include <common/mesh/Streams.hpp>
+#include <common/struct/CompactVertex.hpp>
 #include <common/struct/Vertex.hpp>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
 
 namespace vkl {
 
+  struct ModelOption {
+    bool useCache        = true;  // read / write the .vkmesh cache
+    std::string cacheDir = "";    // where to put the cache, next to the model if empty
+    VertexFormat vertexFormat = VertexFormat::Float;
+    bool optimize = false;        // reorder triangles and vertices for the vertex cache, overdraw and fetch
+    bool meshlets = false;        // split the triangles in clusters with culling bounds, see mesh::splitMeshlets
+    uint32_t meshletVertices  = mesh::DefaultMeshletVertices;   // limits of the clusters the triangles are split in
+    uint32_t meshletTriangles = mesh::DefaultMeshletTriangles;
+    bool lod = false;             // simplify the mesh to mesh::DefaultLodRatios of its triangles
+    bool streamTextures = false;  // upload the tail of the mip chains first, see TextureStreamer
+    bool outOfCore = false;       // read the clusters of an OBJ from disk as they come into view, see ClusterFile
+    VkDeviceSize clusterBudget = ClusterStreamer::DefaultMemoryBudget;  // device memory for them
+  };
+
+  /**
+   * @brief A mesh with its textures, built on the CPU first then uploaded
+   *
+   * The first step can run on a loading thread (see ModelLoader), the upload needs the thread which owns the queue.
+   */
   class Model {
   public:
-    Model(const Device& device, const CommandPool& commandPool, const std::string& modelPath);
+    /**
+     * @param cache Its resident textures are not decoded again, the others are decoded into staging memory of its
+     * device; can be null
+     * @throw Throws an exception if the model or one of its textures can't be loaded
+     */
+    Model(const std::string& modelPath, const ModelOption& option = {}, const TextureCache* cache = nullptr);
+    Model(MeshData mesh, const ModelOption& option = {}, const TextureCache* cache = nullptr);
+
+    /**
+     * @brief Create the device local buffers, take the textures from the cache, and copy them through the ring
+     *
+     * Returns once the copies are submitted, without waiting for them: the host copy of the geometry is released, the
+     * decoded pixels once uploaded() is true, and the model must not be drawn before.
+     */
+    void upload(const Device& device, StagingRing& staging, TextureCache& cache);
+
+    /**
+     * @brief Whether the copies of upload() are done, then the decoded pixels are released; never blocks
+     */
+    bool uploaded(StagingRing& staging);
+
+    /**
+     * @brief A single degenerate triangle and the blank texture, uploaded before returning
+     *
+     * Drawn while the real model is loading, it keeps every buffer and descriptor valid.
+     */
+    static Model Placeholder(const Device& device,
+                             StagingRing& staging,
+                             TextureCache& cache,
+                             const ModelOption& option = {});
+
+    /**
+     * @brief The geometry as loaded, until upload(); the buffers then have the only copy
+     */
+    inline const std::vector<Vertex>& vertices() const { return m_mesh.vertices; }
+    inline const std::vector<uint32_t>& indices() const { return m_mesh.indices; }
+    inline const std::vector<Material>& materials() const { return m_mesh.materials; }
+    inline const std::vector<std::shared_ptr<Texture>>& textures() const { return m_textures; }
+
+    /**
+     * @brief The file and format of each texture, in the same order
+     */
+    inline const std::vector<TextureCache::Key>& textureKeys() const { return m_textureKeys; }
+
+    /**
+     * @brief The clusters of triangles of the model with ModelOption::meshlets, the index buffer then lists the
+     * triangles meshlet after meshlet; their vertices and triangles until upload()
+     */
+    inline const mesh::Meshlets& meshlets() const { return m_meshlets; }
+
+    /**
+     * @brief The index buffer of every level of detail, only the full mesh without ModelOption::lod; its indices until
+     * upload(), the levels and ranges after
+     */
+    inline const mesh::LodChain& lodChain() const { return m_lodChain; }
 
-    inline const std::vector<Vertex>& vertices() const { return m_vertices; }
-    inline const std::vector<Material>& materials() const { return m_materials; }
-    inline const std::vector<std::unique_ptr<Texture>>& textures() const { return m_textures; }
+    /**
+     * @brief The vertices to upload, in the layout chosen by ModelOption::vertexFormat, split in two streams, until
+     * upload()
+     */
+    inline VertexFormat vertexFormat() const { return m_vertexFormat; }
+    inline const Quantization& quantization() const { return m_quantization; }
+    inline const mesh::VertexStreams& vertexStreams() const { return m_vertexStreams; }
+
+    /**
+     * @brief The buffers, after upload(); out of core, those of the resident clusters. The meshlet buffer only exists
+     * with ModelOption::meshlets
+     */
+    inline const VertexBuffer& vertexBuffer() const {
+      return m_clusterStreamer ? m_clusterStreamer->vertexBuffer() : *m_vertexBuffer;
+    }
+    inline const IndexBuffer& indexBuffer() const {
+      return m_clusterStreamer ? m_clusterStreamer->indexBuffer() : *m_indexBuffer;
+    }
+    inline const MeshletBuffer& meshletBuffer() const { return *m_meshletBuffer; }
+
+    /**
+     * @brief Whether the mesh stays on disk (ModelOption::outOfCore), drawn from the clusters streamClusters() made
+     * resident
+     */
+    inline bool outOfCore() const { return m_clusterFile != nullptr; }
+
+    /**
+     * @brief Stream the clusters the frusta see, and list the resident ones in the only level of lodChain()
+     *
+     * Once per frame, after upload() and before recording the draws; framesInFlight as in ClusterStreamer::update.
+     */
+    void streamClusters(StagingRing& staging,
+                        const std::vector<mesh::Frustum>& frusta,
+                        const glm::vec3& viewer,
+                        uint32_t framesInFlight);
+
+    inline ClusterStreamer::Stats clusterStats() const { return m_clusterStreamer->stats(); }
+
+    /**
+     * @brief Build the CPU side of a model, from its cache when it is up to date
+     * @throw Throws an exception if the model can't be loaded
+     */
+    static MeshData LoadMesh(const std::string& modelPath, const ModelOption& option = {});
 
   private:
-    std::vector<Vertex> m_vertices;
-    std::vector<Material> m_materials;
-    std::vector<std::unique_ptr<Texture>> m_textures;
+    Model(MeshData mesh,
+          std::unique_ptr<ClusterFile> clusterFile,
+          const ModelOption& option,
+          const TextureCache* cache);
+
+    MeshData m_mesh;
+    mesh::Meshlets m_meshlets;
+    mesh::LodChain m_lodChain;
+    std::vector<TextureCache::Key> m_textureKeys;  // each file once
+    std::vector<Texture::Pixels> m_images;          // decoded, until upload(); empty if resident in the cache
+    std::unique_ptr<StagingHeap> m_stagingHeap;     // holds the decoded pixels, when there is a cache
+    uint64_t m_uploadSerial = 0;                    // last submission of upload(), see StagingRing::done
+    std::vector<std::shared_ptr<Texture>> m_textures;
+
+    VertexFormat m_vertexFormat;
+    Quantization m_quantization;
+    mesh::VertexStreams m_vertexStreams;
+
+    std::unique_ptr<VertexBuffer> m_vertexBuffer;
+    std::unique_ptr<IndexBuffer> m_indexBuffer;
+    std::unique_ptr<MeshletBuffer> m_meshletBuffer;
+
+    std::unique_ptr<ClusterFile> m_clusterFile;  // only out of core
+    std::unique_ptr<ClusterStreamer> m_clusterStreamer;
+    VkDeviceSize m_clusterBudget;
   };
 
 }  // namespace vkl
@@ -0,0 +1,44 @@
+/**
+ * @file ModelLoader.hpp
+ * @brief Define ModelLoader class
+ */
+
+#ifndef MODELLOADER_HPP
+#define MODELLOADER_HPP
+
+#include <common/Model.hpp>
+#include <common/NoCopy.hpp>
+#include <future>
+#include <string>
+
+namespace vkl {
+
+  /**
+   * @brief Build a Model on a background thread : parse or cache, mesh processing and texture decode
+   *
+   * The thread which owns the graphics queue polls the loader once per frame, then takes the model and uploads it.
+   */
+  class ModelLoader : public NoCopy {
+  public:
+    /**
+     * @param cache Asked which textures are resident, it must outlive the loader
+     */
+    ModelLoader(const std::string& modelPath, const TextureCache& cache, const ModelOption& option = {});
+
+    /**
+     * @brief Non blocking, true once take() can be called
+     */
+    bool ready() const;
+
+    /**
+     * @throw Rethrows the exception of the loading thread
+     */
+    Model take();
+
+  private:
+    std::future<Model> m_loading;  // its destructor waits for the thread
+  };
+
+}  // namespace vkl
+
+#endif  // MODELLOADER_HPP
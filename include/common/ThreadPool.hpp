@@ -0,0 +1,72 @@
+/**
+ * @file ThreadPool.hpp
+ * @brief Define ThreadPool class
+ */
+
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <common/NoCopy.hpp>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace vkl {
+
+  /**
+   * @brief A fixed set of worker threads consuming a FIFO of tasks.
+   *
+   * Tasks must not block on other tasks of the same pool: wait on the returned futures from a thread which is not a
+   * worker (the main thread, a loading thread ...).
+   */
+  class ThreadPool : public NoCopy {
+  public:
+    explicit ThreadPool(size_t numThreads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    inline size_t size() const { return m_workers.size(); }
+
+    /**
+     * @brief Queue a task
+     * @return A future holding the result (or the exception) of the task
+     */
+    template <typename F> auto submit(F&& func) -> std::future<std::invoke_result_t<F>> {
+      using R = std::invoke_result_t<F>;
+
+      auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(func));
+      std::future<R> result = task->get_future();
+
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.emplace([task]() { (*task)(); });
+      }
+      m_condition.notify_one();
+
+      return result;
+    }
+
+    /**
+     * @brief Shared pool sized on the hardware concurrency, used by the loaders
+     */
+    static ThreadPool& Shared();
+
+  private:
+    std::vector<std::thread> m_workers;
+    std::queue<std::function<void()>> m_tasks;
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stop = false;
+
+    void work();
+  };
+
+}  // namespace vkl
+
+#endif  // THREADPOOL_HPP
@@ -9,7 +9,9 @@
 
 #include <common/VulkanHeader.hpp>
 #include <cstring>  // memcpy
+#include <span>
 #include <stdexcept>
+#include <vector>
 
 #include <common/Device.hpp>
 #include <common/buffer/StorageBuffer.hpp>
@@ -17,54 +19,63 @@
 namespace vkl {
 
   /**
-   * @brief A templating class to define buffer
+   * @brief A templating class to define a host visible buffer of T, filled from a span
+   *
+   * The data isn't kept on the host: the device has its copy. Retained keeps one, which data() edits and update()
+   * writes again, for small data changed on the CPU such as the materials of the UI.
    */
   template <typename T> class Buffer : public StorageBuffer {
   public:
-    Buffer(const Device& device,
-           const std::vector<T>& bufferData,
-           VkDeviceSize size,
-           VkBufferUsageFlags usage,
-           VkMemoryPropertyFlags properties)
-        : StorageBuffer(device, size, usage, properties), m_bufferData(bufferData) {}
+    enum HostCopy { Dropped, Retained };
 
     Buffer(const Device& device,
-           const std::vector<T>& bufferData,
+           std::span<const T> bufferData,
            VkBufferUsageFlags usage,
-           VkMemoryPropertyFlags properties)
-        : Buffer(device, bufferData, sizeof(T) * bufferData.size(), usage, properties) {
-      // Step 3 - Remplissage du vertex buffer
-      void* data;
+           VkMemoryPropertyFlags properties,
+           HostCopy hostCopy       = Dropped,
+           MemoryCategory category = MemoryCategory::Other)
+        : StorageBuffer(device, sizeof(T) * bufferData.size(), usage, properties, category),
+          m_count(bufferData.size()) {
+      if (hostCopy == Retained) m_bufferData.assign(bufferData.begin(), bufferData.end());
+
+      // Step 3 - Remplissage du buffer
 
       /**
-       * Note Exposé : La fonction vkMapMemory permet d'accéder à une région spécifique d'une ressource.
-       * Il faut indiquer un décalage et une taille. On met ici 0 et bufferInfo.size.
-       * L'avant-dernier paramètre est un champ de bits (flags) pour l'instant non implémenté par
-       * Vulkan. Il est impératif de le laisser à 0. "is reserved for future use"
-       * Le dernier paramètre permet de fournir un pointeur vers la mémoire mappée.
+       * Note Exposé : mapped() pointe sur la région de la mémoire du buffer, qui partage son bloc avec d'autres
+       * buffers (voir MemoryAllocator). Le bloc reste mappé toute sa vie, flush() n'agit que sans HOST_COHERENT.
        */
-      vkMapMemory(m_device.logical(), m_bufferMemory, 0, m_bufferSize, 0, &data);
-      memcpy(data, m_bufferData.data(), (size_t)m_bufferSize);
-      vkUnmapMemory(m_device.logical(), m_bufferMemory);
+      write(bufferData);
     }
 
+    /**
+     * @brief The number of T in the buffer, whether or not they are retained
+     */
+    inline size_t count() const { return m_count; }
+
+    /**
+     * @brief The retained copy, empty unless Retained
+     */
     inline std::vector<T>& data() { return m_bufferData; }
     inline const std::vector<T>& data() const { return m_bufferData; }
 
     /**
-     * @brief Just update the buffer, for example if in imgui with change the value of bufferData
+     * @brief Overwrite the T from first on
      */
-    void update(float time, uint32_t currentImage) {
-      void* data;
-      vkMapMemory(m_device.logical(), m_bufferMemory, 0, m_bufferSize, 0, &data);
-      memcpy(data, m_bufferData.data(), m_bufferSize);
-      vkUnmapMemory(m_device.logical(), m_bufferMemory);
+    void write(std::span<const T> bufferData, size_t first = 0) {
+      memcpy(static_cast<T*>(mapped()) + first, bufferData.data(), bufferData.size_bytes());
+      flush(sizeof(T) * first, bufferData.size_bytes());
     }
 
+    /**
+     * @brief Just update the buffer from the retained copy, for example if in imgui with change the value of bufferData
+     */
+    void update(float time, uint32_t currentImage) { write(m_bufferData); }
+
   protected:
-    std::vector<T> m_bufferData;  // normaly is struct type like Depth, MVP, Vertex, Material ...
+    size_t m_count;
+    std::vector<T> m_bufferData;  // only Retained, normaly is struct type like Material
   };
 
 }  // namespace vkl
 
-#endif  // BUFFER_HPP
\ No newline at end of file
+#endif  // BUFFER_HPP
@@ -0,0 +1,116 @@
+/**
+ * @file ClusterStreamer.hpp
+ * @brief Define ClusterStreamer class
+ */
+
+#ifndef CLUSTERSTREAMER_HPP
+#define CLUSTERSTREAMER_HPP
+
+#include <common/NoCopy.hpp>
+#include <common/VulkanHeader.hpp>
+#include <common/buffer/IndexBuffer.hpp>
+#include <common/buffer/StagingRing.hpp>
+#include <common/buffer/VertexBuffer.hpp>
+#include <common/loader/ClusterFile.hpp>
+#include <common/mesh/Frustum.hpp>
+#include <common/mesh/Lod.hpp>
+#include <common/struct/CompactVertex.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+namespace vkl {
+
+  class Device;
+
+  /**
+   * @brief Keep on the device the clusters of a ClusterFile that the views see, within a memory budget
+   *
+   * The vertex and index buffers are split in slots, each the size of the largest cluster. Each frame the clusters in
+   * a frustum are taken nearest first : the missing ones are copied through the ring, within a budget of bytes per
+   * frame, to a free slot or else to the one drawn the longest ago. A slot a frame in flight may still draw is never
+   * reused. The indices are 32 bits, with the first vertex of their slot added, so every cluster is drawn from the
+   * same buffers.
+   */
+  class ClusterStreamer : public NoCopy {
+  public:
+    static constexpr VkDeviceSize DefaultMemoryBudget = VkDeviceSize(512) << 20;
+    static constexpr VkDeviceSize DefaultFrameBudget  = 16 << 20;
+
+    struct Stats {
+      size_t visible;        // clusters in a frustum, last frame
+      size_t drawn;          // of those, resident
+      size_t slots;          // clusters the budget holds
+      size_t streamedBytes;  // copied to the device since the start
+      size_t evictions;      // clusters whose slot went to another one
+    };
+
+    /**
+     * @param memoryBudget Bytes of the vertex and index buffers
+     * @param frameBudget Bytes copied per frame at most, but at least one cluster per frame
+     */
+    ClusterStreamer(const Device& device,
+                    const ClusterFile& file,
+                    VertexFormat format,
+                    const Quantization& quantization,
+                    VkDeviceSize memoryBudget = DefaultMemoryBudget,
+                    VkDeviceSize frameBudget  = DefaultFrameBudget);
+
+    /**
+     * @brief Copy the missing clusters seen from the frusta through the ring and flush it, then list the resident
+     * ones in the first and only level of chain, one range per cluster, nearest first
+     *
+     * @param framesInFlight Frames the device may still be drawing, their slots are kept
+     */
+    void update(StagingRing& staging,
+                const std::vector<mesh::Frustum>& frusta,
+                const glm::vec3& viewer,
+                uint32_t framesInFlight,
+                mesh::LodChain& chain);
+
+    inline const VertexBuffer& vertexBuffer() const { return *m_vertexBuffer; }
+    inline const IndexBuffer& indexBuffer() const { return *m_indexBuffer; }
+
+    Stats stats() const;
+
+  private:
+    struct Slot {
+      int64_t cluster;    // -1 when free
+      uint64_t lastUsed;  // frame which last drew it
+    };
+
+    const ClusterFile& m_file;
+    VertexFormat m_format;
+    Quantization m_quantization;
+    VkDeviceSize m_frameBudget;
+
+    uint32_t m_slotVertices;
+    uint32_t m_slotIndices;
+    std::vector<Slot> m_slots;
+    std::vector<int32_t> m_residence;  // slot of each cluster, -1 when not resident
+
+    std::unique_ptr<VertexBuffer> m_vertexBuffer;
+    std::unique_ptr<IndexBuffer> m_indexBuffer;
+
+    uint64_t m_frame       = 0;
+    size_t m_visible       = 0;
+    size_t m_drawn         = 0;
+    size_t m_streamedBytes = 0;
+    size_t m_evictions     = 0;
+
+    /**
+     * @brief A free slot, or the one drawn the longest ago that no frame in flight draws; -1 if there is none
+     */
+    int32_t acquireSlot(uint32_t framesInFlight);
+
+    /**
+     * @brief Copy a cluster to a slot, and return the bytes copied
+     */
+    VkDeviceSize load(StagingRing& staging, uint32_t cluster, int32_t slot);
+  };
+
+}  // namespace vkl
+
+#endif  // CLUSTERSTREAMER_HPP
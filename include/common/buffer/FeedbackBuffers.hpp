@@ -0,0 +1,112 @@
+/**
+ * @file FeedbackBuffers.hpp
+ * @brief Define FeedbackBuffers class
+ */
+
+#ifndef FEEDBACKBUFFERS_HPP
+#define FEEDBACKBUFFERS_HPP
+
+#include <common/VulkanHeader.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <common/Device.hpp>
+#include <common/SwapChain.hpp>
+#include <common/buffer/IBuffer.hpp>
+#include <common/buffer/StorageBuffer.hpp>
+#include <common/struct/TextureFeedback.hpp>
+
+namespace vkl {
+
+  /**
+   * @brief A TextureFeedback per texture of the model and per image of the swap chain, which the fragment shader writes
+   * and the host reads back
+   *
+   * Host visible and mapped for their whole life : those of an image are read, then reset, once the frame which last
+   * rendered to that image is done.
+   */
+  class FeedbackBuffers : public IUniformBuffers {
+  public:
+    FeedbackBuffers(const Device& device, const SwapChain& swapChain, uint32_t textureCount = 1)
+        : m_device(device), m_swapChain(swapChain), m_textureCount(textureCount) {
+      createBuffers();
+    }
+
+    ~FeedbackBuffers() { destroyBuffers(); }
+
+    inline const VkBuffer& buffer(int index) const { return m_buffers[index].buffer->buffer(); }
+    inline const VkDescriptorBufferInfo& descriptor(int index) const { return m_buffers[index].buffer->descriptor(); }
+
+    inline uint32_t textureCount() const { return m_textureCount; }
+
+    /**
+     * @brief What the last frame rendered to the image wrote of each texture, and reset it for the next one
+     */
+    std::vector<TextureFeedback> take(uint32_t index) {
+      TextureFeedback* mapped = m_buffers[index].mapped;
+      std::vector<TextureFeedback> feedback(mapped, mapped + m_textureCount);
+      std::fill(mapped, mapped + m_textureCount, Empty());
+      return feedback;
+    }
+
+    /**
+     * @brief Recreate the buffers for another number of textures, the descriptors which refer to them must be written
+     * again
+     */
+    void resize(uint32_t textureCount) {
+      destroyBuffers();
+      m_textureCount = textureCount;
+      createBuffers();
+    }
+
+    /**
+     * @brief Recreate the buffers when the swap chain is recreated
+     */
+    void recreate() {
+      destroyBuffers();
+      createBuffers();
+    }
+
+  private:
+    struct Slot {
+      std::unique_ptr<StorageBuffer> buffer;
+      TextureFeedback* mapped;
+    };
+
+    std::vector<Slot> m_buffers;
+
+    const Device& m_device;
+    const SwapChain& m_swapChain;
+    uint32_t m_textureCount;
+
+    static inline TextureFeedback Empty() { return {0, UINT32_MAX}; }
+
+    void createBuffers() {
+      const VkDeviceSize size = sizeof(TextureFeedback) * m_textureCount;
+
+      for (size_t i = 0; i < m_swapChain.numImages(); i++) {
+        Slot slot = {
+            .buffer = std::make_unique<StorageBuffer>(
+                m_device, size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+            .mapped = nullptr,
+        };
+
+        slot.mapped = static_cast<TextureFeedback*>(slot.buffer->mapped());
+        std::fill(slot.mapped, slot.mapped + m_textureCount, Empty());
+
+        m_buffers.push_back(std::move(slot));
+      }
+    }
+
+    void destroyBuffers() {
+      m_buffers.clear();
+    }
+  };
+
+}  // namespace vkl
+
+#endif  // FEEDBACKBUFFERS_HPP
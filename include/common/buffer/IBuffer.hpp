@@ -2,6 +2,7 @@
 #define IBUFFER_HPP
 
 #include <common/VulkanHeader.hpp>
+#include <cstdint>
 
 #include <common/NoCopy.hpp>
 
@@ -23,6 +24,12 @@ namespace vkl {
 
     virtual const VkBuffer& buffer(int index) const                   = 0;
     virtual const VkDescriptorBufferInfo& descriptor(int index) const = 0;
+
+    /**
+     * @brief Whether the descriptor is a dynamic uniform buffer, bound with the offset of the image
+     */
+    virtual bool dynamic() const { return false; }
+    virtual uint32_t dynamicOffset(int index) const { return 0; }
   };
 
 }  // namespace vkl
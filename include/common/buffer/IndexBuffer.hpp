@@ -0,0 +1,88 @@
+/**
+ * @file IndexBuffer.hpp
+ * @brief Define IndexBuffer class
+ */
+
+#ifndef INDEXBUFFER_HPP
+#define INDEXBUFFER_HPP
+
+#include <common/VulkanHeader.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <common/Device.hpp>
+#include <common/buffer/StagingRing.hpp>
+#include <common/buffer/StorageBuffer.hpp>
+
+namespace vkl {
+
+  /**
+   * @brief A buffer of triangle indices, stored on 16 bits when the vertex count allows it
+   */
+  class IndexBuffer : public StorageBuffer {
+  public:
+    IndexBuffer(const Device& device, const std::vector<uint32_t>& indices, StagingRing& staging)
+        : StorageBuffer(device,
+                        IndexSize(IndexType(indices)) * indices.size(),
+                        VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                        MemoryCategory::Vertex),
+          m_count(static_cast<uint32_t>(indices.size())),
+          m_indexType(IndexType(indices)) {
+      if (m_indexType == VK_INDEX_TYPE_UINT16) {
+        const std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+        staging.copy(shortIndices.data(), m_bufferSize, m_buffer);
+      } else {
+        staging.copy(indices.data(), m_bufferSize, m_buffer);
+      }
+    }
+
+    /**
+     * @brief Room for count 32-bit indices, copied later by copy()
+     */
+    IndexBuffer(const Device& device, uint32_t count)
+        : StorageBuffer(device,
+                        sizeof(uint32_t) * VkDeviceSize(count),
+                        VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                        MemoryCategory::Vertex),
+          m_count(count),
+          m_indexType(VK_INDEX_TYPE_UINT32) {}
+
+    /**
+     * @brief Copy indices over those from firstIndex on, they must fit the index type
+     */
+    void copy(const std::vector<uint32_t>& indices, uint32_t firstIndex, StagingRing& staging) {
+      const VkDeviceSize offset = IndexSize(m_indexType) * firstIndex;
+      if (m_indexType == VK_INDEX_TYPE_UINT16) {
+        const std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+        staging.copy(shortIndices.data(), sizeof(uint16_t) * shortIndices.size(), m_buffer, offset);
+      } else {
+        staging.copy(indices.data(), sizeof(uint32_t) * indices.size(), m_buffer, offset);
+      }
+    }
+
+    inline uint32_t count() const { return m_count; }
+    inline VkIndexType indexType() const { return m_indexType; }
+
+    /**
+     * @brief 16-bit indices halve the index fetch, 0xFFFF is kept out as it is the primitive restart value
+     */
+    static VkIndexType IndexType(const std::vector<uint32_t>& indices) {
+      const uint32_t maxIndex = indices.empty() ? 0 : *std::max_element(indices.begin(), indices.end());
+      return (maxIndex < UINT16_MAX) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+    }
+
+    static VkDeviceSize IndexSize(VkIndexType indexType) {
+      return (indexType == VK_INDEX_TYPE_UINT16) ? sizeof(uint16_t) : sizeof(uint32_t);
+    }
+
+  private:
+    uint32_t m_count;
+    VkIndexType m_indexType;
+  };
+
+}  // namespace vkl
+
+#endif  // INDEXBUFFER_HPP
@@ -0,0 +1,61 @@
+/**
+ * @file MeshletBuffer.hpp
+ * @brief Define MeshletBuffer class
+ */
+
+#ifndef MESHLETBUFFER_HPP
+#define MESHLETBUFFER_HPP
+
+#include <common/VulkanHeader.hpp>
+#include <cstdint>
+#include <vector>
+
+#include <common/Device.hpp>
+#include <common/buffer/StagingRing.hpp>
+#include <common/buffer/StorageBuffer.hpp>
+#include <common/mesh/Meshlet.hpp>
+
+namespace vkl {
+
+  /**
+   * @brief The meshlets of a model, for a culling pass : the array of MeshletBounds, then the array of Meshlet
+   *
+   * Both are std430 compatible (16 bytes per element), so the two arrays can be bound as ranges of the same buffer.
+   */
+  class MeshletBuffer : public StorageBuffer {
+  public:
+    MeshletBuffer(const Device& device, const mesh::Meshlets& meshlets, StagingRing& staging)
+        : StorageBuffer(device,
+                        MeshletOffset(meshlets.bounds.size()) + BufferSize(meshlets.meshlets),
+                        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                        MemoryCategory::Vertex),
+          m_count(static_cast<uint32_t>(meshlets.meshlets.size())),
+          m_meshletOffset(MeshletOffset(meshlets.bounds.size())) {
+      staging.copy(meshlets.bounds.data(), BufferSize(meshlets.bounds), m_buffer, boundsOffset());
+      staging.copy(meshlets.meshlets.data(), BufferSize(meshlets.meshlets), m_buffer, m_meshletOffset);
+    }
+
+    inline uint32_t count() const { return m_count; }
+    inline VkDeviceSize boundsOffset() const { return 0; }
+    inline VkDeviceSize meshletOffset() const { return m_meshletOffset; }
+
+  private:
+    uint32_t m_count;
+    VkDeviceSize m_meshletOffset;
+
+    template <typename T>
+    static VkDeviceSize BufferSize(const std::vector<T>& elements) {
+      return sizeof(T) * elements.size();
+    }
+
+    // A zero sized buffer can't be created, keep room for one element
+    static VkDeviceSize MeshletOffset(size_t boundsCount) {
+      const VkDeviceSize size = sizeof(mesh::MeshletBounds) * (boundsCount > 0 ? boundsCount : 1);
+      return (size + 15) & ~VkDeviceSize(15);
+    }
+  };
+
+}  // namespace vkl
+
+#endif  // MESHLETBUFFER_HPP
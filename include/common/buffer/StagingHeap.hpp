@@ -0,0 +1,112 @@
+/**
+ * @file StagingHeap.hpp
+ * @brief Define StagingHeap class
+ */
+
+#ifndef STAGINGHEAP_HPP
+#define STAGINGHEAP_HPP
+
+#include <common/VulkanHeader.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <common/Device.hpp>
+#include <common/NoCopy.hpp>
+#include <common/buffer/StorageBuffer.hpp>
+
+namespace vkl {
+
+  /**
+   * @brief Host visible memory, mapped for its whole life, handed out in pieces which any thread can fill; a
+   * StagingRing then copies the pieces to the device from there, without going through its own chunks
+   *
+   * The memory is taken by blocks as the heap grows, a piece larger than a block gets one of its own. Nothing is
+   * given back before the destruction of the heap, which must wait for the copies of its pieces.
+   */
+  class StagingHeap : public NoCopy {
+  public:
+    static constexpr VkDeviceSize DefaultBlockSize = 16 << 20;
+
+    struct Allocation {
+      VkBuffer buffer     = VK_NULL_HANDLE;
+      VkDeviceSize offset = 0;        // in buffer, 16 bytes aligned
+      uint8_t* data       = nullptr;  // mapped, at offset
+    };
+
+    explicit StagingHeap(const Device& device, VkDeviceSize blockSize = DefaultBlockSize)
+        : m_blockSize(blockSize), m_device(device) {}
+
+    inline const Device& device() const { return m_device; }
+
+    /**
+     * @brief Thread safe
+     */
+    Allocation allocate(VkDeviceSize size) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      // The block being filled stays the same after a piece which needed its own
+      size_t index = m_current;
+      if (m_current == NoBlock || align(m_used) + size > m_blocks[m_current].buffer->size()) {
+        index = m_blocks.size();
+        m_blocks.push_back(createBlock(std::max(size, m_blockSize)));
+        if (size <= m_blockSize) {
+          m_current = index;
+          m_used    = 0;
+        }
+      }
+
+      const VkDeviceSize offset = index == m_current ? align(m_used) : 0;
+      if (index == m_current) m_used = offset + size;
+      m_size += size;
+
+      return {m_blocks[index].buffer->buffer(), offset, m_blocks[index].mapped + offset};
+    }
+
+    /**
+     * @brief Bytes handed out
+     */
+    VkDeviceSize size() const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_size;
+    }
+
+  private:
+    static constexpr size_t NoBlock = std::numeric_limits<size_t>::max();
+
+    struct Block {
+      std::unique_ptr<StorageBuffer> buffer;
+      uint8_t* mapped;
+    };
+
+    VkDeviceSize m_blockSize;
+    std::vector<Block> m_blocks;
+    size_t m_current    = NoBlock;
+    VkDeviceSize m_used = 0;  // in the current block
+    VkDeviceSize m_size = 0;
+    mutable std::mutex m_mutex;
+
+    const Device& m_device;
+
+    static inline VkDeviceSize align(VkDeviceSize offset) { return (offset + 15) & ~VkDeviceSize(15); }
+
+    Block createBlock(VkDeviceSize size) {
+      Block block = {
+          .buffer = std::make_unique<StorageBuffer>(
+              m_device, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Staging),
+          .mapped = nullptr,
+      };
+
+      block.mapped = static_cast<uint8_t*>(block.buffer->mapped());
+
+      return block;
+    }
+  };
+
+}  // namespace vkl
+
+#endif  // STAGINGHEAP_HPP
@@ -0,0 +1,456 @@
+/**
+ * @file StagingRing.hpp
+ * @brief Define StagingRing class
+ */
+
+#ifndef STAGINGRING_HPP
+#define STAGINGRING_HPP
+
+#include <common/VulkanHeader.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <common/CommandPool.hpp>
+#include <common/Device.hpp>
+#include <common/NoCopy.hpp>
+#include <common/buffer/StorageBuffer.hpp>
+
+namespace vkl {
+
+  /**
+   * @brief Upload to device local buffers and images through a fixed host visible buffer, split in chunks
+   *
+   * Each chunk is filled, then its copies are submitted while the next chunk is filled : the host writes of a chunk
+   * overlap the GPU copies of the previous ones, and a chunk is only waited for when the ring wraps around to it.
+   * Small uploads share a chunk. Must be used by the thread which owns the queue.
+   */
+  class StagingRing : public NoCopy {
+  public:
+    static constexpr VkDeviceSize DefaultChunkSize = 8 << 20;
+    static constexpr uint32_t DefaultChunkCount    = 3;
+
+    StagingRing(const Device& device,
+                const VkQueue& queue,
+                VkDeviceSize chunkSize = DefaultChunkSize,
+                uint32_t chunkCount    = DefaultChunkCount)
+        : m_chunkSize(chunkSize),
+          m_chunks(chunkCount),
+          m_buffer(device,
+                   chunkSize * chunkCount,
+                   VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                   MemoryCategory::Staging),
+          m_commandPool(device, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT),
+          m_device(device),
+          m_queue(queue) {
+      // Mapped for the life of the ring
+      m_mapped = static_cast<uint8_t*>(m_buffer.mapped());
+
+      std::vector<VkCommandBuffer> commandBuffers(chunkCount);
+      const VkCommandBufferAllocateInfo allocInfo = {
+          .sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+          .commandPool        = m_commandPool.handle(),
+          .level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+          .commandBufferCount = chunkCount,
+      };
+
+      if (vkAllocateCommandBuffers(m_device.logical(), &allocInfo, commandBuffers.data()) != VK_SUCCESS) {
+        throw std::runtime_error("failed to allocate command buffers!");
+      }
+
+      const VkFenceCreateInfo fenceInfo = {
+          .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+      };
+
+      for (uint32_t i = 0; i < chunkCount; ++i) {
+        m_chunks[i].commandBuffer = commandBuffers[i];
+        if (vkCreateFence(m_device.logical(), &fenceInfo, nullptr, &m_chunks[i].fence) != VK_SUCCESS) {
+          throw std::runtime_error("failed to create fence!");
+        }
+      }
+    }
+
+    ~StagingRing() {
+      flush();
+
+      for (const Chunk& chunk : m_chunks) {
+        vkDestroyFence(m_device.logical(), chunk.fence, nullptr);
+        vkFreeCommandBuffers(m_device.logical(), m_commandPool.handle(), 1, &chunk.commandBuffer);
+      }
+    }
+
+    /**
+     * @brief Copy size bytes of data to dst at dstOffset, dst needs VK_BUFFER_USAGE_TRANSFER_DST_BIT
+     *
+     * Returns as soon as data has been written in the ring, the copy is done after flush().
+     */
+    void copy(const void* data, VkDeviceSize size, VkBuffer dst, VkDeviceSize dstOffset = 0) {
+      const uint8_t* src = static_cast<const uint8_t*>(data);
+
+      while (size > 0) {
+        const VkDeviceSize offset = reserve(1);
+        const VkDeviceSize piece  = std::min(size, m_chunkSize - m_used);
+
+        memcpy(m_mapped + offset, src, (size_t)piece);
+
+        const VkBufferCopy region = {
+            .srcOffset = offset,
+            .dstOffset = dstOffset,
+            .size      = piece,
+        };
+        vkCmdCopyBuffer(current().commandBuffer, m_buffer.buffer(), dst, 1, &region);
+
+        m_used += piece;
+        src += piece;
+        dstOffset += piece;
+        size -= piece;
+      }
+    }
+
+    /**
+     * @brief Copy tightly packed RGBA 8 bits pixels, level after level, to the first levels of a color image, then blit
+     * each next level up to mipLevels from the previous one; every level is left ready to be sampled
+     *
+     * The levels are copied by bands of rows, so they can be larger than a chunk. The blits need an image created with
+     * VK_IMAGE_USAGE_TRANSFER_SRC_BIT, in a format which supports linear blits. Block compressed levels are copied by
+     * rows of blocks, of blockSize x blockSize texels and blockBytes each; they can't be blitted, all their levels
+     * must be given.
+     */
+    void copy(const void* pixels, VkImage dst, uint32_t width, uint32_t height, uint32_t levels = 1,
+              uint32_t mipLevels = 1, uint32_t blockSize = 1, uint32_t blockBytes = 4) {
+      if (RowSize(width, blockSize, blockBytes) > m_chunkSize) {
+        throw std::runtime_error("image row larger than a staging chunk!");
+      }
+      mipLevels = std::max(mipLevels, levels);
+
+      // Recorded before the first band, in the same or an earlier submission
+      reserve(RowSize(width, blockSize, blockBytes));
+      transition(dst, 0, mipLevels, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+      const uint8_t* src = static_cast<const uint8_t*>(pixels);
+      for (uint32_t level = 0; level < levels; level++) {
+        const uint32_t levelWidth = std::max(1u, width >> level), levelHeight = std::max(1u, height >> level);
+        const uint32_t levelRows   = (levelHeight + blockSize - 1) / blockSize;
+        const VkDeviceSize size    = RowSize(levelWidth, blockSize, blockBytes);
+
+        for (uint32_t row = 0; row < levelRows;) {
+          const VkDeviceSize offset = reserve(size);
+          const uint32_t rows = std::min(levelRows - row, static_cast<uint32_t>((m_chunkSize - m_used) / size));
+          const uint32_t top  = row * blockSize;
+
+          memcpy(m_mapped + offset, src, (size_t)(rows * size));
+
+          // The last band stops at the edge of the level, which a block may overhang
+          const VkBufferImageCopy region = {
+              .bufferOffset      = offset,
+              .bufferRowLength   = 0,
+              .bufferImageHeight = 0,
+              .imageSubresource  = {
+                  .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                  .mipLevel       = level,
+                  .baseArrayLayer = 0,
+                  .layerCount     = 1,
+              },
+              .imageOffset       = {0, static_cast<int32_t>(top), 0},
+              .imageExtent       = {levelWidth, std::min(rows * blockSize, levelHeight - top), 1},
+          };
+          vkCmdCopyBufferToImage(current().commandBuffer, m_buffer.buffer(), dst, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                 1, &region);
+
+          m_used += rows * size;
+          src += rows * size;
+          row += rows;
+        }
+      }
+
+      generateMips(dst, width, height, levels, mipLevels);
+    }
+
+    /**
+     * @brief Copy the levels from a host visible buffer the caller filled, such as a StagingHeap, instead of the ring,
+     * then blit the next ones as above; src must stay alive until flush()
+     */
+    void copy(VkBuffer src, VkDeviceSize srcOffset, VkImage dst, uint32_t width, uint32_t height, uint32_t levels = 1,
+              uint32_t mipLevels = 1, uint32_t blockSize = 1, uint32_t blockBytes = 4) {
+      mipLevels = std::max(mipLevels, levels);
+
+      reserve(0);
+      transition(dst, 0, mipLevels, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+      std::vector<VkBufferImageCopy> regions(levels);
+      for (uint32_t level = 0; level < levels; level++) {
+        const uint32_t levelWidth = std::max(1u, width >> level), levelHeight = std::max(1u, height >> level);
+
+        regions[level] = {
+            .bufferOffset      = srcOffset,
+            .bufferRowLength   = 0,
+            .bufferImageHeight = 0,
+            .imageSubresource  = {
+                .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                .mipLevel       = level,
+                .baseArrayLayer = 0,
+                .layerCount     = 1,
+            },
+            .imageOffset       = {0, 0, 0},
+            .imageExtent       = {levelWidth, levelHeight, 1},
+        };
+        srcOffset += RowSize(levelWidth, blockSize, blockBytes) * ((levelHeight + blockSize - 1) / blockSize);
+      }
+      vkCmdCopyBufferToImage(current().commandBuffer, src, dst, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, levels,
+                             regions.data());
+
+      generateMips(dst, width, height, levels, mipLevels);
+    }
+
+    /**
+     * @brief Copy levels ready to be sampled from an image to another of the same format, such as a texture which
+     * grows or shrinks its mip chain; width and height are those of the first level copied
+     *
+     * Both images are left ready to be sampled, src must stay alive until flush().
+     */
+    void copyImage(VkImage src, uint32_t srcLevel, VkImage dst, uint32_t dstLevel, uint32_t levels, uint32_t width,
+                   uint32_t height) {
+      reserve(0);
+      transition(src, srcLevel, levels, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+      transition(dst, dstLevel, levels, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+      std::vector<VkImageCopy> regions(levels);
+      for (uint32_t level = 0; level < levels; level++) {
+        regions[level] = {
+            .srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, srcLevel + level, 0, 1},
+            .srcOffset      = {0, 0, 0},
+            .dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, dstLevel + level, 0, 1},
+            .dstOffset      = {0, 0, 0},
+            .extent         = {std::max(1u, width >> level), std::max(1u, height >> level), 1},
+        };
+      }
+      vkCmdCopyImage(current().commandBuffer, src, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dst,
+                     VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, levels, regions.data());
+
+      transition(src, srcLevel, levels, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+      transition(dst, dstLevel, levels, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    }
+
+    /**
+     * @brief Submit the chunk being filled, and wait until every copy is done
+     */
+    void flush() {
+      if (m_recording) submit();
+
+      for (Chunk& chunk : m_chunks) wait(chunk);
+    }
+
+    /**
+     * @brief Submit the chunk being filled without waiting, the serial of the last submission: its copies and those
+     * before it are done once done() is true for it
+     */
+    uint64_t submitPending() {
+      if (m_recording) submit();
+
+      return m_submitted;
+    }
+
+    /**
+     * @brief Whether every copy submitted up to serial is done, polls the fences and never blocks
+     */
+    bool done(uint64_t serial) {
+      for (Chunk& chunk : m_chunks) {
+        if (!chunk.pending || chunk.serial > serial) continue;
+        if (vkGetFenceStatus(m_device.logical(), chunk.fence) != VK_SUCCESS) return false;
+
+        vkResetFences(m_device.logical(), 1, &chunk.fence);
+        chunk.pending = false;
+      }
+
+      return true;
+    }
+
+  private:
+    struct Chunk {
+      VkCommandBuffer commandBuffer;
+      VkFence fence;
+      bool pending    = false;
+      uint64_t serial = 0;  // of its last submission, a chunk is reused only once it is done
+    };
+
+    VkDeviceSize m_chunkSize;
+    std::vector<Chunk> m_chunks;
+    uint32_t m_current   = 0;
+    VkDeviceSize m_used  = 0;  // in the current chunk
+    bool m_recording     = false;
+    uint64_t m_submitted = 0;  // serial of the last submission
+
+    StorageBuffer m_buffer;
+    uint8_t* m_mapped;
+    CommandPool m_commandPool;
+
+    const Device& m_device;
+    const VkQueue& m_queue;
+
+    inline Chunk& current() { return m_chunks[m_current]; }
+
+    static inline VkDeviceSize RowSize(uint32_t width, uint32_t blockSize, uint32_t blockBytes) {
+      return VkDeviceSize((width + blockSize - 1) / blockSize) * blockBytes;
+    }
+
+    static VkOffset3D extent(uint32_t width, uint32_t height, uint32_t level) {
+      return {static_cast<int32_t>(std::max(1u, width >> level)), static_cast<int32_t>(std::max(1u, height >> level)),
+              1};
+    }
+
+    /**
+     * @brief Blit each level of [levels, mipLevels) from the previous one, then leave every level ready to be sampled
+     */
+    void generateMips(VkImage dst, uint32_t width, uint32_t height, uint32_t levels, uint32_t mipLevels) {
+      for (uint32_t level = levels; level < mipLevels; level++) {
+        reserve(0);
+        transition(dst, level - 1, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+
+        const VkImageBlit blit = {
+            .srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 0, 1},
+            .srcOffsets     = {{0, 0, 0}, extent(width, height, level - 1)},
+            .dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1},
+            .dstOffsets     = {{0, 0, 0}, extent(width, height, level)},
+        };
+        vkCmdBlitImage(current().commandBuffer, dst, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dst,
+                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+
+        transition(dst, level - 1, 1, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+      }
+
+      // What no blit has read yet : the copied levels, or only the first ones and the last blitted one
+      reserve(0);
+      if (levels == mipLevels) {
+        transition(dst, 0, levels, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+      } else {
+        if (levels > 1) {
+          transition(dst, 0, levels - 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                     VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        }
+        transition(dst, mipLevels - 1, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                   VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+      }
+    }
+
+    /**
+     * @brief Barrier on the levels [baseLevel, baseLevel + levelCount) of a color image, recorded in the current chunk
+     *
+     * The accesses and stages follow the layouts : transfer for the transfer layouts, fragment shader reads for the
+     * shader read layout.
+     */
+    void transition(VkImage image, uint32_t baseLevel, uint32_t levelCount, VkImageLayout oldLayout,
+                    VkImageLayout newLayout) {
+      const auto access = [](VkImageLayout layout) -> VkAccessFlags {
+        switch (layout) {
+          case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL: return VK_ACCESS_TRANSFER_WRITE_BIT;
+          case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL: return VK_ACCESS_TRANSFER_READ_BIT;
+          case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL: return VK_ACCESS_SHADER_READ_BIT;
+          default: return 0;
+        }
+      };
+      const auto stage = [](VkImageLayout layout) -> VkPipelineStageFlags {
+        switch (layout) {
+          case VK_IMAGE_LAYOUT_UNDEFINED: return VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+          case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL: return VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+          default: return VK_PIPELINE_STAGE_TRANSFER_BIT;
+        }
+      };
+
+      const VkImageMemoryBarrier barrier = {
+          .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+          .srcAccessMask       = access(oldLayout),
+          .dstAccessMask       = access(newLayout),
+          .oldLayout           = oldLayout,
+          .newLayout           = newLayout,
+          .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+          .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+          .image               = image,
+          .subresourceRange    = {
+              .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+              .baseMipLevel   = baseLevel,
+              .levelCount     = levelCount,
+              .baseArrayLayer = 0,
+              .layerCount     = 1,
+          },
+      };
+
+      vkCmdPipelineBarrier(current().commandBuffer, stage(oldLayout), stage(newLayout), 0, 0, nullptr, 0, nullptr, 1,
+                           &barrier);
+    }
+
+    /**
+     * @brief Offset in m_buffer of at least minSize bytes in the current chunk, moving to the next chunk if needed
+     *
+     * 16 bytes aligned, which covers the texel size and the optimal copy offset of most devices.
+     */
+    VkDeviceSize reserve(VkDeviceSize minSize) {
+      if (m_recording && ((m_used + 15) & ~VkDeviceSize(15)) + minSize > m_chunkSize) submit();
+
+      if (!m_recording) {
+        wait(current());
+
+        const VkCommandBufferBeginInfo beginInfo = {
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+        };
+
+        if (vkBeginCommandBuffer(current().commandBuffer, &beginInfo) != VK_SUCCESS) {
+          throw std::runtime_error("Could not create one-time command buffer!");
+        }
+        m_recording = true;
+        m_used      = 0;
+      }
+
+      m_used = (m_used + 15) & ~VkDeviceSize(15);
+      return VkDeviceSize(m_current) * m_chunkSize + m_used;
+    }
+
+    void submit() {
+      // The copied buffers are read by the next submissions of the queue
+      const VkMemoryBarrier barrier = {
+          .sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+          .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+          .dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT
+                           | VK_ACCESS_SHADER_READ_BIT,
+      };
+
+      vkCmdPipelineBarrier(current().commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                           VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT
+                               | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                           0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+      if (vkEndCommandBuffer(current().commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to record command buffer!");
+      }
+
+      const VkSubmitInfo submitInfo = {
+          .sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+          .commandBufferCount = 1,
+          .pCommandBuffers    = &current().commandBuffer,
+      };
+
+      if (vkQueueSubmit(m_queue, 1, &submitInfo, current().fence) != VK_SUCCESS) {
+        throw std::runtime_error("failed to submit upload command buffer!");
+      }
+
+      current().pending = true;
+      current().serial  = ++m_submitted;
+      m_recording       = false;
+      m_current         = (m_current + 1) % m_chunks.size();
+    }
+
+    void wait(Chunk& chunk) {
+      if (!chunk.pending) return;
+
+      vkWaitForFences(m_device.logical(), 1, &chunk.fence, VK_TRUE, UINT64_MAX);
+      vkResetFences(m_device.logical(), 1, &chunk.fence);
+      chunk.pending = false;
+    }
+  };
+
+}  // namespace vkl
+
+#endif  // STAGINGRING_HPP
@@ -7,7 +7,7 @@
 #include <common/Device.hpp>
 #include <common/NoCopy.hpp>
 #include <common/buffer/IBuffer.hpp>
-#include <common/misc/Device.hpp>
+#include <common/memory/MemoryAllocator.hpp>
 
 #include <cstring>
 #include <iostream>
@@ -16,30 +16,52 @@ namespace vkl {
 
   class StorageBuffer : public IBuffer {
   public:
-    StorageBuffer(const Device& device, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties)
+    StorageBuffer(const Device& device,
+                  VkDeviceSize size,
+                  VkBufferUsageFlags usage,
+                  VkMemoryPropertyFlags properties,
+                  MemoryCategory category = MemoryCategory::Other)
         : m_bufferSize(size), m_device(device) {
       // Voir commentaires dans la fonction createBuffer
-      createBuffer(m_bufferSize, usage, properties);
+      createBuffer(m_bufferSize, usage, properties, category);
     }
 
     ~StorageBuffer() {
       // ne dépend pas de la swap chain
       vkDestroyBuffer(m_device.logical(), m_buffer, nullptr);
-      vkFreeMemory(m_device.logical(), m_bufferMemory, nullptr);
+      m_device.allocator().free(m_memory);
     }
 
     inline const VkBuffer& buffer() const { return m_buffer; }
-    inline const VkDeviceMemory& memory() const { return m_bufferMemory; }
+    inline const VkDeviceMemory& memory() const { return m_memory.memory; }
     inline const VkDeviceSize& size() const { return m_bufferSize; }
     inline const VkDescriptorBufferInfo& descriptor() const { return m_descriptor; }
 
+    /**
+     * @brief The buffer in host memory for its whole life, null if it isn't host visible
+     *
+     * Its memory object is shared with other buffers (see MemoryAllocator), which keeps it mapped.
+     */
+    inline void* mapped() const { return m_memory.mapped; }
+
+    /**
+     * @brief Make the writes through mapped() visible to the device, nothing if the memory is HOST_COHERENT
+     */
+    void flush(VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE) const {
+      m_device.allocator().flush(m_memory, offset, size);
+    }
+
     /**
      * @brief Wrapper for create a new buffer
      * @param size Is the size of the buffer you want
      * @param usage Is a flag to describe for what usage the buffer is destinate
      * @param properties Is for find the memory type
+     * @param category Is what the memory is counted as, see MemoryAllocator::stats
      */
-    void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties) {
+    void createBuffer(VkDeviceSize size,
+                      VkBufferUsageFlags usage,
+                      VkMemoryPropertyFlags properties,
+                      MemoryCategory category = MemoryCategory::Other) {
       // Step 1 - Création du m_buffer
       const VkBufferCreateInfo bufferInfo = {
           .sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
@@ -53,27 +75,8 @@ namespace vkl {
       }
 
       // Step 2 - Allocation de la mémoire
-      // On récupére les fonctionnalités dont le m_buffer a besoin
-      VkMemoryRequirements memRequirements;
-      vkGetBufferMemoryRequirements(m_device.logical(), m_buffer, &memRequirements);
-
-      // On rempli la structure VkMemoryAllocateInfo
-      const VkMemoryAllocateInfo allocInfo = {
-          .sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-          .allocationSize  = memRequirements.size,
-          .memoryTypeIndex = misc::findMemoryType(m_device.physical(), memRequirements.memoryTypeBits, properties),
-      };
-
-      // Si l'allocation a réussi, nous pouvons associer cette mémoire au m_buffer
-      if (vkAllocateMemory(m_device.logical(), &allocInfo, nullptr, &m_bufferMemory) != VK_SUCCESS) {
-        throw std::runtime_error("echec de l'allocation de memoire!");
-      }
-
-      // Le quatrième paramètre indique le décalage entre le début de la mémoire et le début du m_buffer
-      vkBindBufferMemory(m_device.logical(), m_buffer, m_bufferMemory, 0);
-
-      // Note : Pour allouer un grand espace mémoire, il faut que ce nombre soit divisible par
-      // memRequirements.alignement
+      // Une plage d'un bloc partagé avec d'autres buffers, déjà associée au m_buffer
+      m_memory = m_device.allocator().allocateBuffer(m_buffer, properties, category);
 
       setupDescriptor();
     }
@@ -88,7 +91,7 @@ namespace vkl {
 
   protected:
     VkBuffer m_buffer;
-    VkDeviceMemory m_bufferMemory;
+    MemoryAllocator::Allocation m_memory;
     VkDeviceSize m_bufferSize;
 
     VkDescriptorBufferInfo m_descriptor;
@@ -2,14 +2,13 @@
 #define UNIFORMBUFFER_HPP
 
 #include <common/VulkanHeader.hpp>
-#include <deque>
 #include <stdexcept>
 
 #include <common/Device.hpp>
 #include <common/NoCopy.hpp>
 #include <common/SwapChain.hpp>
-#include <common/buffer/Buffer.hpp>
 #include <common/buffer/IBuffer.hpp>
+#include <common/buffer/UniformRing.hpp>
 #include <common/struct/Depth.hpp>
 #include <common/struct/MVP.hpp>
 
@@ -23,62 +22,64 @@
 namespace vkl {
 
   /**
-   * @brief A templating class to define a list of buffer
+   * @brief A templating class to define the uniform buffer of a struct, a slice of each frame of a UniformRing
    *
    * Note Exposé : Comme des frames peuvent être "in flight" pendant que nous essayons de modifier
-   * le contenu du buffer, nous allons avoir besoin de plusieurs buffers. Nous pouvons soit en avoir
-   * un par frame, soit un par image de la swap chain.
+   * le contenu du buffer, nous allons avoir besoin de plusieurs buffers. Ici chaque image de la swap chain a sa région
+   * du UniformRing, et le descripteur est lié avec l'offset dynamique de la région.
    */
   template <typename T> class UniformBuffers : public IUniformBuffers {
   public:
-    using UBOCallBack = std::function<void(const Device&, const SwapChain&, std::deque<Buffer<T>>&, float, uint32_t)>;
+    using UBOCallBack = std::function<void(const Device&, const SwapChain&, T&, float, uint32_t)>;
 
-    UniformBuffers(const Device& device, const SwapChain& swapChain, UBOCallBack update)
-        : m_update(update), m_device(device), m_swapChain(swapChain) {
-      createUniformBuffers();
+    UniformBuffers(UniformRing& ring, UBOCallBack update)
+        : m_slice(ring.allocate(sizeof(T))), m_update(update), m_ring(ring) {
+      setupDescriptor();
     }
 
-    ~UniformBuffers() {}
+    inline T& data() { return m_data; }
+    inline const T& data() const { return m_data; }
 
-    inline std::vector<T>& data(int i) { return m_uniformBuffers.at(i).data(); }
-    inline const std::vector<T>& data(int i) const { return m_uniformBuffers.at(i).data(); }
+    inline const VkBuffer& buffer(int index) const { return m_ring.buffer(); }
+    inline const VkDescriptorBufferInfo& descriptor(int index) const { return m_descriptor; }
 
-    inline const VkBuffer& buffer(int index) const { return m_uniformBuffers[index].buffer(); }
-    inline const VkDescriptorBufferInfo& descriptor(int index) const { return m_uniformBuffers[index].descriptor(); }
+    inline bool dynamic() const { return true; }
+    inline uint32_t dynamicOffset(int index) const { return m_ring.offset(index, m_slice); }
 
     /**
      * @brief Génére une rotation à chaque frame pour que la géométrie tourne sur elle-même
      * @param currentImage C'est la frame courante
      */
     inline void update(float time, uint32_t currentImage) {
-      m_update(m_device, m_swapChain, m_uniformBuffers, time, currentImage);
+      m_update(m_ring.device(), m_ring.swapChain(), m_data, time, currentImage);
+
+      memcpy(m_ring.mapped(currentImage, m_slice), &m_data, sizeof(T));
+      m_ring.flush(currentImage, m_slice, sizeof(T));
     }
 
     /**
-     * @brief Recreate all uniform buffers when swapchain is recreate
+     * @brief After the ring is recreated with the swapchain, its buffer may be another one
      */
-    void recreate() {
-      m_uniformBuffers.clear();  // -> call destructor of all Buffer
-      createUniformBuffers();
-    }
+    void recreate() { setupDescriptor(); }
 
   protected:
-    std::deque<Buffer<T>> m_uniformBuffers;
+    const VkDeviceSize m_slice;
+    T m_data = {};
     UBOCallBack m_update;
 
-    const Device& m_device;
-    const SwapChain& m_swapChain;
+    VkDescriptorBufferInfo m_descriptor;
+
+    const UniformRing& m_ring;
 
     /**
-     * @brief Create uniform buffers according to the swapchain's image count
+     * @brief The whole ring, a struct from the dynamic offset
      */
-    void createUniformBuffers() {
-      m_uniformBuffers.clear();
-
-      for (size_t i = 0; i < m_swapChain.numImages(); i++) {
-        m_uniformBuffers.emplace_back(m_device, std::vector<T>(1), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-      }
+    void setupDescriptor() {
+      m_descriptor = {
+          .buffer = m_ring.buffer(),
+          .offset = 0,
+          .range  = sizeof(T),
+      };
     }
   };
 }  // namespace vkl
@@ -0,0 +1,105 @@
+/**
+ * @file UniformRing.hpp
+ * @brief Define UniformRing class
+ */
+
+#ifndef UNIFORMRING_HPP
+#define UNIFORMRING_HPP
+
+#include <common/VulkanHeader.hpp>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#include <common/Device.hpp>
+#include <common/NoCopy.hpp>
+#include <common/SwapChain.hpp>
+#include <common/buffer/StorageBuffer.hpp>
+
+namespace vkl {
+
+  /**
+   * @brief The per-frame constants of an application in a single buffer, mapped for its whole life and bound with
+   * dynamic offsets
+   *
+   * The buffer has a region of frameSize bytes per image of the swap chain, allocated linearly in slices aligned to
+   * minUniformBufferOffsetAlignment. A slice is reserved once and lies at the same place in every region, because the
+   * command buffers recorded for an image bind its offsets: the frame writes its constants to its region, and a
+   * descriptor set refers to the whole buffer for all the images.
+   */
+  class UniformRing : public NoCopy {
+  public:
+    static constexpr VkDeviceSize DefaultFrameSize = 16 << 10;
+
+    UniformRing(const Device& device, const SwapChain& swapChain, VkDeviceSize frameSize = DefaultFrameSize)
+        : m_alignment(device.limits().minUniformBufferOffsetAlignment),
+          m_frameSize(alignUp(frameSize)),
+          m_device(device),
+          m_swapChain(swapChain) {
+      createBuffer();
+    }
+
+    inline const Device& device() const { return m_device; }
+    inline const SwapChain& swapChain() const { return m_swapChain; }
+
+    inline const VkBuffer& buffer() const { return m_buffer->buffer(); }
+    inline VkDeviceSize used() const { return m_used; }
+
+    /**
+     * @brief Reserve size bytes in the region of every frame, the offset of the slice in a region
+     * @throw Throws an exception if the regions are full
+     */
+    VkDeviceSize allocate(VkDeviceSize size) {
+      const VkDeviceSize slice = m_used;
+      if (slice + size > m_frameSize) throw std::runtime_error("failed to allocate from the uniform ring!");
+
+      m_used = alignUp(slice + size);
+      return slice;
+    }
+
+    /**
+     * @brief The dynamic offset of a slice for the image
+     */
+    inline uint32_t offset(uint32_t frame, VkDeviceSize slice) const {
+      return static_cast<uint32_t>(frame * m_frameSize + slice);
+    }
+
+    inline void* mapped(uint32_t frame, VkDeviceSize slice) const {
+      return static_cast<uint8_t*>(m_buffer->mapped()) + offset(frame, slice);
+    }
+
+    inline void flush(uint32_t frame, VkDeviceSize slice, VkDeviceSize size) const {
+      m_buffer->flush(offset(frame, slice), size);
+    }
+
+    /**
+     * @brief A new buffer if the swap chain has another number of images, the slices stay where they are
+     */
+    void recreate() {
+      if (m_buffer->size() != m_frameSize * m_swapChain.numImages()) createBuffer();
+    }
+
+  private:
+    const VkDeviceSize m_alignment;
+    const VkDeviceSize m_frameSize;
+    VkDeviceSize m_used = 0;
+
+    std::unique_ptr<StorageBuffer> m_buffer;
+
+    const Device& m_device;
+    const SwapChain& m_swapChain;
+
+    inline VkDeviceSize alignUp(VkDeviceSize size) const {
+      return (size + m_alignment - 1) / m_alignment * m_alignment;
+    }
+
+    void createBuffer() {
+      m_buffer = std::make_unique<StorageBuffer>(
+          m_device, m_frameSize * m_swapChain.numImages(), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Uniform);
+    }
+  };
+
+}  // namespace vkl
+
+#endif  // UNIFORMRING_HPP
@@ -0,0 +1,104 @@
+/**
+ * @file VertexBuffer.hpp
+ * @brief Define VertexBuffer class
+ */
+
+#ifndef VERTEXBUFFER_HPP
+#define VERTEXBUFFER_HPP
+
+#include <common/VulkanHeader.hpp>
+#include <vector>
+
+#include <common/Device.hpp>
+#include <common/buffer/StagingRing.hpp>
+#include <common/buffer/StorageBuffer.hpp>
+#include <common/struct/CompactVertex.hpp>
+#include <common/struct/Vertex.hpp>
+
+namespace vkl {
+
+  /**
+   * @brief The vertices of a model, in one of the VertexFormat layouts, with the dequantization of its positions
+   *
+   * The buffer holds two streams : the positions alone, read by the depth pass, then the other attributes, read with
+   * the positions by the main pass. It lives in device local memory, filled through a StagingRing.
+   */
+  class VertexBuffer : public StorageBuffer {
+  public:
+    VertexBuffer(const Device& device,
+                 const std::vector<uint8_t>& positions,
+                 const std::vector<uint8_t>& attributes,
+                 VertexFormat format,
+                 const Quantization& quantization,
+                 StagingRing& staging)
+        : StorageBuffer(device,
+                        AttributeOffset(positions.size()) + attributes.size(),
+                        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                        MemoryCategory::Vertex),
+          m_count(static_cast<uint32_t>(positions.size() / PositionSize(format))),
+          m_attributeOffset(AttributeOffset(positions.size())),
+          m_format(format),
+          m_quantization(quantization) {
+      staging.copy(positions.data(), positions.size(), m_buffer, 0);
+      staging.copy(attributes.data(), attributes.size(), m_buffer, m_attributeOffset);
+    }
+
+    /**
+     * @brief Room for vertexCount vertices, copied later by copy()
+     */
+    VertexBuffer(const Device& device, VkDeviceSize vertexCount, VertexFormat format, const Quantization& quantization)
+        : StorageBuffer(device,
+                        AttributeOffset(vertexCount * PositionSize(format)) + vertexCount * AttributeSize(format),
+                        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                        MemoryCategory::Vertex),
+          m_count(static_cast<uint32_t>(vertexCount)),
+          m_attributeOffset(AttributeOffset(vertexCount * PositionSize(format))),
+          m_format(format),
+          m_quantization(quantization) {}
+
+    /**
+     * @brief Copy the streams of some vertices (see mesh::splitStreams) over those from firstVertex on
+     */
+    void copy(const std::vector<uint8_t>& positions,
+              const std::vector<uint8_t>& attributes,
+              VkDeviceSize firstVertex,
+              StagingRing& staging) {
+      staging.copy(positions.data(), positions.size(), m_buffer, firstVertex * PositionSize(m_format));
+      staging.copy(attributes.data(), attributes.size(), m_buffer,
+                   m_attributeOffset + firstVertex * AttributeSize(m_format));
+    }
+
+    /**
+     * @brief The number of vertices, nothing of them is kept on the host
+     */
+    inline uint32_t count() const { return m_count; }
+
+    inline VkDeviceSize positionOffset() const { return 0; }
+    inline VkDeviceSize attributeOffset() const { return m_attributeOffset; }
+
+    inline VertexFormat format() const { return m_format; }
+    inline const Quantization& quantization() const { return m_quantization; }
+
+  private:
+    uint32_t m_count;
+    VkDeviceSize m_attributeOffset;
+    VertexFormat m_format;
+    Quantization m_quantization;
+
+    static VkDeviceSize AttributeOffset(VkDeviceSize positionSize) { return (positionSize + 15) & ~VkDeviceSize(15); }
+
+    static VkDeviceSize PositionSize(VertexFormat format) {
+      return (format == VertexFormat::Compact) ? CompactVertex::PositionSize : Vertex::PositionSize;
+    }
+
+    static VkDeviceSize AttributeSize(VertexFormat format) {
+      return (format == VertexFormat::Compact) ? sizeof(CompactVertex) - CompactVertex::PositionSize
+                                               : sizeof(Vertex) - Vertex::PositionSize;
+    }
+  };
+
+}  // namespace vkl
+
+#endif  // VERTEXBUFFER_HPP
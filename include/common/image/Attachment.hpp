@@ -11,7 +11,7 @@ namespace vkl {
     Attachment(const Device& device, const SwapChain& swapChain, VkFormat format, VkImageUsageFlags usage)
         : Image(device), m_format(format), m_usage(usage) {
       createImage(swapChain.extent().width, swapChain.extent().height);
-      allocateMemory();
+      allocateMemory(MemoryCategory::Attachment);
       createImageView();
       createSampler();
     };
@@ -97,9 +97,7 @@ namespace vkl {
           .borderColor   = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE,
       };
 
-      if (vkCreateSampler(m_device.logical(), &sampler, nullptr, &m_sampler) != VK_SUCCESS) {
-        throw std::runtime_error("Sampler creation failed");
-      }
+      m_sampler = m_device.samplers().acquire(sampler);
     };
   };
 
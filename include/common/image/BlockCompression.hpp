@@ -0,0 +1,95 @@
+/**
+ * @file BlockCompression.hpp
+ * @brief Block compressed images (BC1, BC3, BC7) read from KTX2 or DDS files, and their decompression on the CPU
+ */
+
+#ifndef BLOCKCOMPRESSION_HPP
+#define BLOCKCOMPRESSION_HPP
+
+#include <common/VulkanHeader.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vkl {
+
+  namespace image {
+
+    /**
+     * @brief Levels of 4x4 blocks, as stored on the device
+     */
+    struct CompressedImage {
+      VkFormat format;
+      uint32_t width;
+      uint32_t height;
+      uint32_t levels;
+      std::vector<uint8_t> data;  // the levels one after the other, see blockChainSize
+    };
+
+    /**
+     * @brief Where the levels of a KTX2 or DDS file are, for the callers which copy them to their own memory
+     */
+    struct CompressedLayout {
+      VkFormat format;
+      uint32_t width;
+      uint32_t height;
+      uint32_t levels;
+      std::vector<size_t> offsets;  // in the file, of each level from the level 0
+    };
+
+    /**
+     * @brief Bytes of a 4x4 block of a BC1, BC3 or BC7 format, 0 for any other format
+     */
+    uint32_t blockBytes(VkFormat format);
+
+    inline bool isBlockCompressed(VkFormat format) { return blockBytes(format) > 0; }
+
+    bool isSrgb(VkFormat format);
+
+    /**
+     * @brief Bytes of the levels [0, levels) of a block compressed image, tightly packed one after the other
+     */
+    size_t blockChainSize(VkFormat format, uint32_t width, uint32_t height, uint32_t levels);
+
+    /**
+     * @brief Whether the extension of the file is one of a block compressed container (.ktx2, .dds)
+     */
+    bool isCompressedFile(const std::string& filename);
+
+    /**
+     * @brief Read a KTX2 or DDS file, picked by its magic number
+     *
+     * The legacy DDS formats (DXT1, DXT5) carry no color space, they are read as sRGB when srgb is set.
+     *
+     * @throw Throws an exception if the file is neither, or holds something else than a 2D BC1, BC3 or BC7 image
+     */
+    CompressedImage loadCompressed(const std::string& filename, bool srgb);
+
+    CompressedImage parseKtx2(const uint8_t* data, size_t size);
+    CompressedImage parseDds(const uint8_t* data, size_t size, bool srgb);
+
+    /**
+     * @brief Only the header and the level index of a KTX2 or DDS file held in memory, see loadCompressed
+     */
+    CompressedLayout layoutCompressed(const uint8_t* data, size_t size, bool srgb);
+    CompressedLayout layoutKtx2(const uint8_t* data, size_t size);
+    CompressedLayout layoutDds(const uint8_t* data, size_t size, bool srgb);
+
+    /**
+     * @brief Copy the levels of the file held by data to blocks, tightly packed, see blockChainSize
+     */
+    void copyLevels(const uint8_t* data, const CompressedLayout& layout, uint8_t* blocks);
+
+    /**
+     * @brief Decode the levels of blocks to RGBA 8 bits, laid out as image::mipChainSize, for devices which can't
+     * sample them
+     */
+    std::vector<uint8_t> decompress(VkFormat format, uint32_t width, uint32_t height, uint32_t levels,
+                                    const uint8_t* blocks);
+
+  }  // namespace image
+
+}  // namespace vkl
+
+#endif  // BLOCKCOMPRESSION_HPP
@@ -5,6 +5,8 @@
 #include <common/Device.hpp>
 #include <common/misc/Device.hpp>
 #include <common/NoCopy.hpp>
+#include <common/image/SamplerCache.hpp>
+#include <common/memory/MemoryAllocator.hpp>
 
 namespace vkl {
 
@@ -13,47 +15,30 @@ namespace vkl {
     Image(const Device& device) : m_device(device) {};
 
     ~Image() {
-      vkDestroySampler(m_device.logical(), m_sampler, nullptr);
       vkDestroyImageView(m_device.logical(), m_imageView, nullptr);
 
       vkDestroyImage(m_device.logical(), m_image, nullptr);
-      vkFreeMemory(m_device.logical(), m_bufferMemory, nullptr);
+      m_device.allocator().free(m_memory);
     }
 
     inline const VkImage& image() const { return m_image; }
     inline const VkImageView& view() const { return m_imageView; }
-    inline const VkSampler& sample() const { return m_sampler; }
+    inline const VkSampler& sample() const { return *m_sampler; }
 
   protected:
-    VkImage m_image;
-    VkDeviceMemory m_bufferMemory;
-    VkImageView m_imageView;
-    VkSampler m_sampler;
+    // Null until created, so a constructor which throws halfway only destroys what exists
+    VkImage m_image         = VK_NULL_HANDLE;
+    MemoryAllocator::Allocation m_memory;  // a range of a block shared with other images
+    VkImageView m_imageView = VK_NULL_HANDLE;
+    SamplerCache::Handle m_sampler;  // shared with the images sampled the same way, see Device::samplers
 
     const Device& m_device;
 
     virtual void createImage(uint32_t width, uint32_t height) = 0;
 
-    void allocateMemory() {
-      VkMemoryRequirements memReqs;
-      // Returns the memory requirements for specified Vulkan object
-      vkGetImageMemoryRequirements(m_device.logical(), m_image, &memReqs);
-
-      uint32_t memTypeIndex = misc::findMemoryType(m_device.physical(), memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-      const VkMemoryAllocateInfo memAlloc = {
-          .sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-          .allocationSize  = memReqs.size,
-          .memoryTypeIndex = memTypeIndex,
-      };
-
-      if (vkAllocateMemory(m_device.logical(), &memAlloc, nullptr, &m_bufferMemory) != VK_SUCCESS) {
-        throw std::runtime_error("vkAllocateMemory failed");
-      }
-
-      if (vkBindImageMemory(m_device.logical(), m_image, m_bufferMemory, 0) != VK_SUCCESS) {
-        throw std::runtime_error("vkBindImageMemory failed");
-      }
+    void allocateMemory(MemoryCategory category) {
+      // Bound to a range of a block of device local memory, see MemoryAllocator
+      m_memory = m_device.allocator().allocateImage(m_image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, category);
     }
 
     virtual void createImageView() = 0;
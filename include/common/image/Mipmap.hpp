@@ -0,0 +1,47 @@
+/**
+ * @file Mipmap.hpp
+ * @brief Size of the mip levels of an image, and their generation on the CPU
+ */
+
+#ifndef MIPMAP_HPP
+#define MIPMAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vkl {
+
+  namespace image {
+
+    /**
+     * @brief Levels of a full chain, down to 1x1
+     */
+    uint32_t mipLevels(uint32_t width, uint32_t height);
+
+    inline uint32_t mipSize(uint32_t size, uint32_t level) { return std::max(1u, size >> level); }
+
+    /**
+     * @brief Bytes of the levels [0, levels) of a RGBA 8 bits image, tightly packed one after the other
+     */
+    size_t mipChainSize(uint32_t width, uint32_t height, uint32_t levels);
+
+    /**
+     * @brief Append the levels [1, levels) to the RGBA 8 bits level 0 held by pixels
+     *
+     * Each texel is the mean of the 2x2 texels above it (the last row or column is repeated on odd sizes). With srgb,
+     * the colors are averaged in linear space, the alpha always is.
+     */
+    void buildMipChain(std::vector<uint8_t>& pixels, uint32_t width, uint32_t height, uint32_t levels, bool srgb);
+
+    /**
+     * @brief The same, in place, pixels has room for mipChainSize(width, height, levels) bytes
+     */
+    void buildMipChain(uint8_t* pixels, uint32_t width, uint32_t height, uint32_t levels, bool srgb);
+
+  }  // namespace image
+
+}  // namespace vkl
+
+#endif  // MIPMAP_HPP
@@ -0,0 +1,94 @@
+/**
+ * @file SamplerCache.hpp
+ * @brief Define SamplerCache class
+ */
+
+#ifndef SAMPLERCACHE_HPP
+#define SAMPLERCACHE_HPP
+
+#include <common/NoCopy.hpp>
+#include <common/VulkanHeader.hpp>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace vkl {
+
+  class Device;
+
+  /**
+   * @brief The samplers of a device, shared by every image created with the same parameters
+   *
+   * Drivers cap the number of samplers (maxSamplerAllocationCount, 4000 on many), where the number of images has no
+   * limit. A sampler lives as long as one of the handles acquire() gave out, any thread can acquire or release one.
+   */
+  class SamplerCache : public NoCopy {
+  public:
+    /**
+     * @brief The parameters of a VkSamplerCreateInfo, without any pNext chain
+     */
+    struct Key {
+      VkSamplerCreateFlags flags;
+      VkFilter magFilter;
+      VkFilter minFilter;
+      VkSamplerMipmapMode mipmapMode;
+      VkSamplerAddressMode addressModeU;
+      VkSamplerAddressMode addressModeV;
+      VkSamplerAddressMode addressModeW;
+      float mipLodBias;
+      VkBool32 anisotropyEnable;
+      float maxAnisotropy;
+      VkBool32 compareEnable;
+      VkCompareOp compareOp;
+      float minLod;
+      float maxLod;
+      VkBorderColor borderColor;
+      VkBool32 unnormalizedCoordinates;
+
+      bool operator==(const Key& other) const = default;
+    };
+
+    struct Hash {
+      size_t operator()(const Key& key) const;
+    };
+
+    struct Stats {
+      size_t hits;
+      size_t misses;
+      size_t samplers;  // live
+    };
+
+    using Handle = std::shared_ptr<const VkSampler>;
+
+    explicit SamplerCache(const Device& device) : m_device(device) {}
+
+    /**
+     * @throw Throws an exception if the create info has a pNext chain
+     */
+    static Key MakeKey(const VkSamplerCreateInfo& info);
+
+    /**
+     * @brief A sampler created from info, or the one already created from the same parameters
+     *
+     * @throw Throws an exception if the sampler can't be created
+     */
+    Handle acquire(const VkSamplerCreateInfo& info);
+
+    Stats stats() const;
+
+  private:
+    const Device& m_device;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<Key, std::weak_ptr<const VkSampler>, Hash> m_samplers;
+    size_t m_hits   = 0;
+    size_t m_misses = 0;
+    size_t m_live   = 0;
+
+    void release(const Key& key, const VkSampler* sampler);
+  };
+
+}  // namespace vkl
+
+#endif  // SAMPLERCACHE_HPP
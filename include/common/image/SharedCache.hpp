@@ -0,0 +1,93 @@
+/**
+ * @file SharedCache.hpp
+ * @brief Define SharedCache class
+ */
+
+#ifndef SHAREDCACHE_HPP
+#define SHAREDCACHE_HPP
+
+#include <common/NoCopy.hpp>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace vkl {
+
+  /**
+   * @brief Resources shared by key, created on the first acquire() and kept until trim() finds nobody else holds them
+   *
+   * The bookkeeping of TextureCache, without the device: Resource only needs a size() in bytes. Any thread can call it,
+   * the resource is created under the lock so two threads never create the same key.
+   */
+  template <typename Key, typename Resource>
+  class SharedCache : public NoCopy {
+  public:
+    struct Stats {
+      size_t hits;
+      size_t misses;
+      size_t entries;
+      size_t residentBytes;  // sum of Resource::size(), at the time of the call
+    };
+
+    bool contains(const Key& key) const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_entries.count(key) > 0;
+    }
+
+    /**
+     * @brief The resource of the key, create() makes it on a miss
+     *
+     * Nothing is cached nor counted when create() throws.
+     */
+    template <typename Create>
+    std::shared_ptr<Resource> acquire(const Key& key, Create&& create) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      const auto found = m_entries.find(key);
+      if (found != m_entries.end()) {
+        m_hits++;
+        return found->second;
+      }
+
+      std::shared_ptr<Resource> resource = create();
+      m_entries.emplace(key, resource);
+      m_misses++;
+
+      return resource;
+    }
+
+    /**
+     * @brief Release the resources which only the cache holds
+     */
+    void trim() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->second.use_count() == 1) {
+          it = m_entries.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+
+    Stats stats() const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      size_t residentBytes = 0;
+      for (const auto& [key, resource] : m_entries) residentBytes += resource->size();
+
+      return {m_hits, m_misses, m_entries.size(), residentBytes};
+    }
+
+  private:
+    mutable std::mutex m_mutex;
+    std::map<Key, std::shared_ptr<Resource>> m_entries;
+    size_t m_hits   = 0;
+    size_t m_misses = 0;
+  };
+
+}  // namespace vkl
+
+#endif  // SHAREDCACHE_HPP
@@ -1,12 +1,22 @@
 #ifndef TEXTURE_HPP
 #define TEXTURE_HPP
 
-#include <common/CommandBuffers.hpp>
-#include <common/CommandPool.hpp>
-#include <common/buffer/Buffer.hpp>
+#include <common/buffer/StagingHeap.hpp>
+#include <common/buffer/StagingRing.hpp>
+#include <common/image/BlockCompression.hpp>
 #include <common/image/Image.hpp>
+#include <common/image/Mipmap.hpp>
+#include <common/io/MappedFile.hpp>
+#include <common/misc/Device.hpp>
 
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
 #include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 #define STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_STATIC
@@ -16,49 +26,374 @@ namespace vkl {
 
   class Texture : public Image {
   public:
-    Texture(const Device& device, const CommandPool& commandPool, const std::string& filename)
-        : Image(device), m_commandPool(commandPool) {
+    /**
+     * @brief Pixels decoded from an image file, RGBA 8 bits, or the blocks read from a compressed one
+     */
+    struct Pixels {
+      uint32_t width;
+      uint32_t height;
+      std::vector<stbi_uc> data;  // the levels one after the other, see image::mipChainSize or image::blockChainSize
+      uint32_t levels = 1;
+      VkFormat format = VK_FORMAT_UNDEFINED;  // of the blocks, undefined for RGBA 8 bits
+      StagingHeap::Allocation staged = {};     // holds the levels instead of data, when decoded into a StagingHeap
+
+      inline const stbi_uc* bytes() const { return staged.data ? staged.data : data.data(); }
+      inline bool empty() const { return !staged.data && data.empty(); }
+    };
+
+    /**
+     * @brief Read the blocks of a KTX2 or DDS file as they are, decode any other image with stb_image
+     *
+     * The format the texture will be created with gives the color space of the files which have none. With mipChain,
+     * every level of a decoded image is built on the CPU, for the textures which stream their levels from the tail.
+     *
+     * @throw Throws an exception if the image can't be loaded
+     */
+    static Pixels Decode(const std::string& filename, VkFormat format = VK_FORMAT_R8G8B8A8_SRGB,
+                         bool mipChain = false) {
+      if (image::isCompressedFile(filename)) {
+        image::CompressedImage compressed = image::loadCompressed(filename, image::isSrgb(format));
+
+        return {
+            .width  = compressed.width,
+            .height = compressed.height,
+            .data   = std::move(compressed.data),
+            .levels = compressed.levels,
+            .format = compressed.format,
+        };
+      }
+
       int texWidth, texHeight, texChannels;
-      stbi_uc* pixels        = stbi_load(filename.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
-      VkDeviceSize imageSize = texWidth * texHeight * 4;
+      stbi_uc* pixels = stbi_load(filename.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
 
       if (!pixels) {
         throw std::runtime_error("failed to load texture image!");
       }
 
-      std::vector<stbi_uc> pixelConv(pixels, pixels + imageSize);
-      Buffer<stbi_uc> textureBuffer(m_device, pixelConv, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
+      Pixels result = {
+          .width  = static_cast<uint32_t>(texWidth),
+          .height = static_cast<uint32_t>(texHeight),
+          .data   = std::vector<stbi_uc>(pixels, pixels + texWidth * texHeight * 4),
+      };
       stbi_image_free(pixels);
 
-      createImage(texWidth, texHeight);
-      allocateMemory();
+      if (mipChain) {
+        result.levels = image::mipLevels(result.width, result.height);
+        image::buildMipChain(result.data, result.width, result.height, result.levels, image::isSrgb(format));
+      }
+
+      return result;
+    }
+
+    /**
+     * @brief The same, written straight to staging memory which the upload copies to the device as it is
+     *
+     * The blocks go from the mapped file to the heap. stb_image can only decode to memory of its own, which is copied
+     * to the heap and freed at once; the levels a blit can't make are then built in place.
+     *
+     * @throw Throws an exception if the image can't be loaded
+     */
+    static Pixels Decode(const std::string& filename, VkFormat format, StagingHeap& heap, bool mipChain = false) {
+      const MappedFile file(filename);
+      const uint8_t* data = reinterpret_cast<const uint8_t*>(file.data());
+
+      if (image::isCompressedFile(filename)) {
+        const image::CompressedLayout layout = image::layoutCompressed(data, file.size(), image::isSrgb(format));
+
+        const Pixels pixels = {
+            .width  = layout.width,
+            .height = layout.height,
+            .data   = {},
+            .levels = layout.levels,
+            .format = layout.format,
+            .staged = heap.allocate(image::blockChainSize(layout.format, layout.width, layout.height, layout.levels)),
+        };
+        image::copyLevels(data, layout, pixels.staged.data);
+
+        return pixels;
+      }
+
+      int texWidth, texHeight, texChannels;
+      stbi_uc* decoded = file.size() > 0 && file.size() <= INT_MAX
+                             ? stbi_load_from_memory(data, static_cast<int>(file.size()), &texWidth, &texHeight,
+                                                     &texChannels, STBI_rgb_alpha)
+                             : nullptr;
+
+      if (!decoded) {
+        throw std::runtime_error("failed to load texture image!");
+      }
+
+      const uint32_t width = static_cast<uint32_t>(texWidth), height = static_cast<uint32_t>(texHeight);
+      const uint32_t levels = BlitsMipmaps(heap.device(), format) && !mipChain ? 1 : image::mipLevels(width, height);
+
+      const Pixels pixels = {
+          .width  = width,
+          .height = height,
+          .data   = {},
+          .levels = levels,
+          .staged = heap.allocate(image::mipChainSize(width, height, levels)),
+      };
+      std::memcpy(pixels.staged.data, decoded, image::mipChainSize(width, height, 1));
+      stbi_image_free(decoded);
+
+      image::buildMipChain(pixels.staged.data, width, height, levels, image::isSrgb(format));
+
+      return pixels;
+    }
+
+    /**
+     * @brief Copy the pixels through the ring, the image can be sampled once the ring has been flushed
+     *
+     * RGBA 8 bits pixels get a full mip chain : the levels missing from the pixels are blitted on the device when the
+     * format supports linear blits, built on the CPU otherwise. Blocks are copied as they are, with the levels of the
+     * file, when the device can sample them; otherwise they are decoded to RGBA 8 bits on the CPU first.
+     *
+     * With a tailSize, only the levels from the first one whose larger side fits in it are created and copied, the
+     * others are streamed in later, see stream().
+     */
+    Texture(const Device& device,
+            StagingRing& staging,
+            const Pixels& pixels,
+            VkFormat format   = VK_FORMAT_R8G8B8A8_SRGB,
+            uint32_t tailSize = 0)
+        : Image(device), m_width(pixels.width), m_height(pixels.height) {
+      const bool blocks = image::isBlockCompressed(pixels.format) && device.features().textureCompressionBC;
+      if (blocks) {
+        m_format     = pixels.format;
+        m_mipLevels  = pixels.levels;
+        m_blockSize  = 4;
+        m_blockBytes = image::blockBytes(m_format);
+      } else {
+        m_format    = !image::isBlockCompressed(pixels.format) ? format
+                      : image::isSrgb(pixels.format)           ? VK_FORMAT_R8G8B8A8_SRGB
+                                                               : VK_FORMAT_R8G8B8A8_UNORM;
+        m_mipLevels = image::mipLevels(pixels.width, pixels.height);
+      }
+
+      m_tailLevel     = TailLevel(m_width, m_height, m_mipLevels, tailSize);
+      m_residentLevel = m_tailLevel;
+      m_size          = chainOffset(m_mipLevels) - chainOffset(m_residentLevel);
+      createImage(image::mipSize(m_width, m_residentLevel), image::mipSize(m_height, m_residentLevel));
+      allocateMemory(MemoryCategory::Texture);
 
-      copyBufferToImage(textureBuffer.buffer(), static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight));
+      if (m_residentLevel > 0) {
+        copyChain(staging, pixels, m_residentLevel, m_mipLevels);
+      } else if (blocks) {
+        copyLevels(staging, pixels);
+      } else if (!image::isBlockCompressed(pixels.format)) {
+        copyPixels(staging, pixels);
+      } else {
+        const Pixels decoded = {
+            .width  = pixels.width,
+            .height = pixels.height,
+            .data   = image::decompress(pixels.format, pixels.width, pixels.height, pixels.levels, pixels.bytes()),
+            .levels = pixels.levels,
+        };
+        copyPixels(staging, decoded);
+      }
 
       createImageView();
       createSampler();
     };
 
+    ~Texture() { releaseRetired(); }
+
+    /**
+     * @brief Levels of the whole chain, resident or not
+     */
+    inline uint32_t mipLevels() const { return m_mipLevels; }
+
+    /**
+     * @brief The finest level on the device, the image and its view hold the levels [residentLevel, mipLevels)
+     */
+    inline uint32_t residentLevel() const { return m_residentLevel; }
+
+    /**
+     * @brief The level the texture was created from, and is evicted back to
+     */
+    inline uint32_t tailLevel() const { return m_tailLevel; }
+
+    /**
+     * @brief Bytes of the resident levels on the device
+     */
+    inline size_t size() const { return m_size; }
+
+    /**
+     * @brief Bytes of a level, resident or not
+     */
+    inline size_t levelSize(uint32_t level) const { return chainOffset(level + 1) - chainOffset(level); }
+
+    /**
+     * @brief Make the levels [level, residentLevel) resident, from pixels decoded from the same file with their mip
+     * chain
+     *
+     * The image is replaced by a larger one : the new levels are copied from the pixels, the resident ones from the
+     * previous image on the device. The view changes, so the descriptors which refer to it must be written again; the
+     * previous image is kept, tagged with generation, until releaseRetired(), which must wait for the frames which may
+     * still sample it and for the copies from it.
+     */
+    void stream(StagingRing& staging, const Pixels& pixels, uint32_t level, uint64_t generation = 0) {
+      if (level >= m_residentLevel) return;
+
+      const uint32_t resident = m_residentLevel;
+      const VkImage previous  = retire(level, generation);
+
+      copyChain(staging, pixels, level, resident);
+      staging.copyImage(previous, 0, m_image, resident - level, m_mipLevels - resident,
+                        image::mipSize(m_width, resident), image::mipSize(m_height, resident));
+
+      createImageView();
+    }
+
+    /**
+     * @brief Release the levels [residentLevel, level), the image is replaced by a smaller one as by stream()
+     */
+    void evict(StagingRing& staging, uint32_t level, uint64_t generation = 0) {
+      if (level <= m_residentLevel || level >= m_mipLevels) return;
+
+      const uint32_t resident = m_residentLevel;
+      const VkImage previous  = retire(level, generation);
+
+      staging.copyImage(previous, level - resident, m_image, 0, m_mipLevels - level, image::mipSize(m_width, level),
+                        image::mipSize(m_height, level));
+
+      createImageView();
+    }
+
+    /**
+     * @brief Destroy the images replaced by stream() and evict() up to this generation, once the device no longer uses
+     * them
+     */
+    void releaseRetired(uint64_t generation = UINT64_MAX) {
+      std::vector<Retired> kept;
+      for (const Retired& retired : m_retired) {
+        if (retired.generation > generation) {
+          kept.push_back(retired);
+          continue;
+        }
+
+        vkDestroyImageView(m_device.logical(), retired.view, nullptr);
+        vkDestroyImage(m_device.logical(), retired.image, nullptr);
+        m_device.allocator().free(retired.memory);
+      }
+      m_retired = std::move(kept);
+    }
+
   private:
-    const CommandPool& m_commandPool;
+    struct Retired {
+      VkImage image;
+      MemoryAllocator::Allocation memory;
+      VkImageView view;
+      uint64_t generation;
+    };
+
+    VkFormat m_format;  // 4 bytes per pixel as decoded, or the format of the blocks
+    uint32_t m_width;   // of the level 0, resident or not
+    uint32_t m_height;
+    uint32_t m_mipLevels;
+    uint32_t m_residentLevel;
+    uint32_t m_tailLevel;
+    uint32_t m_blockSize  = 1;  // texels on a side of a block, 1 for RGBA 8 bits
+    uint32_t m_blockBytes = 4;
+    size_t m_size;
+    std::vector<Retired> m_retired;
+
+    // The first level whose larger side fits in tailSize, 0 without one
+    static uint32_t TailLevel(uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t tailSize) {
+      if (tailSize == 0) return 0;
+
+      uint32_t level = 0;
+      while (level + 1 < mipLevels && (std::max(width, height) >> level) > tailSize) level++;
+      return level;
+    }
+
+    // Where a level starts in the whole chain, tightly packed
+    size_t chainOffset(uint32_t level) const {
+      return m_blockSize > 1 ? image::blockChainSize(m_format, m_width, m_height, level)
+                             : image::mipChainSize(m_width, m_height, level);
+    }
+
+    void copyPixels(StagingRing& staging, const Pixels& pixels) {
+      if (pixels.levels == m_mipLevels || BlitsMipmaps(m_device, m_format)) {
+        copyLevels(staging, pixels);
+      } else {
+        copyChain(staging, pixels, 0, m_mipLevels);
+      }
+    }
+
+    // From the heap they were decoded into, or through the ring
+    void copyLevels(StagingRing& staging, const Pixels& pixels) {
+      if (pixels.staged.data) {
+        staging.copy(pixels.staged.buffer, pixels.staged.offset, m_image, pixels.width, pixels.height, pixels.levels,
+                     m_mipLevels, m_blockSize, m_blockBytes);
+      } else {
+        staging.copy(pixels.data.data(), m_image, pixels.width, pixels.height, pixels.levels, m_mipLevels,
+                     m_blockSize, m_blockBytes);
+      }
+    }
+
+    /**
+     * @brief Copy the levels [first, last) of the whole chain to the first levels of the image, built on the CPU from
+     * the pixels when they don't hold them as the image stores them
+     */
+    void copyChain(StagingRing& staging, const Pixels& pixels, uint32_t first, uint32_t last) {
+      std::vector<uint8_t> built;
+      const uint8_t* chain = pixels.bytes();
+
+      if (m_blockSize == 1 && (image::isBlockCompressed(pixels.format) || pixels.levels < m_mipLevels)) {
+        built = image::isBlockCompressed(pixels.format)
+                    ? image::decompress(pixels.format, m_width, m_height, 1, pixels.bytes())
+                    : std::vector<uint8_t>(pixels.bytes(), pixels.bytes() + image::mipChainSize(m_width, m_height, 1));
+        image::buildMipChain(built, m_width, m_height, m_mipLevels, image::isSrgb(m_format));
+        chain = built.data();
+      }
+
+      staging.copy(chain + chainOffset(first), m_image, image::mipSize(m_width, first), image::mipSize(m_height, first),
+                   last - first, last - first, m_blockSize, m_blockBytes);
+    }
+
+    /**
+     * @brief Keep the image aside for releaseRetired(), and create the one of the levels [level, mipLevels) instead
+     * @return The previous image
+     */
+    VkImage retire(uint32_t level, uint64_t generation) {
+      const Retired retired = {m_image, m_memory, m_imageView, generation};
+      m_retired.push_back(retired);
+      m_image     = VK_NULL_HANDLE;
+      m_memory    = {};
+      m_imageView = VK_NULL_HANDLE;
+
+      m_residentLevel = level;
+      m_size          = chainOffset(m_mipLevels) - chainOffset(m_residentLevel);
+      createImage(image::mipSize(m_width, level), image::mipSize(m_height, level));
+      allocateMemory(MemoryCategory::Texture);
+
+      return retired.image;
+    }
+
+    static bool BlitsMipmaps(const Device& device, VkFormat format) {
+      return misc::formatIsFilterable(device.physical(), format, VK_IMAGE_TILING_OPTIMAL,
+                                      VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT
+                                          | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT);
+    }
 
     void createImage(uint32_t width, uint32_t height) final {
       const VkImageCreateInfo imageInfo = {
           .sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
           .imageType     = VK_IMAGE_TYPE_2D,
-          .format        = VK_FORMAT_R8G8B8A8_SRGB,
+          .format        = m_format,
           .extent = {
             .width  = width,
             .height = height,
             .depth  = 1,
           },
-          .mipLevels     = 1,
+          .mipLevels     = m_mipLevels - m_residentLevel,
           .arrayLayers   = 1,
           .samples       = VK_SAMPLE_COUNT_1_BIT,
           .tiling        = VK_IMAGE_TILING_OPTIMAL,
-          .usage         = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+          // Each level is the source of the blit of the next one
+          .usage         = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT
+                           | VK_IMAGE_USAGE_SAMPLED_BIT,
           .sharingMode   = VK_SHARING_MODE_EXCLUSIVE,
           .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
       };
@@ -73,11 +408,11 @@ namespace vkl {
           .sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
           .image                           = m_image,
           .viewType                        = VK_IMAGE_VIEW_TYPE_2D,
-          .format                          = VK_FORMAT_R8G8B8A8_SRGB,
+          .format                          = m_format,
           .subresourceRange = {
             .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
             .baseMipLevel   = 0,
-            .levelCount     = 1,
+            .levelCount     = m_mipLevels - m_residentLevel,
             .baseArrayLayer = 0,
             .layerCount     = 1,
           },
@@ -100,76 +435,15 @@ namespace vkl {
           .anisotropyEnable        = VK_FALSE,
           .compareEnable           = VK_FALSE,
           .compareOp               = VK_COMPARE_OP_ALWAYS,
+          .minLod                  = 0.0f,
+          // Not the levels of the texture, its view already limits them, so that every texture shares one sampler
+          .maxLod                  = VK_LOD_CLAMP_NONE,
           .borderColor             = VK_BORDER_COLOR_INT_OPAQUE_BLACK,
           .unnormalizedCoordinates = VK_FALSE,
       };
 
-      if (vkCreateSampler(m_device.logical(), &samplerInfo, nullptr, &m_sampler) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create texture sampler!");
-      }
+      m_sampler = m_device.samplers().acquire(samplerInfo);
     };
-
-    // Transfomation de donnée du buffer vers vkImage pour pouvoir traiter
-    void copyBufferToImage(VkBuffer buffer, uint32_t width, uint32_t height) {
-      CommandBuffers::SingleTimeCommands(
-          m_device, m_commandPool, m_device.graphicsQueue(), [&](const VkCommandBuffer& commandBuffer) {
-            const VkImageSubresourceRange subresourceRange = {
-                .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
-                .baseMipLevel   = 0,
-                .levelCount     = 1,
-                .baseArrayLayer = 0,
-                .layerCount     = 1,
-            };
-
-            const VkImageMemoryBarrier aquire_barrier = {
-                .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
-                .srcAccessMask       = 0,
-                .dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT,
-                .oldLayout           = VK_IMAGE_LAYOUT_UNDEFINED,
-                .newLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-                .image               = m_image,
-                .subresourceRange    = subresourceRange,
-            };
-
-            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0,
-                                 nullptr, 0, nullptr, 1, &aquire_barrier);
-
-            const VkImageSubresourceLayers imageSubresource = {
-                .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
-                .mipLevel       = 0,
-                .baseArrayLayer = 0,
-                .layerCount     = 1,
-            };
-
-            const VkBufferImageCopy region = {
-                .bufferOffset      = 0,
-                .bufferRowLength   = 0,
-                .bufferImageHeight = 0,
-                .imageSubresource  = imageSubresource,
-                .imageOffset       = {0, 0, 0},
-                .imageExtent       = {width, height, 1},
-            };
-
-            vkCmdCopyBufferToImage(commandBuffer, buffer, m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-            const VkImageMemoryBarrier release_barrier = {
-                .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
-                .srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT,
-                .dstAccessMask       = VK_ACCESS_SHADER_READ_BIT,
-                .oldLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                .newLayout           = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-                .image               = m_image,
-                .subresourceRange    = subresourceRange,
-            };
-
-            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-                                 0, 0, nullptr, 0, nullptr, 1, &release_barrier);
-          });
-    }
   };
 
 }  // namespace vkl
@@ -0,0 +1,97 @@
+/**
+ * @file TextureCache.hpp
+ * @brief Define TextureCache class
+ */
+
+#ifndef TEXTURECACHE_HPP
+#define TEXTURECACHE_HPP
+
+#include <common/NoCopy.hpp>
+#include <common/VulkanHeader.hpp>
+#include <common/buffer/StagingRing.hpp>
+#include <common/image/SharedCache.hpp>
+#include <common/image/Texture.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace vkl {
+
+  /**
+   * @brief The textures on the device, shared by every material and model which samples the same file
+   *
+   * Only the thread which owns the queue uploads through it, contains() can be called from a loading thread to skip
+   * the decode of a resident texture.
+   */
+  class TextureCache : public NoCopy {
+  public:
+    /**
+     * @brief A file, and how its pixels are decoded
+     */
+    struct Key {
+      std::string path;  // canonical
+      VkFormat format;
+
+      bool operator==(const Key& other) const = default;
+      bool operator<(const Key& other) const {
+        return path != other.path ? path < other.path : format < other.format;
+      }
+    };
+
+    struct Stats {
+      size_t hits;
+      size_t misses;
+      size_t textures;
+      size_t residentBytes;  // of the levels on the device, which streaming changes
+    };
+
+    /**
+     * @param tailSize The textures are created with only their levels which fit in it, 0 creates them whole; see
+     * Texture::stream
+     */
+    explicit TextureCache(const Device& device, uint32_t tailSize = 0) : m_device(device), m_tailSize(tailSize) {}
+
+    /**
+     * @brief The device its textures live on, for the staging memory they are decoded into
+     */
+    inline const Device& device() const { return m_device; }
+
+    /**
+     * @brief Whether the textures are streamed from a tail, their pixels are then decoded with their mip chain
+     */
+    inline uint32_t tailSize() const { return m_tailSize; }
+
+    /**
+     * @brief The key of a file, whatever the path used to reach it
+     */
+    static Key MakeKey(const std::string& path, VkFormat format = VK_FORMAT_R8G8B8A8_SRGB);
+
+    inline bool contains(const Key& key) const { return m_textures.contains(key); }
+
+    /**
+     * @brief The texture of the key, uploaded through the ring on a miss
+     *
+     * The pixels can be empty when the texture was resident at decode time, they are decoded again if it was released
+     * since.
+     * @throw Throws an exception if the image can't be loaded
+     */
+    std::shared_ptr<Texture> acquire(StagingRing& staging, const Key& key, const Texture::Pixels& pixels);
+
+    /**
+     * @brief Release the textures which only the cache holds
+     */
+    inline void trim() { m_textures.trim(); }
+
+    Stats stats() const;
+
+  private:
+    const Device& m_device;
+    uint32_t m_tailSize;
+
+    SharedCache<Key, Texture> m_textures;
+  };
+
+}  // namespace vkl
+
+#endif  // TEXTURECACHE_HPP
@@ -0,0 +1,122 @@
+/**
+ * @file TextureStreamer.hpp
+ * @brief Define TextureStreamer class
+ */
+
+#ifndef TEXTURESTREAMER_HPP
+#define TEXTURESTREAMER_HPP
+
+#include <common/NoCopy.hpp>
+#include <common/VulkanHeader.hpp>
+#include <common/buffer/StagingRing.hpp>
+#include <common/image/Texture.hpp>
+#include <common/image/TextureCache.hpp>
+#include <common/struct/TextureFeedback.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace vkl {
+
+  /**
+   * @brief Bring the levels of the textures created from their tail (see TextureCache::tailSize) to what the screen
+   * shows of them, and back to their tail once they are no longer seen
+   *
+   * The files are decoded again on the shared thread pool, with their mip chain, and released once the levels asked
+   * for are resident. The levels are copied by the render thread, which calls update() once per frame, within a
+   * budget of bytes per frame, without waiting for the copies.
+   *
+   * Each update() which changes views is a generation: the descriptors written since refer to the new views, and the
+   * images replaced are destroyed once no descriptor written before refers to them, see releaseRetired().
+   */
+  class TextureStreamer : public NoCopy {
+  public:
+    static constexpr uint32_t DefaultTailSize       = 64;
+    static constexpr VkDeviceSize DefaultFrameBudget = 4 << 20;
+    static constexpr uint32_t DefaultEvictFrames    = 300;
+
+    struct Stats {
+      size_t streamedBytes;  // copied to the device since the start
+      size_t promotions;     // times a texture gained levels
+      size_t evictions;      // times a texture went back to its tail
+      size_t decoding;       // files being decoded
+    };
+
+    /**
+     * @param frameBudget Bytes copied per frame at most, but at least one level per frame
+     * @param evictFrames Frames without any feedback after which a texture goes back to its tail
+     */
+    explicit TextureStreamer(VkDeviceSize frameBudget = DefaultFrameBudget, uint32_t evictFrames = DefaultEvictFrames)
+        : m_frameBudget(frameBudget), m_evictFrames(evictFrames) {}
+
+    /**
+     * @brief Stream these textures, instead of the previous ones; the textures without a tail are left alone
+     *
+     * The images the previous ones replaced are destroyed, the device must no longer use them.
+     */
+    void track(const std::vector<std::shared_ptr<Texture>>& textures, const std::vector<TextureCache::Key>& keys);
+
+    /**
+     * @brief What a frame sampled of a texture, read back from the fragment shader
+     */
+    void feedback(const Texture& texture, const TextureFeedback& feedback);
+
+    /**
+     * @brief Record the copies of this frame through the ring, and submit them without waiting
+     *
+     * @return Whether the view of a texture changed, in a new generation : the descriptors which refer to it must then
+     * be written again, each once the frames which use it are done
+     */
+    bool update(StagingRing& staging);
+
+    /**
+     * @brief The generation of the current views, 0 until a view changes
+     */
+    inline uint64_t generation() const { return m_generation; }
+
+    /**
+     * @brief Destroy the images replaced up to this generation whose copies are done; every descriptor which referred
+     * to them must have been written again since, once the frames which used it were done
+     */
+    void releaseRetired(StagingRing& staging, uint64_t generation);
+
+    Stats stats() const;
+
+  private:
+    struct Entry {
+      std::shared_ptr<Texture> texture;
+      TextureCache::Key key;
+      uint32_t wanted;      // finest level the feedback asked for
+      uint32_t idleFrames;  // since the last feedback
+      std::future<Texture::Pixels> decoding;
+      Texture::Pixels pixels;  // the whole chain, while levels are missing
+    };
+
+    VkDeviceSize m_frameBudget;
+    uint32_t m_evictFrames;
+
+    // The generations whose images aren't destroyed yet, with the submission of their copies, see StagingRing::done
+    struct Retiring {
+      uint64_t generation;
+      uint64_t serial;
+    };
+
+    std::vector<Entry> m_entries;
+    std::deque<Retiring> m_retiring;
+    uint64_t m_generation  = 0;
+    size_t m_streamedBytes = 0;
+    size_t m_promotions    = 0;
+    size_t m_evictions     = 0;
+
+    /**
+     * @brief The pixels of the entry once decoded, the decode is started on the first call
+     */
+    const Texture::Pixels* decoded(Entry& entry);
+  };
+
+}  // namespace vkl
+
+#endif  // TEXTURESTREAMER_HPP
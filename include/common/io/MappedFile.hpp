@@ -0,0 +1,43 @@
+/**
+ * @file MappedFile.hpp
+ * @brief Define MappedFile class
+ */
+
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <common/NoCopy.hpp>
+#include <cstddef>
+#include <string>
+
+namespace vkl {
+
+  /**
+   * @brief A read-only memory mapping of a whole file.
+   *
+   * The file content is paged in by the OS on demand, so large models can be read without going through iostreams or
+   * copying them in a heap buffer first.
+   */
+  class MappedFile : public NoCopy {
+  public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    inline const char* data() const { return m_data; }
+    inline size_t size() const { return m_size; }
+
+  private:
+    const char* m_data = nullptr;
+    size_t m_size      = 0;
+
+#ifdef _WIN32
+    void* m_file    = nullptr;
+    void* m_mapping = nullptr;
+#else
+    int m_fd = -1;
+#endif
+  };
+
+}  // namespace vkl
+
+#endif  // MAPPEDFILE_HPP
@@ -0,0 +1,132 @@
+/**
+ * @file ClusterFile.hpp
+ * @brief Define ClusterFile class
+ */
+
+#ifndef CLUSTERFILE_HPP
+#define CLUSTERFILE_HPP
+
+#include <common/NoCopy.hpp>
+#include <common/io/MappedFile.hpp>
+#include <common/struct/Material.hpp>
+#include <common/struct/Vertex.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vkl {
+
+  struct ClusterBuildOption {
+    uint32_t clusterTriangles = 8192;       // triangles of a cluster, and vertices, at most
+    size_t chunkSize          = 64 << 20;   // bytes of the OBJ parsed at a time
+    size_t memoryBudget       = 256 << 20;  // bytes of triangles sorted at a time
+  };
+
+  /**
+   * @brief A model split in clusters of nearby triangles, stored on disk (.vkclusters) for models larger than the host
+   * memory
+   *
+   * Built from the OBJ in a bounded amount of memory : the file is parsed part after part (ObjLoader::Stream), the
+   * attributes and triangles go to temporary files, which are mapped to sort the triangles in a grid over the model,
+   * window after window. Each cluster has its own vertices and a single material. Once built the file is mapped, and
+   * only the clusters read are paged in. Like MeshCache, it is built again when the OBJ or one of its MTL changed; only
+   * their size and modification time are compared, hashing such files would take as long as building it.
+   */
+  class ClusterFile : public NoCopy {
+  public:
+    /**
+     * @brief Bumped each time the layout of the file, or of one of the stored structs, changes
+     */
+    static constexpr uint32_t Version = 1;
+
+    struct Cluster {
+      uint64_t firstVertex;  // in the vertices of the file
+      uint64_t firstIndex;   // in the indices of the file, which start from 0 in each cluster
+      glm::vec3 min;
+      glm::vec3 max;
+      int32_t materialId;  // -1 when the triangles have no (known) material
+      uint32_t vertexCount;
+      uint32_t indexCount;
+    };
+
+    /**
+     * @brief Where the clusters of sourcePath live, see MeshCache::Path
+     */
+    static std::string Path(const std::string& sourcePath, const std::string& cacheDir = "");
+
+    /**
+     * @brief The clusters of an OBJ, built first if the file is missing, from another version, or out of date
+     * @throw Throws an exception if the OBJ can't be read or the file can't be written
+     */
+    static std::unique_ptr<ClusterFile> Open(const std::string& sourcePath,
+                                             const std::string& cacheDir      = "",
+                                             const ClusterBuildOption& option = {});
+
+    /**
+     * @brief Split an OBJ in clusters, written to clusterPath
+     * @throw Throws an exception if the OBJ can't be read or the file can't be written
+     */
+    static void Build(const std::string& sourcePath,
+                      const std::string& clusterPath,
+                      const ClusterBuildOption& option = {});
+
+    /**
+     * @throw Throws an exception if the file is missing, truncated or from another version
+     */
+    explicit ClusterFile(const std::string& path);
+
+    /**
+     * @brief Whether the files it has been built from are unchanged
+     */
+    bool upToDate() const;
+
+    inline const std::vector<Cluster>& clusters() const { return m_clusters; }
+    inline const std::vector<Material>& materials() const { return m_materials; }
+    inline const std::vector<std::string>& textures() const { return m_textures; }  // diffuse texture of each material
+
+    inline const glm::vec3& min() const { return m_min; }
+    inline const glm::vec3& max() const { return m_max; }
+    inline uint64_t triangleCount() const { return m_triangleCount; }
+
+    /**
+     * @brief The most vertices and indices of a cluster
+     */
+    inline uint32_t maxVertices() const { return m_maxVertices; }
+    inline uint32_t maxIndices() const { return m_maxIndices; }
+
+    /**
+     * @brief Where the vertices and indices of a cluster are mapped, read from the file when first touched
+     */
+    inline const Vertex* vertices(const Cluster& cluster) const { return m_vertices + cluster.firstVertex; }
+    inline const uint32_t* indices(const Cluster& cluster) const { return m_indices + cluster.firstIndex; }
+
+  private:
+    struct Source {
+      std::string path;
+      int64_t mtime;
+      uint64_t size;
+    };
+
+    MappedFile m_file;
+
+    std::vector<Source> m_sources;
+    std::vector<Cluster> m_clusters;
+    std::vector<Material> m_materials;
+    std::vector<std::string> m_textures;
+
+    glm::vec3 m_min;
+    glm::vec3 m_max;
+    uint64_t m_triangleCount;
+    uint32_t m_maxVertices;
+    uint32_t m_maxIndices;
+
+    const Vertex* m_vertices;
+    const uint32_t* m_indices;
+  };
+
+}  // namespace vkl
+
+#endif  // CLUSTERFILE_HPP
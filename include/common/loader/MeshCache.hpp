@@ -0,0 +1,52 @@
+/**
+ * @file MeshCache.hpp
+ * @brief Define MeshCache class
+ */
+
+#ifndef MESHCACHE_HPP
+#define MESHCACHE_HPP
+
+#include <common/mesh/MeshData.hpp>
+#include <string>
+#include <vector>
+
+namespace vkl {
+
+  /**
+   * @brief Binary cache of a parsed model (.vkmesh)
+   *
+   * The file stores the MeshData arrays as they are in memory, so reading it back is a mapping and a few copies. It also
+   * records the size, the modification time and a hash of every source file (the OBJ and its MTL): when a source has
+   * changed the cache is ignored, and rewritten by the caller.
+   */
+  class MeshCache {
+  public:
+    /**
+     * @brief Bumped each time the layout of the file, or of one of the stored structs, changes
+     */
+    static constexpr uint32_t Version = 2;
+
+    /**
+     * @brief Where the cache of sourcePath lives : next to it, or in cacheDir if not empty
+     * @param variant Distinguish meshes built from the same source with different options
+     */
+    static std::string Path(const std::string& sourcePath,
+                            const std::string& cacheDir = "",
+                            const std::string& variant  = "");
+
+    /**
+     * @brief Read a cache file
+     * @return false if the file is missing, corrupted, from another version, or if one of its sources changed
+     */
+    static bool Read(const std::string& cachePath, MeshData& mesh);
+
+    /**
+     * @brief Write a cache file, sources are the files the mesh has been built from
+     * @return false (with a message on cerr) if the file can't be written, as the cache is optional
+     */
+    static bool Write(const std::string& cachePath, const std::vector<std::string>& sources, const MeshData& mesh);
+  };
+
+}  // namespace vkl
+
+#endif  // MESHCACHE_HPP
@@ -0,0 +1,97 @@
+/**
+ * @file ObjLoader.hpp
+ * @brief Define ObjLoader class
+ */
+
+#ifndef OBJLOADER_HPP
+#define OBJLOADER_HPP
+
+#include <common/ThreadPool.hpp>
+#include <common/struct/Material.hpp>
+#include <common/struct/Vertex.hpp>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace vkl {
+
+  struct ObjMaterial {
+    std::string name;
+    Material material;
+    std::string diffuseTexname;
+  };
+
+  struct ObjData {
+    std::vector<Vertex> vertices;  // one per face corner, faces are triangulated as a fan
+    std::vector<int> materialIds;  // one per triangle, -1 when the face has no (known) material
+    std::vector<ObjMaterial> materials;
+    std::vector<std::string> materialFiles;  // MTL files actually read
+  };
+
+  /**
+   * @brief A face corner, its indices are 0-based in the whole file, -1 when absent
+   */
+  struct ObjCorner {
+    int v;
+    int vt;
+    int vn;
+
+    bool operator==(const ObjCorner& other) const = default;
+  };
+
+  /**
+   * @brief What ObjLoader::Stream read from a part of a file
+   */
+  struct ObjChunk {
+    std::vector<float> positions;    // 3 per position, after those of the previous parts
+    std::vector<float> normals;      // 3 per normal
+    std::vector<float> texcoords;    // 2 per texture coordinate, v as in the file (not flipped)
+    std::vector<ObjCorner> corners;  // 3 per triangle
+    std::vector<int> materialIds;    // 1 per triangle, -1 when the face has no (known) material
+  };
+
+  /**
+   * @brief A Wavefront OBJ reader
+   *
+   * The file is memory-mapped and split in line-aligned chunks, each chunk is parsed on a worker of the pool. The
+   * per-chunk results are then merged, so the output is the same as a sequential read (same as tinyobj::LoadObj,
+   * flattened like Model used to do).
+   */
+  class ObjLoader {
+  public:
+    /**
+     * @brief Load an OBJ file and the MTL files it references
+     * @param path Path of the .obj file
+     * @param pool Pool used to parse the chunks, must not be called from one of its workers
+     * @throw Throws an exception if the file can't be read or has no face
+     */
+    static ObjData Load(const std::string& path, ThreadPool& pool = ThreadPool::Shared());
+
+    /**
+     * @brief Read an OBJ file part after part, for files which don't fit in memory
+     *
+     * The parts are about chunkSize bytes, cut at a line end, and only one is held at a time. A face may only refer to
+     * attributes defined before the end of its part.
+     * @param out Receives the materials and the MTL files read, the vertices are left to visit
+     * @throw Throws an exception if the file can't be read, a face refers to an attribute not read yet, or there is no
+     * face
+     */
+    static void Stream(const std::string& path,
+                       size_t chunkSize,
+                       const std::function<void(const ObjChunk&)>& visit,
+                       ObjData& out);
+
+    /**
+     * @brief Parse an OBJ already in memory, MTL files are resolved relatively to baseDir
+     */
+    static ObjData Parse(const char* data, size_t size, const std::string& baseDir, ThreadPool& pool);
+
+    /**
+     * @brief Parse a MTL file content and append its materials
+     */
+    static void ParseMaterials(const char* data, size_t size, std::vector<ObjMaterial>& materials);
+  };
+
+}  // namespace vkl
+
+#endif  // OBJLOADER_HPP
@@ -0,0 +1,120 @@
+/**
+ * @file MemoryAllocator.hpp
+ * @brief Define MemoryAllocator class
+ */
+
+#ifndef MEMORYALLOCATOR_HPP
+#define MEMORYALLOCATOR_HPP
+
+#include <common/NoCopy.hpp>
+#include <common/VulkanHeader.hpp>
+#include <common/memory/MemoryStats.hpp>
+#include <common/memory/Tlsf.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vkl {
+
+  class Device;
+
+  /**
+   * @brief The device memory of the buffers and images of a device, sub-allocated from large blocks
+   *
+   * Drivers cap the number of allocations (maxMemoryAllocationCount, 4096 on many) and each one goes to the kernel.
+   * Blocks of DefaultBlockSize, or an eighth of a smaller heap, are reserved per memory type and their ranges handed
+   * out by a Tlsf; a request larger than half a block gets memory of its own. Buffers and optimal images never share
+   * a block, so bufferImageGranularity can't put them on the same page. A block is freed once empty, unless it is the
+   * last of its kind and memory type.
+   *
+   * Host visible blocks are mapped once, when they are created, and stay mapped until freed: Allocation::mapped points
+   * to the range for its whole life, and writes through it only need a flush() on memory without HOST_COHERENT. Any
+   * thread can use it.
+   *
+   * Every range is counted in its heap under the MemoryCategory it was allocated for, with the peaks of the heaps and
+   * the categories, so stats() doesn't walk the blocks.
+   */
+  class MemoryAllocator : public NoCopy {
+  public:
+    static constexpr VkDeviceSize DefaultBlockSize = 64 << 20;
+
+    struct Block;
+
+    struct Allocation {
+      VkDeviceMemory memory   = VK_NULL_HANDLE;  // shared with the other ranges of the block
+      VkDeviceSize offset     = 0;
+      VkDeviceSize size       = 0;
+      Block* block            = nullptr;  // null if nothing is allocated
+      uint32_t node           = Tlsf::Invalid;
+      uint8_t* mapped         = nullptr;  // host visible memory only
+      MemoryCategory category = MemoryCategory::Other;
+    };
+
+    using HeapStats = MemoryHeapStats;
+
+    explicit MemoryAllocator(const Device& device, VkDeviceSize blockSize = DefaultBlockSize);
+    ~MemoryAllocator();
+
+    /**
+     * @brief Allocate the memory of a buffer, or of an image of optimal tiling, and bind it
+     * @throw Throws an exception if no memory type has the properties or the device is out of memory
+     */
+    Allocation allocateBuffer(VkBuffer buffer,
+                              VkMemoryPropertyFlags properties,
+                              MemoryCategory category = MemoryCategory::Other);
+    Allocation allocateImage(VkImage image,
+                             VkMemoryPropertyFlags properties,
+                             MemoryCategory category = MemoryCategory::Other);
+
+    /**
+     * @brief Give the range back to its block, nothing if it is empty
+     */
+    void free(const Allocation& allocation);
+
+    /**
+     * @brief Make the host writes to [offset, offset + size) of the range visible to the device, nothing if the memory
+     * is HOST_COHERENT
+     */
+    void flush(const Allocation& allocation, VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE) const;
+
+    /**
+     * @brief Indexed by memory heap, with the budget of VK_EXT_memory_budget queried now where the device has it
+     */
+    std::vector<HeapStats> stats() const;
+
+    /**
+     * @brief stats() as a JSON document, see WriteMemoryStats
+     */
+    void writeStats(std::ostream& out) const;
+
+  private:
+    const Device& m_device;
+    VkPhysicalDeviceMemoryProperties m_properties;
+    VkDeviceSize m_blockSize;
+
+    mutable std::mutex m_mutex;
+    std::vector<std::vector<std::unique_ptr<Block>>> m_pools;  // 2 per memory type: buffers then images
+    std::vector<std::unique_ptr<Block>> m_dedicated;
+    std::vector<HeapStats> m_heaps;  // counted as blocks and ranges come and go, without the budget
+
+    Allocation allocate(const VkMemoryRequirements& requirements,
+                        VkMemoryPropertyFlags properties,
+                        MemoryCategory category,
+                        bool image);
+
+    HeapStats& heap(const Block& block);
+    void count(const Allocation& allocation);
+    void uncount(const Allocation& allocation);
+
+    uint32_t memoryType(uint32_t typeBits, VkMemoryPropertyFlags properties) const;
+    VkDeviceSize blockSize(uint32_t memoryType) const;
+
+    std::unique_ptr<Block> createBlock(uint32_t memoryType, uint32_t pool, VkDeviceSize size);
+    void destroyBlock(const Block& block);
+  };
+
+}  // namespace vkl
+
+#endif  // MEMORYALLOCATOR_HPP
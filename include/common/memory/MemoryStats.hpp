@@ -0,0 +1,77 @@
+/**
+ * @file MemoryStats.hpp
+ * @brief Define the statistics of the device memory
+ */
+
+#ifndef MEMORYSTATS_HPP
+#define MEMORYSTATS_HPP
+
+#include <array>
+#include <common/VulkanHeader.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace vkl {
+
+  /**
+   * @brief What a buffer or an image holds, to tell where the memory goes
+   */
+  enum class MemoryCategory : uint32_t {
+    Vertex,      // vertices, indices and meshlets
+    Texture,     // sampled images
+    Attachment,  // images rendered to
+    Uniform,     // per-frame constants and materials
+    Staging,     // host copies on their way to the device
+    Particles,   // MPM particles and their deformation gradients
+    Grid,        // MPM grid
+    Other,
+  };
+
+  constexpr size_t MemoryCategoryCount = static_cast<size_t>(MemoryCategory::Other) + 1;
+
+  /**
+   * @brief Lower case, as written to JSON
+   */
+  const char* MemoryCategoryName(MemoryCategory category);
+
+  struct MemoryCategoryStats {
+    size_t allocations = 0;
+    VkDeviceSize used  = 0;  // bytes of the ranges
+    VkDeviceSize peak  = 0;  // most used at once
+  };
+
+  /**
+   * @brief The memory a MemoryAllocator holds in a heap, with the largest it has held since it was created
+   */
+  struct MemoryHeapStats {
+    VkDeviceSize size = 0;  // of the heap
+    bool deviceLocal  = false;
+
+    size_t blocks             = 0;  // memory objects, blocks or dedicated
+    size_t allocations        = 0;  // ranges handed out
+    VkDeviceSize reserved     = 0;  // bytes of the memory objects
+    VkDeviceSize used         = 0;  // bytes of the ranges
+    VkDeviceSize peakReserved = 0;
+    VkDeviceSize peakUsed     = 0;
+
+    // VK_EXT_memory_budget, 0 without it: what the process may allocate without trouble, and what it has allocated
+    // (other allocators and the driver included)
+    VkDeviceSize budget = 0;
+    VkDeviceSize usage  = 0;
+
+    std::array<MemoryCategoryStats, MemoryCategoryCount> categories = {};
+
+    inline MemoryCategoryStats& category(MemoryCategory c) { return categories[static_cast<size_t>(c)]; }
+    inline const MemoryCategoryStats& category(MemoryCategory c) const { return categories[static_cast<size_t>(c)]; }
+  };
+
+  /**
+   * @brief Write the heaps as a JSON document, in bytes, the budget and usage null without VK_EXT_memory_budget
+   */
+  void WriteMemoryStats(std::ostream& out, const std::vector<MemoryHeapStats>& heaps);
+
+}  // namespace vkl
+
+#endif  // MEMORYSTATS_HPP
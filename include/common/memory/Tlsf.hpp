@@ -0,0 +1,89 @@
+/**
+ * @file Tlsf.hpp
+ * @brief Define Tlsf class
+ */
+
+#ifndef TLSF_HPP
+#define TLSF_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vkl {
+
+  /**
+   * @brief Two-level segregated fit allocator of the ranges of a block, in constant time
+   *
+   * The free ranges are listed by size class: a power of two (first level), split in 16 (second level), with a bitmap
+   * of the non empty lists at each level. An allocation takes the first range of the smallest class all of whose ranges
+   * fit, the padding before an aligned offset and what is left after stay free, and a freed range is merged with its
+   * free neighbours. Only offsets are handed out, the memory lives elsewhere.
+   */
+  class Tlsf {
+  public:
+    static constexpr uint32_t Invalid = UINT32_MAX;
+
+    struct Allocation {
+      uint64_t offset;
+      uint64_t size;
+      uint32_t node;  // to give back to free(), Invalid when nothing fits
+    };
+
+    explicit Tlsf(uint64_t size);
+
+    /**
+     * @brief A range of size bytes at a multiple of alignment, a power of two
+     */
+    Allocation allocate(uint64_t size, uint64_t alignment = 1);
+
+    void free(uint32_t node);
+
+    inline uint64_t size() const { return m_size; }
+    inline uint64_t used() const { return m_used; }
+    inline size_t count() const { return m_count; }
+    inline bool empty() const { return m_count == 0; }
+
+  private:
+    static constexpr uint32_t SecondLevelLog2  = 4;
+    static constexpr uint32_t SecondLevelCount = 1 << SecondLevelLog2;
+    static constexpr uint32_t FirstLevelCount  = 64 - SecondLevelLog2 + 1;  // the first one holds the sizes < 16
+
+    struct Node {
+      uint64_t offset;
+      uint64_t size;
+      uint32_t prevPhysical;  // ranges of the block, in order
+      uint32_t nextPhysical;
+      uint32_t prevFree;  // ranges of the same class
+      uint32_t nextFree;
+      bool free;
+    };
+
+    uint64_t m_size;
+    uint64_t m_used = 0;
+    size_t m_count  = 0;
+
+    std::vector<Node> m_nodes;
+    std::vector<uint32_t> m_unused;  // nodes to reuse
+
+    uint64_t m_firstLevel = 0;  // bit per first level with a free range
+    std::array<uint32_t, FirstLevelCount> m_secondLevel{};
+    std::array<std::array<uint32_t, SecondLevelCount>, FirstLevelCount> m_heads;
+
+    static void Mapping(uint64_t size, uint32_t& firstLevel, uint32_t& secondLevel);
+
+    uint32_t findFree(uint64_t size) const;
+    void insertFree(uint32_t node);
+    void removeFree(uint32_t node);
+
+    /**
+     * @brief Cut a range at size bytes, the node keeps the front and the returned one the rest
+     */
+    uint32_t split(uint32_t node, uint64_t size);
+    uint32_t newNode();
+  };
+
+}  // namespace vkl
+
+#endif  // TLSF_HPP
@@ -0,0 +1,73 @@
+/**
+ * @file Adjacency.hpp
+ * @brief Vertex to triangle adjacency, and vertex welding by position
+ */
+
+#ifndef ADJACENCY_HPP
+#define ADJACENCY_HPP
+
+#include <common/struct/Vertex.hpp>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace vkl {
+
+  namespace mesh {
+
+    /**
+     * @brief For each vertex of a triangle list, the triangles using it (compressed rows)
+     */
+    struct TriangleAdjacency {
+      std::vector<uint32_t> offsets;    // vertexCount + 1, the triangles of v are [offsets[v], offsets[v + 1])
+      std::vector<uint32_t> triangles;  // one per corner
+
+      TriangleAdjacency(const std::vector<uint32_t>& indices, size_t vertexCount) : offsets(vertexCount + 1, 0) {
+        for (uint32_t index : indices) ++offsets[index + 1];
+        for (size_t v = 0; v < vertexCount; ++v) offsets[v + 1] += offsets[v];
+
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        triangles.resize(indices.size());
+        for (size_t i = 0; i < indices.size(); ++i) {
+          triangles[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+      }
+
+      inline uint32_t valence(uint32_t vertex) const { return offsets[vertex + 1] - offsets[vertex]; }
+    };
+
+    /**
+     * @brief For each vertex, the first vertex at the same position
+     *
+     * The OBJ corners split on normal or UV seams are still neighbours through it, or a hard edged model would look
+     * like a set of disconnected faces.
+     */
+    inline std::vector<uint32_t> positionRemap(const std::vector<Vertex>& vertices) {
+      size_t capacity = 16;
+      while (capacity < vertices.size() * 2) capacity *= 2;
+      const size_t mask = capacity - 1;
+
+      std::vector<uint32_t> table(capacity, UINT32_MAX);
+      std::vector<uint32_t> remap(vertices.size());
+
+      for (size_t v = 0; v < vertices.size(); ++v) {
+        uint32_t words[3];
+        std::memcpy(words, &vertices[v].pos, sizeof(words));
+
+        size_t slot = ((words[0] * 73856093u) ^ (words[1] * 19349663u) ^ (words[2] * 83492791u)) & mask;
+        while (table[slot] != UINT32_MAX && std::memcmp(&vertices[table[slot]].pos, words, sizeof(words)) != 0) {
+          slot = (slot + 1) & mask;
+        }
+        if (table[slot] == UINT32_MAX) table[slot] = static_cast<uint32_t>(v);
+
+        remap[v] = table[slot];
+      }
+
+      return remap;
+    }
+
+  }  // namespace mesh
+
+}  // namespace vkl
+
+#endif  // ADJACENCY_HPP
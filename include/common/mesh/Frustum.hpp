@@ -0,0 +1,40 @@
+/**
+ * @file Frustum.hpp
+ * @brief Planes of a view frustum, to cull bounding boxes against it
+ */
+
+#ifndef FRUSTUM_HPP
+#define FRUSTUM_HPP
+
+#include <glm/glm.hpp>
+
+namespace vkl {
+
+  namespace mesh {
+
+    /**
+     * @brief Six planes (a, b, c, d) facing inside : a point p is in the frustum when dot(plane.xyz, p) + plane.w >= 0
+     * for each of them
+     */
+    struct Frustum {
+      glm::vec4 planes[6];
+    };
+
+    /**
+     * @brief The frustum of a projection * view (* model) matrix, in the space the matrix transforms from
+     *
+     * The near plane is that of a [-1, 1] depth range, which holds the [0, 1] one : culling stays conservative whichever
+     * the projection uses.
+     */
+    Frustum extractFrustum(const glm::mat4& viewProj);
+
+    /**
+     * @brief Whether a box may be seen : false only if it is wholly outside one of the planes
+     */
+    bool intersects(const Frustum& frustum, const glm::vec3& min, const glm::vec3& max);
+
+  }  // namespace mesh
+
+}  // namespace vkl
+
+#endif  // FRUSTUM_HPP
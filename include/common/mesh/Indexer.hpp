@@ -0,0 +1,33 @@
+/**
+ * @file Indexer.hpp
+ * @brief Build indexed geometry from a triangle soup
+ */
+
+#ifndef INDEXER_HPP
+#define INDEXER_HPP
+
+#include <common/struct/Vertex.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace vkl {
+
+  namespace mesh {
+
+    /**
+     * @brief Merge the identical vertices of a triangle list
+     * @param corners One vertex per triangle corner, as given by ObjLoader
+     * @param vertices Receive the unique vertices, in order of first use
+     * @param indices Receive one index per corner, so triangle order is kept
+     *
+     * Two vertices are merged only if they are bitwise equal.
+     */
+    void indexVertices(const std::vector<Vertex>& corners,
+                       std::vector<Vertex>& vertices,
+                       std::vector<uint32_t>& indices);
+
+  }  // namespace mesh
+
+}  // namespace vkl
+
+#endif  // INDEXER_HPP
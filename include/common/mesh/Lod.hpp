@@ -0,0 +1,78 @@
+/**
+ * @file Lod.hpp
+ * @brief Chain of simplified index buffers sharing one vertex buffer, and their selection by screen-space error
+ */
+
+#ifndef LOD_HPP
+#define LOD_HPP
+
+#include <common/mesh/MaterialRange.hpp>
+#include <common/mesh/MeshData.hpp>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace vkl {
+
+  namespace mesh {
+
+    /**
+     * @brief Fraction of the triangles of the full mesh kept by each level after the first one
+     */
+    inline const std::vector<float> DefaultLodRatios = {0.5f, 0.25f, 0.125f};
+
+    /**
+     * @brief Largest error of a level, relative to the radius of the mesh : past it the shape is lost
+     */
+    constexpr float LodMaxRelativeError = 0.05f;
+
+    struct LodLevel {
+      uint32_t firstIndex;
+      uint32_t indexCount;
+      float error;  // distance to the full mesh, in model units
+
+      // Its triangles grouped by material, LodChain::ranges [firstRange, firstRange + rangeCount)
+      uint32_t firstRange = 0;
+      uint32_t rangeCount = 0;
+    };
+
+    struct LodChain {
+      std::vector<uint32_t> indices;      // the levels one after the other, the first one is the full mesh
+      std::vector<int> materialIds;       // 1 per triangle of indices
+      std::vector<LodLevel> levels;       // from the finest to the coarsest
+      std::vector<MaterialRange> ranges;  // of every level, one after the other
+
+      // Bounding sphere of the mesh, the distance to the viewer is taken from it
+      glm::vec3 center;
+      float radius;
+    };
+
+    /**
+     * @brief Simplify the mesh to each ratio of its triangles, then group the triangles of each level by material
+     *
+     * The simplification stops at LodMaxRelativeError, the levels which couldn't be reduced are dropped.
+     */
+    LodChain buildLodChain(const MeshData& mesh, const std::vector<float>& ratios = DefaultLodRatios);
+
+    /**
+     * @brief Size in pixels of an error at a distance, for a perspective projection
+     * @param viewportHeight In pixels
+     * @param fovy Vertical field of view, in radians
+     */
+    float projectedError(float error, float distance, float viewportHeight, float fovy);
+
+    /**
+     * @brief The coarsest level whose error, seen from the viewer, stays under maxPixelError
+     * @return An index in chain.levels
+     */
+    size_t selectLod(const LodChain& chain,
+                     const glm::vec3& viewer,
+                     float viewportHeight,
+                     float fovy,
+                     float maxPixelError = 1.0f);
+
+  }  // namespace mesh
+
+}  // namespace vkl
+
+#endif  // LOD_HPP
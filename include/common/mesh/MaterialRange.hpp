@@ -0,0 +1,41 @@
+/**
+ * @file MaterialRange.hpp
+ * @brief Group the triangles of an index buffer by material, so each material is drawn by a single call
+ */
+
+#ifndef MATERIALRANGE_HPP
+#define MATERIALRANGE_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace vkl {
+
+  namespace mesh {
+
+    /**
+     * @brief Triangles of an index buffer which share a material
+     */
+    struct MaterialRange {
+      uint32_t firstIndex;
+      uint32_t indexCount;
+      int materialId;  // -1 when the triangles have no material
+    };
+
+    /**
+     * @brief Stable sort of the triangles [firstIndex, firstIndex + indexCount) by material, in increasing material
+     * order, and the range of each material
+     *
+     * The order of the triangles of a material is kept, so a range already grouped is left as is. Without one material
+     * id per triangle, the whole range is returned with the material -1.
+     */
+    std::vector<MaterialRange> sortByMaterial(std::vector<uint32_t>& indices,
+                                              std::vector<int>& materialIds,
+                                              uint32_t firstIndex,
+                                              uint32_t indexCount);
+
+  }  // namespace mesh
+
+}  // namespace vkl
+
+#endif  // MATERIALRANGE_HPP
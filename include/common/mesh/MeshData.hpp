@@ -0,0 +1,30 @@
+/**
+ * @file MeshData.hpp
+ * @brief Define MeshData struct
+ */
+
+#ifndef MESHDATA_HPP
+#define MESHDATA_HPP
+
+#include <common/struct/Material.hpp>
+#include <common/struct/Vertex.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vkl {
+
+  /**
+   * @brief CPU side of a Model, what is parsed from the source file (or read back from the cache)
+   */
+  struct MeshData {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;       // 3 per triangle
+    std::vector<int> materialIds;        // 1 per triangle, -1 when the face has no material
+    std::vector<Material> materials;
+    std::vector<std::string> textures;   // diffuse texture of each material, empty when it has none
+  };
+
+}  // namespace vkl
+
+#endif  // MESHDATA_HPP
@@ -0,0 +1,111 @@
+/**
+ * @file Meshlet.hpp
+ * @brief Split indexed geometry in small clusters of triangles, with the bounds needed to cull them
+ */
+
+#ifndef MESHLET_HPP
+#define MESHLET_HPP
+
+#include <common/mesh/MeshData.hpp>
+#include <common/struct/Vertex.hpp>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+namespace vkl {
+
+  namespace mesh {
+
+    /**
+     * @brief Default limits, the usual values for mesh shaders (124 triangles keep the local indices 4-byte aligned)
+     */
+    constexpr uint32_t DefaultMeshletVertices  = 64;
+    constexpr uint32_t DefaultMeshletTriangles = 124;
+
+    /**
+     * @brief A cluster of triangles, it references vertexCount entries of Meshlets::vertices and triangleCount triplets
+     * of Meshlets::triangles.
+     *
+     * Once the mesh has been reordered by splitMeshlets, the triangles of the meshlet are also the triangles
+     * [triangleOffset, triangleOffset + triangleCount) of the index buffer.
+     */
+    struct Meshlet {
+      uint32_t vertexOffset;
+      uint32_t triangleOffset;
+      uint32_t vertexCount;
+      uint32_t triangleCount;
+    };
+
+    /**
+     * @brief Culling data of a meshlet, laid out as two vec4 for a std430 buffer
+     *
+     * The meshlet is fully backfacing, seen from a camera at position p, when
+     * dot(center - p, coneAxis) >= coneCutoff * length(center - p) + radius.
+     * coneCutoff is 1 when the normals are too spread for the test to ever pass.
+     */
+    struct MeshletBounds {
+      glm::vec3 center;
+      float radius;
+      glm::vec3 coneAxis;
+      float coneCutoff;
+    };
+
+    struct Meshlets {
+      std::vector<Meshlet> meshlets;
+      std::vector<MeshletBounds> bounds;  // one per meshlet
+      std::vector<uint32_t> vertices;     // index in the mesh vertices
+      std::vector<uint8_t> triangles;     // 3 per triangle, index in the vertices of the meshlet
+    };
+
+    /**
+     * @brief Greedily grow meshlets from a seed triangle, adding first the neighbour triangles bringing the fewest new
+     * vertices, then the closest ones.
+     * @param triangleOrder If not null, receive for each triangle of the meshlets (in meshlet order) its source triangle
+     */
+    Meshlets buildMeshlets(const std::vector<uint32_t>& indices,
+                           const std::vector<Vertex>& vertices,
+                           uint32_t maxVertices                 = DefaultMeshletVertices,
+                           uint32_t maxTriangles                = DefaultMeshletTriangles,
+                           std::vector<uint32_t>* triangleOrder = nullptr);
+
+    /**
+     * @brief Build the meshlets of a mesh and reorder its triangles (and their materials) in meshlet order
+     *
+     * The triangles are grouped by material first (see sortByMaterial), a meshlet only holds triangles of one material.
+     * Inside a meshlet the triangles follow vertexCacheOrder, the order given by optimizeMesh is not kept.
+     */
+    Meshlets splitMeshlets(MeshData& mesh,
+                           uint32_t maxVertices  = DefaultMeshletVertices,
+                           uint32_t maxTriangles = DefaultMeshletTriangles);
+
+    /**
+     * @brief Bounding sphere and normal cone of a set of triangles
+     */
+    MeshletBounds computeBounds(const uint32_t* indices, size_t indexCount, const std::vector<Vertex>& vertices);
+
+    /**
+     * @brief Check the meshlets against the triangle list they have been built from
+     *
+     * Every meshlet must respect the limits and reference valid vertices, and the meshlets together must contain every
+     * triangle of indices exactly once (with its winding).
+     *
+     * @param error Receive the first problem found
+     */
+    bool validateMeshlets(const Meshlets& meshlets,
+                          const std::vector<uint32_t>& indices,
+                          size_t vertexCount,
+                          uint32_t maxVertices,
+                          uint32_t maxTriangles,
+                          std::string& error);
+
+    inline bool isBackfacing(const MeshletBounds& bounds, const glm::vec3& cameraPosition) {
+      const glm::vec3 direction = bounds.center - cameraPosition;
+      return glm::dot(direction, bounds.coneAxis) >= bounds.coneCutoff * glm::length(direction) + bounds.radius;
+    }
+
+  }  // namespace mesh
+
+}  // namespace vkl
+
+#endif  // MESHLET_HPP
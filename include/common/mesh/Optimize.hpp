@@ -0,0 +1,79 @@
+/**
+ * @file Optimize.hpp
+ * @brief Reorder indexed geometry for the post-transform vertex cache, overdraw and vertex fetch
+ */
+
+#ifndef OPTIMIZE_HPP
+#define OPTIMIZE_HPP
+
+#include <common/mesh/MeshData.hpp>
+#include <common/struct/Vertex.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace vkl {
+
+  namespace mesh {
+
+    /**
+     * @brief Size of the simulated post-transform cache (FIFO), a common value of the hardware
+     */
+    constexpr uint32_t DefaultCacheSize = 16;
+
+    struct VertexCacheStats {
+      float acmr = 0.0f;  // average cache miss ratio : transformed vertices per triangle, 0.5 at best, 3 at worst
+      float atvr = 0.0f;  // average transformed vertex ratio : transformed vertices per vertex, 1 at best
+    };
+
+    struct OptimizeStats {
+      VertexCacheStats before;
+      VertexCacheStats after;
+    };
+
+    /**
+     * @brief Simulate a FIFO post-transform cache on a triangle list
+     */
+    VertexCacheStats analyzeVertexCache(const std::vector<uint32_t>& indices,
+                                        size_t vertexCount,
+                                        uint32_t cacheSize = DefaultCacheSize);
+
+    /**
+     * @brief Tipsify (Sander et al. 2007) : fan around recently used vertices so they are still in the cache
+     * @return The new triangle order, as indices of triangles of the input
+     */
+    std::vector<uint32_t> vertexCacheOrder(const std::vector<uint32_t>& indices,
+                                           size_t vertexCount,
+                                           uint32_t cacheSize = DefaultCacheSize);
+
+    /**
+     * @brief View-independent overdraw reduction, to run on a list already ordered by vertexCacheOrder
+     *
+     * The list is cut in clusters where the cache would be flushed anyway, and where the cluster ACMR gets below
+     * threshold times the ACMR of the run. Clusters are then sorted so the ones facing away from the center of the mesh
+     * (the most likely to occlude the others) are drawn first.
+     *
+     * @return The new triangle order, as indices of triangles of the input
+     */
+    std::vector<uint32_t> overdrawOrder(const std::vector<uint32_t>& indices,
+                                        const std::vector<Vertex>& vertices,
+                                        uint32_t cacheSize = DefaultCacheSize,
+                                        float threshold    = 1.05f);
+
+    /**
+     * @brief Number the vertices in the order of their first use, so they are fetched sequentially
+     * @return For each vertex its new index, UINT32_MAX if it isn't referenced
+     */
+    std::vector<uint32_t> vertexFetchRemap(const std::vector<uint32_t>& indices, size_t vertexCount);
+
+    /**
+     * @brief Run the three passes on a mesh, triangles keep their material
+     *
+     * Unreferenced vertices are removed.
+     */
+    OptimizeStats optimizeMesh(MeshData& mesh, uint32_t cacheSize = DefaultCacheSize);
+
+  }  // namespace mesh
+
+}  // namespace vkl
+
+#endif  // OPTIMIZE_HPP
@@ -0,0 +1,42 @@
+/**
+ * @file Quantize.hpp
+ * @brief Conversion between Vertex and CompactVertex
+ */
+
+#ifndef QUANTIZE_HPP
+#define QUANTIZE_HPP
+
+#include <common/struct/CompactVertex.hpp>
+#include <common/struct/Vertex.hpp>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace vkl {
+
+  namespace mesh {
+
+    /**
+     * @brief Dequantization parameters mapping the bounding box of vertices to [0, 1]
+     */
+    Quantization computeQuantization(const std::vector<Vertex>& vertices);
+
+    CompactVertex compressVertex(const Vertex& vertex, const Quantization& quantization);
+
+    /**
+     * @brief Inverse of compressVertex, does what the compact vertex shaders do
+     */
+    Vertex decompressVertex(const CompactVertex& vertex, const Quantization& quantization);
+
+    std::vector<CompactVertex> compressVertices(const std::vector<Vertex>& vertices, const Quantization& quantization);
+
+    /**
+     * @brief Octahedral mapping of a unit vector on [-1, 1]^2, a null vector gives (0, 0)
+     */
+    glm::vec2 octEncode(const glm::vec3& normal);
+    glm::vec3 octDecode(const glm::vec2& encoded);
+
+  }  // namespace mesh
+
+}  // namespace vkl
+
+#endif  // QUANTIZE_HPP
@@ -0,0 +1,50 @@
+/**
+ * @file Simplify.hpp
+ * @brief Reduce the triangle count of indexed geometry with quadric error metrics
+ */
+
+#ifndef SIMPLIFY_HPP
+#define SIMPLIFY_HPP
+
+#include <common/struct/Vertex.hpp>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace vkl {
+
+  namespace mesh {
+
+    struct SimplifiedMesh {
+      std::vector<uint32_t> indices;  // 3 per triangle, in the vertices of the source mesh
+      std::vector<uint32_t> sources;  // for each triangle, the triangle of the source mesh it comes from
+      float error = 0.0f;             // distance to the source surface, in model units
+    };
+
+    /**
+     * @brief Collapse edges by increasing quadric error (Garland & Heckbert 1997) until each target is reached
+     *
+     * A vertex always collapses onto one of its neighbours, so the vertex buffer is shared by every result. Borders
+     * only slide along themselves, UV / normal seams and material boundaries along the seam, and collapses which would
+     * flip a triangle are refused. The simplification stops early when no collapse is possible under maxError.
+     *
+     * @param targetIndexCounts Decreasing index counts, one result each
+     * @param maxError Largest distance to the source surface (or to its borders), in model units
+     */
+    std::vector<SimplifiedMesh> simplifyLevels(const std::vector<uint32_t>& indices,
+                                               const std::vector<Vertex>& vertices,
+                                               const std::vector<int>& materialIds,
+                                               const std::vector<size_t>& targetIndexCounts,
+                                               float maxError = std::numeric_limits<float>::max());
+
+    std::vector<uint32_t> simplify(const std::vector<uint32_t>& indices,
+                                   const std::vector<Vertex>& vertices,
+                                   size_t targetIndexCount,
+                                   float maxError = std::numeric_limits<float>::max(),
+                                   float* error   = nullptr);
+
+  }  // namespace mesh
+
+}  // namespace vkl
+
+#endif  // SIMPLIFY_HPP
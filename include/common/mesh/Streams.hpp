@@ -0,0 +1,49 @@
+/**
+ * @file Streams.hpp
+ * @brief Split interleaved vertices in a position stream and an attribute stream
+ */
+
+#ifndef STREAMS_HPP
+#define STREAMS_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace vkl {
+
+  namespace mesh {
+
+    /**
+     * @brief Vertex data as uploaded : the positions alone, then the other attributes, both tightly packed
+     */
+    struct VertexStreams {
+      std::vector<uint8_t> positions;
+      std::vector<uint8_t> attributes;
+    };
+
+    /**
+     * @brief Split vertices of type T (Vertex or CompactVertex), whose first T::PositionSize bytes are the position
+     */
+    template <typename T> VertexStreams splitStreams(const std::vector<T>& vertices) {
+      constexpr size_t positionSize  = T::PositionSize;
+      constexpr size_t attributeSize = sizeof(T) - T::PositionSize;
+
+      VertexStreams streams;
+      streams.positions.resize(vertices.size() * positionSize);
+      streams.attributes.resize(vertices.size() * attributeSize);
+
+      for (size_t i = 0; i < vertices.size(); ++i) {
+        const uint8_t* vertex = reinterpret_cast<const uint8_t*>(&vertices[i]);
+        std::memcpy(&streams.positions[i * positionSize], vertex, positionSize);
+        std::memcpy(&streams.attributes[i * attributeSize], vertex + positionSize, attributeSize);
+      }
+
+      return streams;
+    }
+
+  }  // namespace mesh
+
+}  // namespace vkl
+
+#endif  // STREAMS_HPP
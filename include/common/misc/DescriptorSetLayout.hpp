@@ -35,6 +35,26 @@ namespace vkl {
       };
     }
 
+    /**
+     * @brief Flags of each binding, in the same order, chained to the create info through pNext
+     */
+    inline VkDescriptorSetLayoutBindingFlagsCreateInfo descriptorSetLayoutBindingFlagsCreateInfo(
+        const std::vector<VkDescriptorBindingFlags>& flags) {
+      return {
+          .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+          .bindingCount  = static_cast<uint32_t>(flags.size()),
+          .pBindingFlags = flags.data(),
+      };
+    }
+
+    inline VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo(
+        const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+        const VkDescriptorSetLayoutBindingFlagsCreateInfo& bindingFlags) {
+      VkDescriptorSetLayoutCreateInfo layoutInfo = descriptorSetLayoutCreateInfo(bindings);
+      layoutInfo.pNext                           = &bindingFlags;
+      return layoutInfo;
+    }
+
   }  // namespace misc
 
 }  // namespace vkl
@@ -41,7 +41,7 @@ namespace vkl {
       throw std::runtime_error("aucun type de memoire ne satisfait le buffer!");
     }
 
-    // Returns if a given format support LINEAR filtering
+    // Returns if a given format supports all the features
     inline VkBool32 formatIsFilterable(VkPhysicalDevice physicalDevice,
                                        VkFormat format,
                                        VkImageTiling tiling,
@@ -49,8 +49,8 @@ namespace vkl {
       VkFormatProperties formatProps;
       vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &formatProps);
 
-      if (tiling == VK_IMAGE_TILING_OPTIMAL) return formatProps.optimalTilingFeatures & features;
-      if (tiling == VK_IMAGE_TILING_LINEAR) return formatProps.linearTilingFeatures & features;
+      if (tiling == VK_IMAGE_TILING_OPTIMAL) return (formatProps.optimalTilingFeatures & features) == features;
+      if (tiling == VK_IMAGE_TILING_LINEAR) return (formatProps.linearTilingFeatures & features) == features;
 
       return false;
     }
@@ -29,6 +29,34 @@ namespace vkl {
       };
     }
 
+    /**
+     * @brief Describe the vertex input of T as two streams : the position alone (binding 0) then the other attributes
+     * (binding 1), as uploaded by VertexBuffer. With positionOnly, only the first stream is described.
+     *
+     * T must start by its position, of T::PositionSize bytes, and describe it at location 0.
+     */
+    template <typename T> void splitVertexInput(bool positionOnly,
+                                                std::vector<VkVertexInputBindingDescription>& bindingDescriptions,
+                                                std::vector<VkVertexInputAttributeDescription>& attributeDescriptions) {
+      bindingDescriptions = {
+          {.binding = 0, .stride = T::PositionSize, .inputRate = VK_VERTEX_INPUT_RATE_VERTEX},
+      };
+      if (!positionOnly) {
+        bindingDescriptions.push_back(
+            {.binding = 1, .stride = sizeof(T) - T::PositionSize, .inputRate = VK_VERTEX_INPUT_RATE_VERTEX});
+      }
+
+      attributeDescriptions.clear();
+      for (VkVertexInputAttributeDescription attribute : T::getAttributeDescriptions()) {
+        if (attribute.location != 0) {
+          if (positionOnly) continue;
+          attribute.binding = 1;
+          attribute.offset -= T::PositionSize;
+        }
+        attributeDescriptions.push_back(attribute);
+      }
+    }
+
   }  // namespace misc
 
 }  // namespace vkl
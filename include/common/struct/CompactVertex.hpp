@@ -0,0 +1,80 @@
+#ifndef COMPACTVERTEX_HPP
+#define COMPACTVERTEX_HPP
+
+#include <common/VulkanHeader.hpp>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace vkl {
+
+  /**
+   * @brief Vertex layout a Model is uploaded with
+   */
+  enum class VertexFormat {
+    Float,    // Vertex, 44 bytes
+    Compact,  // CompactVertex, 16 bytes
+  };
+
+  /**
+   * @brief Dequantization of CompactVertex::pos, given to the vertex shader as push constant
+   *
+   * position = offset + pos * scale, with pos in [0, 1]. The identity for a Float model.
+   */
+  struct Quantization {
+    glm::vec4 offset = glm::vec4(0.0f);
+    glm::vec4 scale  = glm::vec4(1.0f);
+  };
+
+  /**
+   * @brief A quantized Vertex : no color (always white), 16 bits per component
+   */
+  struct CompactVertex {
+    uint16_t pos[4];       // unorm, in the bounding box of the model (w is padding)
+    int16_t normal[2];     // snorm, octahedral encoding
+    uint16_t texCoord[2];  // half float
+
+    static constexpr uint32_t PositionSize = sizeof(pos);
+
+    static VkVertexInputBindingDescription getBindingDescription() {
+      VkVertexInputBindingDescription bindingDescription{};
+      bindingDescription.binding   = 0;
+      bindingDescription.stride    = sizeof(CompactVertex);
+      bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+      return bindingDescription;
+    }
+
+    static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions() {
+      // Les formats normalisés sont convertis en float par le GPU, le shader reçoit des vec4 / vec2
+      std::vector<VkVertexInputAttributeDescription> attributeDescriptions = {
+          // pos
+          {
+              .location = 0,
+              .binding  = 0,
+              .format   = VK_FORMAT_R16G16B16A16_UNORM,
+              .offset   = offsetof(CompactVertex, pos),
+          },
+          // normal
+          {
+              .location = 1,
+              .binding  = 0,
+              .format   = VK_FORMAT_R16G16_SNORM,
+              .offset   = offsetof(CompactVertex, normal),
+          },
+          // texCoord
+          {
+              .location = 2,
+              .binding  = 0,
+              .format   = VK_FORMAT_R16G16_SFLOAT,
+              .offset   = offsetof(CompactVertex, texCoord),
+          },
+      };
+
+      return attributeDescriptions;
+    }
+  };
+
+}  // namespace vkl
+
+#endif  // COMPACTVERTEX_HPP
@@ -1,6 +1,7 @@
 #ifndef MATERIAL_HPP
 #define MATERIAL_HPP
 
+#include <cstdint>
 #include <glm/glm.hpp>
 
 namespace vkl {
@@ -10,6 +11,7 @@ namespace vkl {
     alignas(16) glm::vec3 diffuse;
     alignas(16) glm::vec3 specular;
     alignas(4) float shininess;  // need to specify alignas(4)
+    alignas(4) uint32_t textureIndex;  // into the texture array of the model, set by Model
   };
 
 }  // namespace vkl
@@ -0,0 +1,21 @@
+#ifndef TEXTUREFEEDBACK_HPP
+#define TEXTUREFEEDBACK_HPP
+
+#include <cstdint>
+
+namespace vkl {
+
+  /**
+   * @brief What the fragment shader saw of a texture during a frame, reset before each frame
+   */
+  struct TextureFeedback {
+    static constexpr uint32_t LodScale = 16;  // minLod is fixed point
+    static constexpr uint32_t LodBias  = 16;  // and biased, the finer levels are below the first one of the view
+
+    uint32_t samples;  // fragments which sampled it, one out of 16
+    uint32_t minLod;   // finest level they asked for, relative to the first level of the view
+  };
+
+}  // namespace vkl
+
+#endif  // TEXTUREFEEDBACK_HPP
@@ -12,6 +12,9 @@ namespace vkl {
     glm::vec3 color;
     glm::vec2 texCoord;
 
+    // Taille du flux de positions, quand les positions sont séparées des autres attributs
+    static constexpr uint32_t PositionSize = sizeof(glm::vec3);
+
     // Renvoie l'instance de cette structure
     static VkVertexInputBindingDescription getBindingDescription() {
       // Un vertex binding décrit la lecture des données stockées en mémoire. Elle fournit le nombre
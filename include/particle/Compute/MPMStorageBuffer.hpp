@@ -36,9 +36,13 @@ namespace vkl {
                      VkMemoryPropertyFlags properties)
         : m_device(device),
           m_commandPool(commandPool),
-          ps(device, NUM_PARTICLE * sizeof(Particle), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | usage, properties),
-          grid(device, NUM_CELLS * sizeof(Cell), usage, properties),
-          fs(device, NUM_PARTICLE * sizeof(glm::mat2), usage, properties) {
+          ps(device,
+             NUM_PARTICLE * sizeof(Particle),
+             VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | usage,
+             properties,
+             MemoryCategory::Particles),
+          grid(device, NUM_CELLS * sizeof(Cell), usage, properties, MemoryCategory::Grid),
+          fs(device, NUM_PARTICLE * sizeof(glm::mat2), usage, properties, MemoryCategory::Particles) {
       createMPMStorageBuffer();
     }
 
@@ -20,6 +20,7 @@
 #include <common/buffer/Buffer.hpp>                      // for Buffer
 #include <common/buffer/StorageBuffer.hpp>               // for StorageBuffer
 #include <common/buffer/UniformBuffers.hpp>              // for UniformBuffers
+#include <common/buffer/UniformRing.hpp>                 // for UniformRing
 #include <common/struct/ComputeParticle.hpp>             // for ComputeParticle
 #include <common/struct/ParticleMVP.hpp>                 // for ParticleMVP
 #include <common/struct/Particle.hpp>                    // for Particle
@@ -66,6 +67,7 @@ namespace vkl {
     DescriptorPool dpCompute;
 
     // Buffers
+    UniformRing uniformRing;
     UniformBuffers<ParticleMVP> uniformBuffersGraphic;
     MPMStorageBuffer storageBuffer;
     UniformBuffers<ComputeParticle> uniformBuffersCompute;
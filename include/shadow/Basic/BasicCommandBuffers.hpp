@@ -3,6 +3,8 @@
 
 // clang-format off
 #include <common/CommandBuffers.hpp>  // for CommandBuffers
+#include <common/mesh/Lod.hpp>        // for LodLevel, MaterialRange
+#include <cstdint>                    // for uint32_t
 #include <vector>                     // for vector
 namespace vkl { class CommandPool; }
 namespace vkl { class DescriptorSets; }
@@ -23,12 +25,25 @@ namespace vkl {
                         const GraphicsPipeline& graphicsPipeline,
                         const CommandPool& commandPool,
                         const DescriptorSets& descriptorSets,
-                        const std::vector<const IBuffer*>& buffers)
-        : CommandBuffers(device, renderPass, swapChain, graphicsPipeline, commandPool, descriptorSets, buffers) {
+                        const std::vector<const IBuffer*>& buffers,
+                        const mesh::LodLevel& lod,
+                        const std::vector<mesh::MaterialRange>& ranges)
+        : CommandBuffers(device, renderPass, swapChain, graphicsPipeline, commandPool, descriptorSets, buffers),
+          m_lod(lod),
+          m_ranges(ranges) {
       createCommandBuffers();
     }
 
+    // Record again the command buffer of one image, when the ranges changed since
+    void recordCommandBuffers(uint32_t bufferIdx);
+
+    // Range of the index buffer drawn, taken into account at the next recreate() or recording
+    mesh::LodLevel& lod() { return m_lod; }
+
   private:
+    mesh::LodLevel m_lod;
+    const std::vector<mesh::MaterialRange>& m_ranges;  // of every level, m_lod points to its own
+
     void createCommandBuffers() final;
   };
 
@@ -26,7 +26,7 @@ namespace vkl {
                         const DescriptorPool& descriptorPool,
                         const std::vector<const IBuffer*>& buffers,
                         const std::vector<const IUniformBuffers*>& uniformBuffers,
-                        const std::vector<std::unique_ptr<Texture>>& textures,
+                        const std::vector<std::shared_ptr<Texture>>& textures,
                         const std::vector<std::unique_ptr<Attachment>>& attachments)
         : DescriptorSets(device,
                          swapChain,
@@ -39,11 +39,20 @@ namespace vkl {
       createDescriptorSets();
     }
 
+    /**
+     * @brief Write the texture array of the set of an image again, with the current views of the textures; the frame
+     * which last used the set must be done, and the command buffer which binds it recorded again
+     */
+    void writeTextures(uint32_t index);
+
   private:
-    const std::vector<std::unique_ptr<Texture>>& m_textures;
+    const std::vector<std::shared_ptr<Texture>>& m_textures;
     const std::vector<std::unique_ptr<Attachment>>& m_attachments;
 
     void createDescriptorSets() final;
+
+    // Indexed by Material::textureIndex
+    std::vector<VkDescriptorImageInfo> textureInfos() const;
   };
 }  // namespace vkl
 
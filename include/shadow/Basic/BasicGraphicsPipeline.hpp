@@ -3,6 +3,7 @@
 
 // clang-format off
 #include <common/GraphicsPipeline.hpp>  // for GraphicsPipeline
+#include <common/struct/CompactVertex.hpp>  // for VertexFormat
 namespace vkl { class DescriptorSetLayout; }
 namespace vkl { class Device; }
 namespace vkl { class RenderPass; }
@@ -16,10 +17,15 @@ namespace vkl {
     BasicGraphicsPipeline(const Device& device,
                           const SwapChain& swapChain,
                           const RenderPass& renderPass,
-                          const DescriptorSetLayout& descriptorSetLayout);
+                          const DescriptorSetLayout& descriptorSetLayout,
+                          VertexFormat vertexFormat = VertexFormat::Float,
+                          bool textureFeedback      = false);
     ~BasicGraphicsPipeline();
 
   private:
+    VertexFormat m_vertexFormat;
+    bool m_textureFeedback;  // the fragment shader writes how it samples the textures, see TextureFeedback
+
     void createPipeline() final;
   };
 }  // namespace vkl
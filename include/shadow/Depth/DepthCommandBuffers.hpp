@@ -5,6 +5,7 @@
 #include <stdint.h>                   // for uint32_t
 #include <cassert>                    // for assert
 #include <common/CommandBuffers.hpp>  // for CommandBuffers
+#include <common/mesh/Lod.hpp>        // for LodLevel, MaterialRange
 #include <iostream>                   // for operator<<, endl, basic_ostream
 #include <vector>                     // for vector
 namespace vkl { class CommandPool; }
@@ -26,8 +27,12 @@ namespace vkl {
                         const GraphicsPipeline& graphicsPipeline,
                         const CommandPool& commandPool,
                         const DescriptorSets& descriptorSets,
-                        const std::vector<const IBuffer*>& buffers)
-        : CommandBuffers(device, renderPass, swapChain, graphicsPipeline, commandPool, descriptorSets, buffers) {
+                        const std::vector<const IBuffer*>& buffers,
+                        const mesh::LodLevel& lod,
+                        const std::vector<mesh::MaterialRange>& ranges)
+        : CommandBuffers(device, renderPass, swapChain, graphicsPipeline, commandPool, descriptorSets, buffers),
+          m_lod(lod),
+          m_ranges(ranges) {
       createCommandBuffers();
     }
 
@@ -36,6 +41,9 @@ namespace vkl {
     float& depthBiasConstant() { return m_depthBiasConstant; }
     float& depthBiasSlope() { return m_depthBiasSlope; }
 
+    // Range of the index buffer drawn, taken into account at the next recording
+    mesh::LodLevel& lod() { return m_lod; }
+
   private:
     // Depth bias (and slope) are used to avoid shadowing artifacts
     // Constant depth bias factor (always applied)
@@ -43,6 +51,9 @@ namespace vkl {
     // Slope depth bias factor, applied depending on polygon's slope
     float m_depthBiasSlope = 1.75f;
 
+    mesh::LodLevel m_lod;
+    const std::vector<mesh::MaterialRange>& m_ranges;  // of every level, m_lod points to its own
+
     void createCommandBuffers() final;
   };
 
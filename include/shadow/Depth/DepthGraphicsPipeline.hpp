@@ -3,6 +3,7 @@
 
 // clang-format off
 #include <common/GraphicsPipeline.hpp>  // for GraphicsPipeline
+#include <common/struct/CompactVertex.hpp>  // for VertexFormat
 namespace vkl { class DescriptorSetLayout; }
 namespace vkl { class Device; }
 namespace vkl { class RenderPass; }
@@ -16,10 +17,13 @@ namespace vkl {
     DepthGraphicsPipeline(const Device& device,
                           const SwapChain& swapChain,
                           const RenderPass& renderPass,
-                          const DescriptorSetLayout& descriptorSetLayout);
+                          const DescriptorSetLayout& descriptorSetLayout,
+                          VertexFormat vertexFormat = VertexFormat::Float);
     ~DepthGraphicsPipeline();
 
   private:
+    VertexFormat m_vertexFormat;
+
     void createPipeline() final;
   };
 }  // namespace vkl
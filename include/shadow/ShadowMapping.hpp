@@ -17,11 +17,19 @@
 #include <common/DescriptorSetLayout.hpp>          // for DescriptorSetLayout
 #include <common/ImGui/ImGuiApp.hpp>               // for ImGuiApp
 #include <common/Model.hpp>                        // for Model
+#include <common/ModelLoader.hpp>                  // for ModelLoader
 #include <common/buffer/Buffer.hpp>                // for Buffer
+#include <common/buffer/FeedbackBuffers.hpp>       // for FeedbackBuffers
+#include <common/buffer/IndexBuffer.hpp>           // for IndexBuffer
+#include <common/buffer/MeshletBuffer.hpp>         // for MeshletBuffer
+#include <common/buffer/StagingRing.hpp>           // for StagingRing
+#include <common/buffer/VertexBuffer.hpp>          // for VertexBuffer
 #include <common/buffer/UniformBuffers.hpp>        // for UniformBuffers
+#include <common/buffer/UniformRing.hpp>           // for UniformRing
 #include <common/struct/Depth.hpp>                 // for Depth
 #include <common/struct/DepthMVP.hpp>              // for DepthMVP
 #include <cstdlib>                                 // for size_t
+#include <memory>                                  // for unique_ptr
 #include <shadow/Basic/BasicCommandBuffers.hpp>    // for BasicCommandBuffers
 #include <shadow/Basic/BasicDescriptorSets.hpp>    // for BasicDescriptorSets
 #include <shadow/Basic/BasicGraphicsPipeline.hpp>  // for BasicGraphicsPipeline
@@ -36,26 +44,53 @@
 #include <common/struct/Material.hpp>              // for Material
 #include <common/struct/Vertex.hpp>                // for Vertex
 #include <common/image/Texture.hpp>                      // for Texture
+#include <common/image/TextureCache.hpp>                 // for TextureCache
+#include <common/image/TextureStreamer.hpp>              // for TextureStreamer
 // clang-format on
 
 namespace vkl {
 
   class ShadowMapping : public Application {
   public:
-    ShadowMapping(const std::string& appName, const DebugOption& debugOption, const std::string& modelPath = "");
+    ShadowMapping(const std::string& appName,
+                  const DebugOption& debugOption,
+                  const std::string& modelPath   = "",
+                  const ModelOption& modelOption = {});
 
     void run() { mainLoop(); }
 
   private:
     // Note : Order is taken into account
 
+    // Every texture of the models, shared between the materials which use the same file
+    TextureCache textureCache;
+
+    // Started first, the model given to the constructor loads while the rest is created
+    std::unique_ptr<ModelLoader> modelLoader;
+
     CommandPool commandPool;
 
+    // Every upload to device local memory goes through it
+    StagingRing stagingRing;
+
+    // The placeholder until modelLoader is done
     Model model;
+    // The loaded model while its copies are on the device, drawn instead of the placeholder once they are done
+    std::unique_ptr<Model> uploadingModel;
+
+    // Brings the textures of the model from their tail to what the screen shows of them, with --stream-textures
+    TextureStreamer textureStreamer;
+
+    // Largest error allowed on screen, in pixels, when choosing the level of detail of each pass
+    float cameraLodError = 1.0f;
+    float shadowLodError = 2.0f;
+
+    // The constants of every frame, a slice of it for each UniformBuffers
+    UniformRing uniformRing;
 
-    Buffer<Vertex> vertexBuffer;
     UniformBuffers<DepthMVP> uniformBuffers;
-    Buffer<Material> materialUniformBuffer;
+    std::unique_ptr<Buffer<Material>> materialBuffer;
+    FeedbackBuffers feedbackBuffers;
     UniformBuffers<Depth> depthUniformBuffer;
 
     /**
@@ -79,6 +114,8 @@ namespace vkl {
      * Basic
      */
     BasicRenderPass rpBasic;
+    // Size of the texture array of the layout, a model can't have more textures
+    const uint32_t maxTextures;
     DescriptorSetLayout dslBasic;
     BasicGraphicsPipeline gpBasic;
 
@@ -91,14 +128,42 @@ namespace vkl {
 
     BasicDescriptorSets dsBasic;
     BasicCommandBuffers cbBasic;
+    // The TextureStreamer::generation of the views each set of dsBasic refers to
+    std::vector<uint64_t> textureGenerations;
 
     ImGuiApp interface;
 
+    bool firstFrame = true;
+
     void mainLoop();
 
     void drawFrame(bool& framebufferResized);
     void drawImGui();
 
+    size_t cameraLod() const;
+    size_t shadowLod() const;
+
+    /**
+     * @brief Submit the copies of the loaded model, which the frames don't draw until they are done
+     */
+    void uploadModel();
+
+    /**
+     * @brief Replace the placeholder by the uploaded model, and rebuild what refers to its buffers
+     */
+    void swapModel();
+
+    /**
+     * @brief Stream the levels of the textures from what the last frame rendered to the image saw of them, and write
+     * the views which changed to the set of the image
+     */
+    void streamTextures(uint32_t imageIndex);
+
+    /**
+     * @brief Out of core, make resident the clusters the camera and the light see, and draw them to the image
+     */
+    void streamClusters(uint32_t imageIndex);
+
     void recreateSwapChain(bool& framebufferResized) final;
   };
 
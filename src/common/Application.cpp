@@ -3,6 +3,9 @@
 #include <common/DebugUtilsMessenger.hpp>  // for vkl
 #include <common/Instance.hpp>             // for Instance, Instance::Device...
 #include <common/SwapChain.hpp>            // for SwapChain
+#include <common/memory/MemoryAllocator.hpp>  // for MemoryAllocator
+#include <fstream>                         // for ofstream
+#include <stdexcept>                       // for runtime_error
 #include <glm/glm.hpp>
 // clang-format on
 
@@ -13,7 +16,8 @@ Application::Application(
     android_app* androidApp,
 #endif
     const std::string& appName,
-    const DebugOption& debugOption)
+    const DebugOption& debugOption,
+    const DeviceRequirements& deviceRequirements)
     : instance(appName, ENGINE_NAME, (debugOption.debugLevel > 0)),
       debugMessenger(instance, debugOption.exitOnError),
       window(
@@ -23,9 +27,18 @@ Application::Application(
           {WIDTH, HEIGHT},
           appName,
           instance),
-      device(instance, window, Instance::DeviceExtensions),
+      device(instance, window, Instance::DeviceExtensions, deviceRequirements),
       swapChain(device, window),
-      syncObjects(device, swapChain.numImages(), MAX_FRAMES_IN_FLIGHT) {
+      syncObjects(device, swapChain.numImages(), MAX_FRAMES_IN_FLIGHT),
+      memoryStatsPath(debugOption.memoryStats) {
+}
+
+void Application::writeMemoryStats() const {
+  if (memoryStatsPath.empty()) return;
+
+  std::ofstream file(memoryStatsPath);
+  device.allocator().writeStats(file);
+  if (!file) throw std::runtime_error("failed to write the memory statistics!");
 }
 
 VkResult Application::prepareFrame(bool useFences, bool& framebufferResized, uint32_t& imageIndex) {
@@ -6,8 +6,10 @@
 #include <common/DescriptorSetLayout.hpp>  // for DescriptorSetLayout
 #include <common/Device.hpp>               // for Device
 #include <common/SwapChain.hpp>            // for SwapChain
+#include <common/buffer/IBuffer.hpp>       // for IUniformBuffers
 #include <common/misc/DescriptorSet.hpp>   // for descriptorSetAllocateInfo
 #include <stdexcept>                       // for runtime_error
+#include <vector>                          // for vector
 // clang-format on
 
 using namespace vkl;
@@ -27,15 +29,30 @@ DescriptorSets::DescriptorSets(const Device& device,
 
 void DescriptorSets::recreate() { createDescriptorSets(); }
 
-void DescriptorSets::allocateDescriptorSets() {
+std::vector<uint32_t> DescriptorSets::dynamicOffsets(int index) const {
+  std::vector<uint32_t> offsets;
+  for (const IUniformBuffers* uniformBuffers : m_uniformBuffers) {
+    if (uniformBuffers->dynamic()) offsets.push_back(uniformBuffers->dynamicOffset(index));
+  }
+
+  return offsets;
+}
+
+void DescriptorSets::allocateDescriptorSets(size_t count, uint32_t variableDescriptorCount) {
   /* Allocate */
-  const size_t size = m_swapChain.numImages();
+  const std::vector<VkDescriptorSetLayout> layouts(count, m_descriptorSetLayout.handle());
+  VkDescriptorSetAllocateInfo allocInfo
+      = misc::descriptorSetAllocateInfo(m_descriptorPool.handle(), layouts.data(), static_cast<uint32_t>(count));
 
-  const std::vector<VkDescriptorSetLayout> layouts(size, m_descriptorSetLayout.handle());
-  const VkDescriptorSetAllocateInfo allocInfo
-      = misc::descriptorSetAllocateInfo(m_descriptorPool.handle(), layouts.data(), static_cast<uint32_t>(size));
+  const std::vector<uint32_t> counts(count, variableDescriptorCount);
+  const VkDescriptorSetVariableDescriptorCountAllocateInfo countInfo = {
+      .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO,
+      .descriptorSetCount = static_cast<uint32_t>(count),
+      .pDescriptorCounts  = counts.data(),
+  };
+  if (variableDescriptorCount > 0) allocInfo.pNext = &countInfo;
 
-  m_descriptorSets.resize(size);
+  m_descriptorSets.resize(count);
   if (vkAllocateDescriptorSets(m_device.logical(), &allocInfo, m_descriptorSets.data()) != VK_SUCCESS) {
     throw std::runtime_error("echec de l'allocation d'un set de descripteurs!");
   }
@@ -4,6 +4,8 @@
 #include <common/QueueFamily.hpp>  // for QueueFamilyIndices, QueueFamily, vkl
 #include <common/SwapChain.hpp>    // for SwapChainSupportDetails, SwapChain
 #include <common/Window.hpp>       // for Window
+#include <common/image/SamplerCache.hpp>  // for SamplerCache
+#include <common/memory/MemoryAllocator.hpp>  // for MemoryAllocator
 #include <cstdint>                 // for uint32_t
 #include <iostream>                // for operator<<, basic_ostream, cout
 #include <optional>                // for optional
@@ -15,14 +17,17 @@
 
 using namespace vkl;
 
-Device::Device(const Instance& instance, const Window& window, const std::vector<const char*>& extensions)
+Device::Device(const Instance& instance,
+               const Window& window,
+               const std::vector<const char*>& extensions,
+               const DeviceRequirements& requirements)
     : m_physical(VK_NULL_HANDLE),
       m_logical(VK_NULL_HANDLE),
       m_instance(instance),
       m_window(window),
       m_graphicsQueue(VK_NULL_HANDLE),
       m_presentQueue(VK_NULL_HANDLE) {
-  m_physical = PickPhysicalDevice(m_instance.handle(), m_window.surface(), extensions);
+  m_physical = PickPhysicalDevice(m_instance, m_window.surface(), extensions, requirements);
   m_indices  = QueueFamily::FindQueueFamilies(m_physical, m_window.surface());
 
   // Setup queue families for device
@@ -41,17 +46,42 @@ Device::Device(const Instance& instance, const Window& window, const std::vector
     queueCreateInfos.push_back(createInfo);
   }
 
-  const VkPhysicalDeviceFeatures deviceFeatures = {};
+  // Block compressed textures are sampled as they are where supported, and transcoded on the CPU otherwise
+  VkPhysicalDeviceFeatures supportedFeatures;
+  vkGetPhysicalDeviceFeatures(m_physical, &supportedFeatures);
+  m_features                      = {};
+  m_features.textureCompressionBC = supportedFeatures.textureCompressionBC;
+  // The fragment shader writes back how it samples the textures, to stream their levels (checked by IsDeviceSuitable)
+  m_features.fragmentStoresAndAtomics = requirements.textureFeedback;
+  // Every texture of a model is in one array, indexed by the material (checked by IsDeviceSuitable)
+  m_features.shaderSampledImageArrayDynamicIndexing = requirements.textureArray;
+
+  m_descriptorIndexing = {
+      .sType                                    = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES,
+      .descriptorBindingPartiallyBound          = VK_TRUE,
+      .descriptorBindingVariableDescriptorCount = VK_TRUE,
+      .runtimeDescriptorArray                   = VK_TRUE,
+  };
+
+  vkGetPhysicalDeviceProperties(m_physical, &m_properties);
+
+  // The budget of the memory heaps is reported where the driver knows it, see MemoryAllocator::stats; it is queried
+  // with vkGetPhysicalDeviceMemoryProperties2, core in 1.1
+  std::vector<const char*> enabledExtensions = extensions;
+  m_memoryBudget = m_instance.apiVersion() >= VK_API_VERSION_1_1 && m_properties.apiVersion >= VK_API_VERSION_1_1
+                   && CheckDeviceExtensionSupport(m_physical, {VK_EXT_MEMORY_BUDGET_EXTENSION_NAME});
+  if (m_memoryBudget) enabledExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
 
   // Setup logical device
   VkDeviceCreateInfo createInfo = {
       .sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+      .pNext                   = requirements.textureArray ? &m_descriptorIndexing : nullptr,
       .queueCreateInfoCount    = static_cast<uint32_t>(queueCreateInfos.size()),
       .pQueueCreateInfos       = queueCreateInfos.data(),
       .enabledLayerCount       = 0,
-      .enabledExtensionCount   = static_cast<uint32_t>(extensions.size()),
-      .ppEnabledExtensionNames = extensions.data(),
-      .pEnabledFeatures        = &deviceFeatures,
+      .enabledExtensionCount   = static_cast<uint32_t>(enabledExtensions.size()),
+      .ppEnabledExtensionNames = enabledExtensions.data(),
+      .pEnabledFeatures        = &m_features,
       //.samplerAnisotropy       = VK_TRUE,
   };
 
@@ -69,9 +99,18 @@ Device::Device(const Instance& instance, const Window& window, const std::vector
   vkGetDeviceQueue(m_logical, m_indices.computeFamily.value(), 0, &m_computeQueue);
   vkGetDeviceQueue(m_logical, m_indices.transferFamily.value(), 0, &m_transferQueue);
   vkGetDeviceQueue(m_logical, m_indices.presentFamily.value(), 0, &m_presentQueue);
+
+  m_samplers  = std::make_unique<SamplerCache>(*this);
+  m_allocator = std::make_unique<MemoryAllocator>(*this);
 }
 
-Device::~Device() { vkDestroyDevice(m_logical, nullptr); }
+Device::~Device() {
+  // Every image, and so every sampler, has been destroyed by now
+  m_samplers.reset();
+  // As has every buffer, only the blocks kept for reuse are left
+  m_allocator.reset();
+  vkDestroyDevice(m_logical, nullptr);
+}
 
 bool Device::CheckDeviceExtensionSupport(const VkPhysicalDevice& device, const std::vector<const char*>& extensions) {
   // Get number of extension supported
@@ -94,12 +133,13 @@ bool Device::CheckDeviceExtensionSupport(const VkPhysicalDevice& device, const s
   return requiredExtensions.empty();
 }
 
-VkPhysicalDevice Device::PickPhysicalDevice(const VkInstance& instance,
+VkPhysicalDevice Device::PickPhysicalDevice(const Instance& instance,
                                             const VkSurfaceKHR& surface,
-                                            const std::vector<const char*>& requiredExtensions) {
+                                            const std::vector<const char*>& requiredExtensions,
+                                            const DeviceRequirements& requirements) {
   // Check for devices with vulkan support
   uint32_t deviceCount = 0;
-  vkEnumeratePhysicalDevices(instance, &deviceCount, nullptr);
+  vkEnumeratePhysicalDevices(instance.handle(), &deviceCount, nullptr);
 
   if (deviceCount == 0) {
     throw std::runtime_error("failed to find GPUs with Vulkan support!");
@@ -107,7 +147,7 @@ VkPhysicalDevice Device::PickPhysicalDevice(const VkInstance& instance,
 
   // Get available devices
   std::vector<VkPhysicalDevice> devices(deviceCount);
-  vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
+  vkEnumeratePhysicalDevices(instance.handle(), &deviceCount, devices.data());
 
   std::cout << "Device list:\n";
   for (const auto& device : devices) {
@@ -120,7 +160,7 @@ VkPhysicalDevice Device::PickPhysicalDevice(const VkInstance& instance,
 
   int indice = 0;
   for (const auto& device : devices) {
-    if (IsDeviceSuitable(device, surface)) {
+    if (IsDeviceSuitable(instance, device, surface, requirements)) {
       VkPhysicalDeviceProperties deviceProperties;
       vkGetPhysicalDeviceProperties(device, &deviceProperties);
       std::cout << "Pick: " << deviceProperties.deviceName << "\n\n";
@@ -132,7 +172,10 @@ VkPhysicalDevice Device::PickPhysicalDevice(const VkInstance& instance,
   throw std::runtime_error("failed to find a suitable GPU!");
 }
 
-bool Device::IsDeviceSuitable(const VkPhysicalDevice& device, const VkSurfaceKHR& surface) {
+bool Device::IsDeviceSuitable(const Instance& instance,
+                              const VkPhysicalDevice& device,
+                              const VkSurfaceKHR& surface,
+                              const DeviceRequirements& requirements) {
   QueueFamilyIndices indices = QueueFamily::FindQueueFamilies(device, surface);
 
   bool extensionsSupported = CheckDeviceExtensionSupport(device, Instance::DeviceExtensions);
@@ -146,5 +189,27 @@ bool Device::IsDeviceSuitable(const VkPhysicalDevice& device, const VkSurfaceKHR
   VkPhysicalDeviceFeatures supportedFeatures;
   vkGetPhysicalDeviceFeatures(device, &supportedFeatures);
 
-  return indices.isComplete() && extensionsSupported && swapChainAdequate && supportedFeatures.samplerAnisotropy;
+  return indices.isComplete() && extensionsSupported && swapChainAdequate && supportedFeatures.samplerAnisotropy
+         && (!requirements.textureFeedback || supportedFeatures.fragmentStoresAndAtomics)
+         && (!requirements.textureArray || SupportsTextureArray(instance, device));
+}
+
+bool Device::SupportsTextureArray(const Instance& instance, const VkPhysicalDevice& device) {
+  // Descriptor indexing is core in 1.2, for both the instance and the device
+  VkPhysicalDeviceProperties properties;
+  vkGetPhysicalDeviceProperties(device, &properties);
+  if (instance.apiVersion() < VK_API_VERSION_1_2 || properties.apiVersion < VK_API_VERSION_1_2) return false;
+
+  VkPhysicalDeviceDescriptorIndexingFeatures descriptorIndexing = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES,
+  };
+  VkPhysicalDeviceFeatures2 features = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+      .pNext = &descriptorIndexing,
+  };
+  vkGetPhysicalDeviceFeatures2(device, &features);
+
+  return features.features.shaderSampledImageArrayDynamicIndexing && descriptorIndexing.runtimeDescriptorArray
+         && descriptorIndexing.descriptorBindingPartiallyBound
+         && descriptorIndexing.descriptorBindingVariableDescriptorCount;
 }
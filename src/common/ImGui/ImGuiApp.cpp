@@ -12,6 +12,7 @@
 #include <common/QueueFamily.hpp>                // for QueueFamilyIndices
 #include <common/SwapChain.hpp>                  // for SwapChain
 #include <common/Window.hpp>                     // for Window
+#include <common/memory/MemoryAllocator.hpp>     // for MemoryAllocator
 #include <optional>                              // for optional
 #include <stdexcept>                             // for runtime_error
 #include <vector>                                // for vector
@@ -106,3 +107,26 @@ void ImGuiApp::createImGuiDescriptorPool() {
     throw std::runtime_error("Cannot allocate UI descriptor pool!");
   }
 }
+
+void ImGuiApp::drawMemoryStats() const {
+  const auto kib = [](VkDeviceSize bytes) { return static_cast<size_t>(bytes / 1024); };
+
+  const std::vector<MemoryAllocator::HeapStats> heaps = m_device.allocator().stats();
+  for (size_t i = 0; i < heaps.size(); i++) {
+    const MemoryAllocator::HeapStats& heap = heaps[i];
+    if (heap.peakReserved == 0) continue;
+
+    ImGui::Text("heap %zu (%s, %zu MiB)", i, heap.deviceLocal ? "device" : "host", kib(heap.size) / 1024);
+    ImGui::Text("used: %zu KiB, peak %zu KiB", kib(heap.used), kib(heap.peakUsed));
+    ImGui::Text("reserved: %zu KiB in %zu blocks, peak %zu KiB", kib(heap.reserved), heap.blocks,
+                kib(heap.peakReserved));
+    if (heap.budget > 0) ImGui::Text("budget: %zu / %zu MiB", kib(heap.usage) / 1024, kib(heap.budget) / 1024);
+
+    for (size_t c = 0; c < MemoryCategoryCount; c++) {
+      const MemoryCategoryStats& category = heap.categories[c];
+      if (category.peak == 0) continue;
+      ImGui::BulletText("%s: %zu KiB, peak %zu KiB", MemoryCategoryName(static_cast<MemoryCategory>(c)),
+                        kib(category.used), kib(category.peak));
+    }
+  }
+}
@@ -3,6 +3,7 @@
 #include <stdint.h>                        // for uint32_t
 #include <common/DebugUtilsMessenger.hpp>  // for DebugUtilsMessenger
 #include <common/Window.hpp>               // for Window
+#include <algorithm>                       // for min
 #include <cstring>                         // for strcmp
 #include <stdexcept>                       // for runtime_error
 // clang-format on
@@ -27,6 +28,14 @@ Instance::Instance(const std::string& appName, const std::string& engineName, bo
     throw std::runtime_error("validation layers requested, but not available!");
   }
 
+  // 1.2 for the descriptor indexing of the texture array, where the loader has it: a 1.0 loader rejects any other
+  // version, and has no vkEnumerateInstanceVersion
+  uint32_t loaderVersion = VK_API_VERSION_1_0;
+  const auto enumerateInstanceVersion =
+      reinterpret_cast<PFN_vkEnumerateInstanceVersion>(vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceVersion"));
+  if (enumerateInstanceVersion) enumerateInstanceVersion(&loaderVersion);
+  m_apiVersion = std::min(loaderVersion, static_cast<uint32_t>(VK_API_VERSION_1_2));
+
   // appInfo permet de décrire notre application
   const VkApplicationInfo appInfo = {
       .sType              = VK_STRUCTURE_TYPE_APPLICATION_INFO,
@@ -34,7 +43,7 @@ Instance::Instance(const std::string& appName, const std::string& engineName, bo
       .applicationVersion = VK_MAKE_VERSION(1, 0, 0),
       .pEngineName        = engineName.c_str(),
       .engineVersion      = VK_MAKE_VERSION(1, 0, 0),
-      .apiVersion         = VK_API_VERSION_1_0,
+      .apiVersion         = m_apiVersion,
   };
 
   // createInfo est utilisé pour informer Vulkan de nos informations d'application, des couches que
@@ -1,14 +1,25 @@
 // clang-format off
 #include <common/Model.hpp>
-
-#define TINYOBJLOADER_IMPLEMENTATION
-#include <tiny_obj_loader.h>           // for material_t, attrib_t, (anonymous)
-
-#include <iostream>                    // for endl, basic_ostream, cerr, ost...
-#include <stdexcept>                   // for runtime_error
-#include <common/struct/Material.hpp>  // for Material, vkl
-#include <common/struct/Vertex.hpp>    // for Vertex
-#include <glm/glm.hpp>
+#include <common/loader/ClusterFile.hpp>  // for ClusterFile
+#include <common/loader/MeshCache.hpp>  // for MeshCache
+#include <common/loader/ObjLoader.hpp>  // for ObjLoader, ObjData, ObjMaterial
+#include <common/mesh/Indexer.hpp>      // for indexVertices
+#include <common/mesh/Lod.hpp>          // for buildLodChain, LodLevel, MaterialRange
+#include <common/mesh/Meshlet.hpp>      // for splitMeshlets
+#include <common/mesh/Optimize.hpp>     // for optimizeMesh, analyzeVertexCache
+#include <common/mesh/Quantize.hpp>     // for computeQuantization, compressVertices
+#include <common/mesh/Streams.hpp>      // for splitStreams
+#include <common/buffer/StagingRing.hpp>  // for StagingRing
+#include <common/image/TextureCache.hpp>  // for TextureCache
+#include <common/ThreadPool.hpp>       // for ThreadPool
+#include <algorithm>                    // for find
+#include <exception>                    // for exception_ptr, current_exception
+#include <future>                       // for future
+#include <iostream>                     // for cout
+#include <stdexcept>                    // for runtime_error
+#include <utility>                      // for move
+#include <common/struct/Material.hpp>   // for Material, vkl
+#include <common/struct/Vertex.hpp>     // for Vertex
 // clang-format on
 
 using namespace vkl;
@@ -21,77 +32,238 @@ bool hasEnding(std::string const& fullString, std::string const& ending) {
   }
 }
 
-Model::Model(const Device& device, const CommandPool& commandPool, const std::string& modelPath) {
-  if (hasEnding(modelPath, ".obj")) {
-    tinyobj::attrib_t attrib;
-    std::vector<tinyobj::shape_t> shapes;
-    std::vector<tinyobj::material_t> materials;
-    std::string err;
-    bool ret = tinyobj::LoadObj(&attrib, &shapes, &materials, &err, modelPath.c_str());
+Model::Model(const std::string& modelPath, const ModelOption& option, const TextureCache* cache)
+    : Model(option.outOfCore ? MeshData{} : LoadMesh(modelPath, option),
+            option.outOfCore && hasEnding(modelPath, ".obj") ? ClusterFile::Open(modelPath, option.cacheDir) : nullptr,
+            option,
+            cache) {}
+
+Model::Model(MeshData mesh, const ModelOption& option, const TextureCache* cache)
+    : Model(std::move(mesh), nullptr, option, cache) {}
+
+Model::Model(MeshData mesh,
+             std::unique_ptr<ClusterFile> clusterFile,
+             const ModelOption& option,
+             const TextureCache* cache)
+    : m_mesh(std::move(mesh)),
+      m_vertexFormat(option.vertexFormat),
+      m_clusterFile(std::move(clusterFile)),
+      m_clusterBudget(option.clusterBudget) {
+  if (m_clusterFile) {
+    // Only the materials are read here, the clusters are copied as they come into view (see streamClusters)
+    m_mesh.materials = m_clusterFile->materials();
+    m_mesh.textures  = m_clusterFile->textures();
 
-    if (!err.empty()) {
-      std::cerr << err << std::endl;
+    m_lodChain.levels = {{.firstIndex = 0, .indexCount = 0, .error = 0.0f}};
+    m_lodChain.center = (m_clusterFile->min() + m_clusterFile->max()) * 0.5f;
+    m_lodChain.radius = glm::length(m_clusterFile->max() - m_clusterFile->min()) * 0.5f;
+
+    // The bounds of the file are those of every cluster
+    if (m_vertexFormat == VertexFormat::Compact) {
+      Vertex min{}, max{};
+      min.pos        = m_clusterFile->min();
+      max.pos        = m_clusterFile->max();
+      m_quantization = mesh::computeQuantization({min, max});
+    }
+  } else {
+    // Only the triangle order changes, the vertices (and the cache) stay the same
+    if (option.meshlets) {
+      m_meshlets = mesh::splitMeshlets(m_mesh, option.meshletVertices, option.meshletTriangles);
     }
 
-    if (!ret) {
-      throw std::runtime_error("failed to load : " + modelPath);
+    // The levels reuse the vertices of the full mesh, so only the index buffer grows
+    m_lodChain = mesh::buildLodChain(m_mesh, option.lod ? mesh::DefaultLodRatios : std::vector<float>{});
+    if (option.lod) {
+      std::cout << "LOD chain:";
+      for (const mesh::LodLevel& level : m_lodChain.levels) {
+        std::cout << " " << level.indexCount / 3 << " (" << level.error << ")";
+      }
+      std::cout << std::endl;
     }
 
-    if (shapes.size() == 0) {
-      throw std::runtime_error("err: # of shapes are zero.");
+    // The material grouping and the meshlets moved the triangles since optimizeMesh, measure the full level as uploaded
+    if (option.optimize && !m_lodChain.indices.empty()) {
+      const mesh::LodLevel& full = m_lodChain.levels.front();
+      const std::vector<uint32_t> indices(m_lodChain.indices.begin() + full.firstIndex,
+                                          m_lodChain.indices.begin() + full.firstIndex + full.indexCount);
+      const mesh::VertexCacheStats stats = mesh::analyzeVertexCache(indices, m_mesh.vertices.size());
+      std::cout << "Mesh optimization: ACMR " << stats.acmr << ", ATVR " << stats.atvr << " as drawn" << std::endl;
     }
 
-    bool hasNormals   = !attrib.normals.empty();
-    bool hasTexCoords = !attrib.texcoords.empty();
-
-    for (const auto& shape : shapes) {
-      for (const auto& index : shape.mesh.indices) {
-        Vertex vertex{};
-
-        vertex.pos = {
-            attrib.vertices[3 * index.vertex_index + 0],
-            attrib.vertices[3 * index.vertex_index + 1],
-            attrib.vertices[3 * index.vertex_index + 2],
-        };
-
-        if (hasNormals) {
-          vertex.normal = {
-              attrib.normals[3 * index.normal_index + 0],
-              attrib.normals[3 * index.normal_index + 1],
-              attrib.normals[3 * index.normal_index + 2],
-          };
-        }
-
-        vertex.color = {1.0f, 1.0f, 1.0f};
-
-        if (hasTexCoords) {
-          vertex.texCoord = {
-              attrib.texcoords[2 * index.texcoord_index + 0],
-              1.0f - attrib.texcoords[2 * index.texcoord_index + 1],
-          };
-        }
-
-        m_vertices.push_back(vertex);
-      }
+    if (m_vertexFormat == VertexFormat::Compact) {
+      m_quantization  = mesh::computeQuantization(m_mesh.vertices);
+      m_vertexStreams = mesh::splitStreams(mesh::compressVertices(m_mesh.vertices, m_quantization));
+    } else {
+      m_vertexStreams = mesh::splitStreams(m_mesh.vertices);
     }
+  }
 
-    for (const tinyobj::material_t& material : materials) {
-      Material m = {
-          {material.ambient[0], material.ambient[1], material.ambient[2]},
-          {material.diffuse[0], material.diffuse[1], material.diffuse[2]},
-          {material.specular[0], material.specular[1], material.specular[2]},
-          material.shininess,
-      };
+  // The faces without a (valid) material are drawn with a default one, appended after the others
+  const int defaultMaterial = static_cast<int>(m_mesh.materials.size());
+  bool useDefault           = m_mesh.materials.empty();
+  for (mesh::MaterialRange& range : m_lodChain.ranges) {
+    if (range.materialId < 0 || range.materialId >= defaultMaterial) {
+      range.materialId = defaultMaterial;
+      useDefault       = true;
+    }
+  }
+  if (m_clusterFile) {
+    for (const ClusterFile::Cluster& cluster : m_clusterFile->clusters()) {
+      useDefault = useDefault || cluster.materialId < 0 || cluster.materialId >= defaultMaterial;
+    }
+  }
 
-      m_materials.push_back(m);
+  if (useDefault) {
+    m_mesh.materials.push_back({
+        .ambient   = glm::vec3(0.1f),
+        .diffuse   = glm::vec3(1.0f),
+        .specular  = glm::vec3(0.5f),
+        .shininess = 32.0f,
+    });
+  }
 
-      if (material.diffuse_texname.length() > 0) {
-          m_textures.push_back(std::make_unique<Texture>(device, commandPool, material.diffuse_texname));
-      }
+  // Each file once, however many materials use it; the materials index the texture array of the fragment shader
+  const auto textureIndex = [this](const TextureCache::Key& key) {
+    const auto found = std::find(m_textureKeys.begin(), m_textureKeys.end(), key);
+    if (found != m_textureKeys.end()) return static_cast<uint32_t>(found - m_textureKeys.begin());
+    m_textureKeys.push_back(key);
+    return static_cast<uint32_t>(m_textureKeys.size() - 1);
+  };
+
+  for (size_t i = 0; i < m_mesh.materials.size(); i++) {
+    const bool textured = i < m_mesh.textures.size() && m_mesh.textures[i].length() > 0;
+    // The blank texture is transparent, the material keeps its colors
+    m_mesh.materials[i].textureIndex = textureIndex(
+        TextureCache::MakeKey(textured ? m_mesh.textures[i] : "assets/textures/blank.png"));
+  }
+
+  // Decoded here, all at once on the pool, into memory the upload copies from; those already on the device are skipped
+  if (cache) m_stagingHeap = std::make_unique<StagingHeap>(cache->device());
+
+  // Streamed textures upload their tail from the whole chain, built here rather than on the render thread
+  const bool mipChain = cache && cache->tailSize() > 0;
+
+  std::vector<std::future<Texture::Pixels>> decoding(m_textureKeys.size());
+  for (size_t i = 0; i < m_textureKeys.size(); i++) {
+    if (cache && cache->contains(m_textureKeys[i])) continue;
+    decoding[i] = ThreadPool::Shared().submit([key = m_textureKeys[i], heap = m_stagingHeap.get(), mipChain]() {
+      return heap ? Texture::Decode(key.path, key.format, *heap, mipChain)
+                  : Texture::Decode(key.path, key.format, mipChain);
+    });
+  }
+  // Every decode writes to the heap, none may still run once an exception frees it
+  std::exception_ptr error;
+  for (std::future<Texture::Pixels>& pixels : decoding) {
+    try {
+      m_images.push_back(pixels.valid() ? pixels.get() : Texture::Pixels{});
+    } catch (...) {
+      if (!error) error = std::current_exception();
     }
+  }
+  if (error) std::rethrow_exception(error);
+}
 
-    if (m_textures.size() == 0) {
-        m_textures.push_back(std::make_unique<Texture>(device, commandPool, "assets/textures/blank.png"));
+void Model::upload(const Device& device, StagingRing& staging, TextureCache& cache) {
+  if (m_clusterFile) {
+    m_clusterStreamer = std::make_unique<ClusterStreamer>(device, *m_clusterFile, m_vertexFormat, m_quantization,
+                                                          m_clusterBudget);
+  } else {
+    m_vertexBuffer = std::make_unique<VertexBuffer>(device, m_vertexStreams.positions, m_vertexStreams.attributes,
+                                                    m_vertexFormat, m_quantization, staging);
+    m_indexBuffer = std::make_unique<IndexBuffer>(device, m_lodChain.indices, staging);
+    if (!m_meshlets.meshlets.empty()) {
+      m_meshletBuffer = std::make_unique<MeshletBuffer>(device, m_meshlets, staging);
     }
   }
+
+  for (size_t i = 0; i < m_textureKeys.size(); i++) {
+    m_textures.push_back(cache.acquire(staging, m_textureKeys[i], m_images[i]));
+  }
+  // The frames go on while the device copies, the heap the textures are copied from stays until uploaded()
+  m_uploadSerial = staging.submitPending();
+
+  // The device has the geometry, only what the draws read stays: the levels, ranges and meshlet descriptors
+  m_mesh.vertices      = {};
+  m_mesh.indices       = {};
+  m_mesh.materialIds   = {};
+  m_vertexStreams      = {};
+  m_lodChain.indices   = {};
+  m_meshlets.vertices  = {};
+  m_meshlets.triangles = {};
+}
+
+bool Model::uploaded(StagingRing& staging) {
+  if (!staging.done(m_uploadSerial)) return false;
+
+  m_images.clear();
+  m_stagingHeap.reset();
+  return true;
+}
+
+void Model::streamClusters(StagingRing& staging,
+                           const std::vector<mesh::Frustum>& frusta,
+                           const glm::vec3& viewer,
+                           uint32_t framesInFlight) {
+  m_clusterStreamer->update(staging, frusta, viewer, framesInFlight, m_lodChain);
+
+  // As in the constructor, the default material is the one after those of the file
+  const int defaultMaterial = static_cast<int>(m_clusterFile->materials().size());
+  for (mesh::MaterialRange& range : m_lodChain.ranges) {
+    if (range.materialId < 0 || range.materialId >= defaultMaterial) range.materialId = defaultMaterial;
+  }
+}
+
+Model Model::Placeholder(const Device& device,
+                         StagingRing& staging,
+                         TextureCache& cache,
+                         const ModelOption& option) {
+  MeshData mesh;
+  mesh.vertices    = {Vertex{}};
+  mesh.indices     = {0, 0, 0};
+  mesh.materialIds = {-1};
+
+  ModelOption placeholderOption = option;
+  placeholderOption.lod         = false;
+
+  Model model(std::move(mesh), placeholderOption, &cache);
+  model.upload(device, staging, cache);
+  staging.flush();
+  model.uploaded(staging);
+
+  return model;
+}
+
+MeshData Model::LoadMesh(const std::string& modelPath, const ModelOption& option) {
+  MeshData data;
+
+  if (!hasEnding(modelPath, ".obj")) return data;
+
+  const std::string cachePath = MeshCache::Path(modelPath, option.cacheDir, option.optimize ? "opt" : "");
+  if (option.useCache && MeshCache::Read(cachePath, data)) return data;
+
+  ObjData obj = ObjLoader::Load(modelPath);
+
+  // Shared corners are stored once, and referenced through the index buffer
+  mesh::indexVertices(obj.vertices, data.vertices, data.indices);
+  data.materialIds = std::move(obj.materialIds);
+
+  if (option.optimize) {
+    // What gets drawn is measured once the constructor is done with the order, see Model()
+    const mesh::OptimizeStats stats = mesh::optimizeMesh(data);
+    std::cout << "Mesh optimization: ACMR " << stats.before.acmr << ", ATVR " << stats.before.atvr << " as parsed"
+              << std::endl;
+  }
+
+  for (const ObjMaterial& material : obj.materials) {
+    data.materials.push_back(material.material);
+    data.textures.push_back(material.diffuseTexname);
+  }
+
+  if (option.useCache) {
+    std::vector<std::string> sources = {modelPath};
+    sources.insert(sources.end(), obj.materialFiles.begin(), obj.materialFiles.end());
+    MeshCache::Write(cachePath, sources, data);
+  }
+
+  return data;
 }
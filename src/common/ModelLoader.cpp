@@ -0,0 +1,18 @@
+// clang-format off
+#include <common/ModelLoader.hpp>
+#include <chrono>                 // for seconds
+// clang-format on
+
+using namespace vkl;
+
+ModelLoader::ModelLoader(const std::string& modelPath, const TextureCache& cache, const ModelOption& option) {
+  // A thread of its own : the parser already spreads its work on ThreadPool::Shared, and waits on it
+  m_loading = std::async(std::launch::async,
+                         [modelPath, &cache, option]() { return Model(modelPath, option, &cache); });
+}
+
+bool ModelLoader::ready() const {
+  return m_loading.valid() && m_loading.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+Model ModelLoader::take() { return m_loading.get(); }
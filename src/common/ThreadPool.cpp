@@ -0,0 +1,49 @@
+#include <common/ThreadPool.hpp>
+
+using namespace vkl;
+
+ThreadPool::ThreadPool(size_t numThreads) {
+  // hardware_concurrency is allowed to return 0 when it can't be computed
+  if (numThreads == 0) numThreads = 1;
+
+  m_workers.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; ++i) {
+    m_workers.emplace_back(&ThreadPool::work, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_condition.notify_all();
+
+  for (std::thread& worker : m_workers) {
+    worker.join();
+  }
+}
+
+ThreadPool& ThreadPool::Shared() {
+  static ThreadPool pool;
+  return pool;
+}
+
+void ThreadPool::work() {
+  for (;;) {
+    std::function<void()> task;
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+
+      // Drain the queue before leaving, so no future is left without a value
+      if (m_stop && m_tasks.empty()) return;
+
+      task = std::move(m_tasks.front());
+      m_tasks.pop();
+    }
+
+    task();
+  }
+}
@@ -0,0 +1,156 @@
+// clang-format off
+#include <common/buffer/ClusterStreamer.hpp>
+#include <algorithm>                 // for sort, clamp, max
+#include <utility>                   // for pair
+#include <common/Device.hpp>         // for Device
+#include <common/mesh/Quantize.hpp>  // for compressVertices
+#include <common/mesh/Streams.hpp>   // for splitStreams, VertexStreams
+#include <common/struct/Vertex.hpp>  // for Vertex
+// clang-format on
+
+using namespace vkl;
+
+ClusterStreamer::ClusterStreamer(const Device& device,
+                                 const ClusterFile& file,
+                                 VertexFormat format,
+                                 const Quantization& quantization,
+                                 VkDeviceSize memoryBudget,
+                                 VkDeviceSize frameBudget)
+    : m_file(file),
+      m_format(format),
+      m_quantization(quantization),
+      m_frameBudget(frameBudget),
+      m_slotVertices(std::max(file.maxVertices(), 1u)),
+      m_slotIndices(std::max(file.maxIndices(), 3u)),
+      m_residence(file.clusters().size(), -1) {
+  const VkDeviceSize vertexSize = (format == VertexFormat::Compact) ? sizeof(CompactVertex) : sizeof(Vertex);
+  const VkDeviceSize slotSize   = m_slotVertices * vertexSize + m_slotIndices * sizeof(uint32_t);
+
+  // No more slots than clusters, however large the budget
+  const size_t slotCount = static_cast<size_t>(
+      std::clamp<VkDeviceSize>(memoryBudget / slotSize, 1, std::max<size_t>(file.clusters().size(), 1)));
+  m_slots.assign(slotCount, {-1, 0});
+
+  m_vertexBuffer = std::make_unique<VertexBuffer>(device, VkDeviceSize(slotCount) * m_slotVertices, format,
+                                                  quantization);
+  m_indexBuffer  = std::make_unique<IndexBuffer>(device, static_cast<uint32_t>(slotCount * m_slotIndices));
+}
+
+void ClusterStreamer::update(StagingRing& staging,
+                             const std::vector<mesh::Frustum>& frusta,
+                             const glm::vec3& viewer,
+                             uint32_t framesInFlight,
+                             mesh::LodChain& chain) {
+  m_frame++;
+
+  const std::vector<ClusterFile::Cluster>& clusters = m_file.clusters();
+
+  // The clusters seen, nearest first
+  std::vector<std::pair<float, uint32_t>> visible;
+  for (uint32_t c = 0; c < clusters.size(); c++) {
+    const ClusterFile::Cluster& cluster = clusters[c];
+
+    const bool seen = std::any_of(frusta.begin(), frusta.end(), [&cluster](const mesh::Frustum& frustum) {
+      return mesh::intersects(frustum, cluster.min, cluster.max);
+    });
+    if (!seen) continue;
+
+    const glm::vec3 offset = glm::min(glm::max(viewer, cluster.min), cluster.max) - viewer;
+    visible.push_back({glm::dot(offset, offset), c});
+  }
+  std::sort(visible.begin(), visible.end());
+
+  // Those already resident are kept first, then the missing ones take the slots left
+  for (const auto& [distance, c] : visible) {
+    if (m_residence[c] >= 0) m_slots[m_residence[c]].lastUsed = m_frame;
+  }
+
+  VkDeviceSize spent = 0;
+  for (const auto& [distance, c] : visible) {
+    if (spent >= m_frameBudget) break;
+    if (m_residence[c] >= 0) continue;
+
+    const int32_t slot = acquireSlot(framesInFlight);
+    if (slot < 0) break;
+
+    spent += load(staging, c, slot);
+    m_slots[slot].lastUsed = m_frame;
+  }
+  if (spent > 0) staging.flush();
+
+  // One range per cluster, in its slot
+  chain.indices.clear();
+  chain.materialIds.clear();
+  chain.ranges.clear();
+
+  uint32_t indexCount = 0;
+  for (const auto& [distance, c] : visible) {
+    if (m_residence[c] < 0) continue;
+
+    chain.ranges.push_back({
+        .firstIndex = static_cast<uint32_t>(m_residence[c]) * m_slotIndices,
+        .indexCount = clusters[c].indexCount,
+        .materialId = clusters[c].materialId,
+    });
+    indexCount += clusters[c].indexCount;
+  }
+
+  chain.levels = {{
+      .firstIndex = 0,
+      .indexCount = indexCount,
+      .error      = 0.0f,
+      .firstRange = 0,
+      .rangeCount = static_cast<uint32_t>(chain.ranges.size()),
+  }};
+
+  m_visible = visible.size();
+  m_drawn   = chain.ranges.size();
+}
+
+ClusterStreamer::Stats ClusterStreamer::stats() const {
+  return {m_visible, m_drawn, m_slots.size(), m_streamedBytes, m_evictions};
+}
+
+int32_t ClusterStreamer::acquireSlot(uint32_t framesInFlight) {
+  int32_t oldest = -1;
+
+  for (size_t s = 0; s < m_slots.size(); s++) {
+    const Slot& slot = m_slots[s];
+    if (slot.cluster < 0) return static_cast<int32_t>(s);
+
+    if (slot.lastUsed + framesInFlight < m_frame && (oldest < 0 || slot.lastUsed < m_slots[oldest].lastUsed)) {
+      oldest = static_cast<int32_t>(s);
+    }
+  }
+
+  return oldest;
+}
+
+VkDeviceSize ClusterStreamer::load(StagingRing& staging, uint32_t cluster, int32_t slot) {
+  const ClusterFile::Cluster& source = m_file.clusters()[cluster];
+
+  const Vertex* first = m_file.vertices(source);
+  const std::vector<Vertex> vertices(first, first + source.vertexCount);
+  const mesh::VertexStreams streams = (m_format == VertexFormat::Compact)
+                                          ? mesh::splitStreams(mesh::compressVertices(vertices, m_quantization))
+                                          : mesh::splitStreams(vertices);
+
+  const uint32_t firstVertex = static_cast<uint32_t>(slot) * m_slotVertices;
+  std::vector<uint32_t> indices(m_file.indices(source), m_file.indices(source) + source.indexCount);
+  for (uint32_t& index : indices) index += firstVertex;
+
+  m_vertexBuffer->copy(streams.positions, streams.attributes, firstVertex, staging);
+  m_indexBuffer->copy(indices, static_cast<uint32_t>(slot) * m_slotIndices, staging);
+
+  Slot& target = m_slots[slot];
+  if (target.cluster >= 0) {
+    m_residence[target.cluster] = -1;
+    m_evictions++;
+  }
+  target.cluster      = cluster;
+  m_residence[cluster] = slot;
+
+  const VkDeviceSize size = streams.positions.size() + streams.attributes.size() + sizeof(uint32_t) * indices.size();
+  m_streamedBytes += size;
+  return size;
+}
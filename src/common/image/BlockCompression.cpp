@@ -0,0 +1,519 @@
+// clang-format off
+#include <common/image/BlockCompression.hpp>
+#include <common/image/Mipmap.hpp>    // for mipSize, mipLevels, mipChainSize
+#include <common/io/MappedFile.hpp>   // for MappedFile
+#include <algorithm>                  // for min, max, swap
+#include <array>                      // for array
+#include <cctype>                     // for tolower
+#include <cstring>                    // for memcmp, memcpy
+#include <filesystem>                 // for path
+#include <stdexcept>                  // for runtime_error
+// clang-format on
+
+using namespace vkl;
+
+namespace {
+
+  constexpr uint8_t Ktx2Identifier[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+  constexpr size_t Ktx2HeaderSize      = 80;  // identifier, header and index, the level index follows
+
+  constexpr size_t DdsHeaderSize     = 4 + 124;  // magic and DDS_HEADER, a DDS_HEADER_DXT10 may follow
+  constexpr size_t DdsDx10HeaderSize = 20;
+  constexpr uint32_t DdsMipMapCount  = 0x20000;
+  constexpr uint32_t DdsPixelFourCC  = 0x4;
+  constexpr uint32_t DdsCubemap      = 0x200;
+  constexpr uint32_t DdsTexture2D    = 3;
+
+  constexpr uint32_t fourCC(char a, char b, char c, char d) {
+    return uint32_t(uint8_t(a)) | uint32_t(uint8_t(b)) << 8 | uint32_t(uint8_t(c)) << 16 | uint32_t(uint8_t(d)) << 24;
+  }
+
+  // Both containers are little endian, as the hosts we run on
+  template <typename T> T read(const uint8_t* data, size_t offset) {
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+  }
+
+  inline uint32_t blocks(uint32_t size) { return (size + 3) / 4; }
+
+  size_t levelSize(VkFormat format, uint32_t width, uint32_t height, uint32_t level) {
+    const size_t columns = blocks(image::mipSize(width, level)), rows = blocks(image::mipSize(height, level));
+    return columns * rows * image::blockBytes(format);
+  }
+
+  /* BC1 to BC3 */
+
+  void expand565(uint16_t color, uint8_t* rgba) {
+    const uint32_t r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+    rgba[0] = static_cast<uint8_t>(r << 3 | r >> 2);
+    rgba[1] = static_cast<uint8_t>(g << 2 | g >> 4);
+    rgba[2] = static_cast<uint8_t>(b << 3 | b >> 2);
+    rgba[3] = 255;
+  }
+
+  /**
+   * Two 5:6:5 endpoints and 2 bits indices. With c0 <= c1, BC1 has a 3 colors mode whose last index is black,
+   * transparent for the RGBA formats; the color block of BC3 always has 4 colors.
+   */
+  void decodeColors(const uint8_t* block, uint8_t* out, bool fourColors, bool transparentBlack) {
+    const uint16_t c0 = read<uint16_t>(block, 0), c1 = read<uint16_t>(block, 2);
+    uint8_t palette[4][4];
+    expand565(c0, palette[0]);
+    expand565(c1, palette[1]);
+
+    for (uint32_t c = 0; c < 3; c++) {
+      if (fourColors || c0 > c1) {
+        palette[2][c] = static_cast<uint8_t>((2 * palette[0][c] + palette[1][c]) / 3);
+        palette[3][c] = static_cast<uint8_t>((palette[0][c] + 2 * palette[1][c]) / 3);
+      } else {
+        palette[2][c] = static_cast<uint8_t>((palette[0][c] + palette[1][c]) / 2);
+        palette[3][c] = 0;
+      }
+    }
+    palette[2][3] = 255;
+    palette[3][3] = (fourColors || c0 > c1 || !transparentBlack) ? 255 : 0;
+
+    const uint32_t indices = read<uint32_t>(block, 4);
+    for (uint32_t i = 0; i < 16; i++) {
+      std::memcpy(out + i * 4, palette[(indices >> (2 * i)) & 3], 4);
+    }
+  }
+
+  // Two 8 bits endpoints and 3 bits indices, interpolated in 7 steps, or in 5 steps plus 0 and 255 when a0 <= a1
+  void decodeAlpha(const uint8_t* block, uint8_t* out) {
+    const uint32_t a0 = block[0], a1 = block[1];
+    uint8_t palette[8] = {static_cast<uint8_t>(a0), static_cast<uint8_t>(a1)};
+
+    if (a0 > a1) {
+      for (uint32_t i = 1; i < 7; i++) palette[i + 1] = static_cast<uint8_t>(((7 - i) * a0 + i * a1) / 7);
+    } else {
+      for (uint32_t i = 1; i < 5; i++) palette[i + 1] = static_cast<uint8_t>(((5 - i) * a0 + i * a1) / 5);
+      palette[6] = 0;
+      palette[7] = 255;
+    }
+
+    uint64_t indices = 0;
+    std::memcpy(&indices, block + 2, 6);
+    for (uint32_t i = 0; i < 16; i++) {
+      out[i * 4 + 3] = palette[(indices >> (3 * i)) & 7];
+    }
+  }
+
+  /* BC7 */
+
+  struct Bc7Mode {
+    uint8_t subsets;
+    uint8_t partitionBits;
+    uint8_t rotationBits;
+    uint8_t indexSelectionBits;
+    uint8_t colorBits;
+    uint8_t alphaBits;
+    uint8_t endpointPBits;  // one per endpoint
+    uint8_t sharedPBits;    // one per subset
+    uint8_t indexBits;
+    uint8_t index2Bits;
+  };
+
+  constexpr std::array<Bc7Mode, 8> Bc7Modes = {{
+      {3, 4, 0, 0, 4, 0, 1, 0, 3, 0},
+      {2, 6, 0, 0, 6, 0, 0, 1, 3, 0},
+      {3, 6, 0, 0, 5, 0, 0, 0, 2, 0},
+      {2, 6, 0, 0, 7, 0, 1, 0, 2, 0},
+      {1, 0, 2, 1, 5, 6, 0, 0, 2, 3},
+      {1, 0, 2, 0, 7, 8, 0, 0, 2, 2},
+      {1, 0, 0, 0, 7, 7, 1, 0, 4, 0},
+      {2, 6, 0, 0, 5, 5, 1, 0, 2, 0},
+  }};
+
+  // Bit i is the subset of the texel i
+  constexpr std::array<uint16_t, 64> Bc7Partitions2 = {
+      0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80, 0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8,
+      0xFF00, 0xFFF0, 0xF000, 0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE, 0x088C, 0x3110,
+      0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C, 0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696,
+      0xA55A, 0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660, 0x0272, 0x04E4, 0x4E40, 0x2720,
+      0xC936, 0x936C, 0x39C6, 0x639C, 0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+  };
+
+  // Texels 0 to 15 of each partition, from the lowest to the highest 2 bits
+  constexpr std::array<uint32_t, 64> Bc7Partitions3 = {
+      0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8, 0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+      0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090, 0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+      0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0, 0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+      0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400, 0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+      0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424, 0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+      0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0, 0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+      0xAA444444, 0x54A854A8, 0x95809580, 0x96969600, 0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+      0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000, 0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254,
+  };
+
+  // Texel whose index has an implicit high bit of 0, for the second subset of 2, and the second and third of 3
+  constexpr std::array<uint8_t, 64> Bc7Anchors2 = {
+      15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+      15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+      15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+       6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15,
+  };
+  constexpr std::array<uint8_t, 64> Bc7Anchors3Second = {
+       3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+       3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+       8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+       3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3,
+  };
+  constexpr std::array<uint8_t, 64> Bc7Anchors3Third = {
+      15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+      15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+      15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+      15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8,
+  };
+
+  constexpr uint8_t Bc7Weights2[4]  = {0, 21, 43, 64};
+  constexpr uint8_t Bc7Weights3[8]  = {0, 9, 18, 27, 37, 46, 55, 64};
+  constexpr uint8_t Bc7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+  struct BitReader {
+    const uint8_t* data;
+    uint32_t position;
+
+    uint32_t read(uint32_t count) {
+      uint32_t value = 0;
+      for (uint32_t i = 0; i < count; i++, position++) {
+        value |= uint32_t((data[position >> 3] >> (position & 7)) & 1) << i;
+      }
+      return value;
+    }
+  };
+
+  uint8_t interpolate(uint32_t e0, uint32_t e1, uint32_t index, uint32_t bits) {
+    const uint32_t weight = bits == 2 ? Bc7Weights2[index] : bits == 3 ? Bc7Weights3[index] : Bc7Weights4[index];
+    return static_cast<uint8_t>(((64 - weight) * e0 + weight * e1 + 32) >> 6);
+  }
+
+  // The mode is given by the lowest set bit of the block; a block without one is reserved, and decodes to zeros
+  void decodeBc7(const uint8_t* block, uint8_t* out) {
+    uint32_t mode = 0;
+    while (mode < 8 && !(block[0] & (1 << mode))) mode++;
+    if (mode == 8) {
+      std::memset(out, 0, 16 * 4);
+      return;
+    }
+
+    const Bc7Mode& m = Bc7Modes[mode];
+    BitReader bits   = {block, mode + 1};
+
+    const uint32_t partition      = bits.read(m.partitionBits);
+    const uint32_t rotation       = bits.read(m.rotationBits);
+    const uint32_t indexSelection = bits.read(m.indexSelectionBits);
+
+    // [subset][endpoint][channel]
+    uint32_t endpoints[3][2][4] = {};
+    for (uint32_t c = 0; c < 3; c++) {
+      for (uint32_t s = 0; s < m.subsets; s++) {
+        for (uint32_t e = 0; e < 2; e++) endpoints[s][e][c] = bits.read(m.colorBits);
+      }
+    }
+    for (uint32_t s = 0; s < m.subsets; s++) {
+      for (uint32_t e = 0; e < 2; e++) endpoints[s][e][3] = bits.read(m.alphaBits);
+    }
+
+    uint32_t pBits[3][2] = {};
+    for (uint32_t s = 0; s < m.subsets; s++) {
+      if (m.endpointPBits) {
+        pBits[s][0] = bits.read(1);
+        pBits[s][1] = bits.read(1);
+      } else if (m.sharedPBits) {
+        pBits[s][0] = pBits[s][1] = bits.read(1);
+      }
+    }
+
+    // Back to 8 bits : the p-bit below the stored bits, then the high bits repeated below
+    const uint32_t hasPBit = m.endpointPBits | m.sharedPBits;
+    for (uint32_t s = 0; s < m.subsets; s++) {
+      for (uint32_t e = 0; e < 2; e++) {
+        for (uint32_t c = 0; c < 4; c++) {
+          const uint32_t stored = c < 3 ? m.colorBits : m.alphaBits;
+          if (stored == 0) {
+            endpoints[s][e][c] = 255;
+            continue;
+          }
+          const uint32_t precision = stored + hasPBit;
+          uint32_t value           = (endpoints[s][e][c] << hasPBit | pBits[s][e]) << (8 - precision);
+          endpoints[s][e][c]       = value | value >> precision;
+        }
+      }
+    }
+
+    uint32_t subsets[16], indices[16], indices2[16] = {};
+    for (uint32_t i = 0; i < 16; i++) {
+      bool anchor = i == 0;
+      if (m.subsets == 2) {
+        subsets[i] = (Bc7Partitions2[partition] >> i) & 1;
+        anchor |= i == Bc7Anchors2[partition];
+      } else if (m.subsets == 3) {
+        subsets[i] = (Bc7Partitions3[partition] >> (2 * i)) & 3;
+        anchor |= i == Bc7Anchors3Second[partition] || i == Bc7Anchors3Third[partition];
+      } else {
+        subsets[i] = 0;
+      }
+      indices[i] = bits.read(m.indexBits - anchor);
+    }
+    for (uint32_t i = 0; m.index2Bits && i < 16; i++) {
+      indices2[i] = bits.read(m.index2Bits - (i == 0));
+    }
+
+    for (uint32_t i = 0; i < 16; i++) {
+      const uint32_t(&e)[2][4] = endpoints[subsets[i]];
+      uint8_t* texel           = out + i * 4;
+
+      // Modes 4 and 5 have a second set of indices, for the alpha unless the index selection swaps them
+      uint32_t colorIndex = indices[i], colorBits = m.indexBits, alphaIndex = indices[i], alphaBits = m.indexBits;
+      if (m.index2Bits) {
+        alphaIndex = indices2[i];
+        alphaBits  = m.index2Bits;
+        if (indexSelection) {
+          std::swap(colorIndex, alphaIndex);
+          std::swap(colorBits, alphaBits);
+        }
+      }
+
+      for (uint32_t c = 0; c < 3; c++) texel[c] = interpolate(e[0][c], e[1][c], colorIndex, colorBits);
+      texel[3] = interpolate(e[0][3], e[1][3], alphaIndex, alphaBits);
+
+      if (rotation) std::swap(texel[3], texel[rotation - 1]);
+    }
+  }
+
+  void decodeBlock(VkFormat format, const uint8_t* block, uint8_t* out) {
+    switch (format) {
+      case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+      case VK_FORMAT_BC1_RGB_SRGB_BLOCK: decodeColors(block, out, false, false); break;
+      case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+      case VK_FORMAT_BC1_RGBA_SRGB_BLOCK: decodeColors(block, out, false, true); break;
+      case VK_FORMAT_BC3_UNORM_BLOCK:
+      case VK_FORMAT_BC3_SRGB_BLOCK:
+        decodeColors(block + 8, out, true, false);
+        decodeAlpha(block, out);
+        break;
+      default: decodeBc7(block, out); break;
+    }
+  }
+
+  image::CompressedImage gather(const uint8_t* data, const image::CompressedLayout& layout) {
+    const size_t size            = image::blockChainSize(layout.format, layout.width, layout.height, layout.levels);
+    image::CompressedImage image = {
+        .format = layout.format,
+        .width  = layout.width,
+        .height = layout.height,
+        .levels = layout.levels,
+        .data   = std::vector<uint8_t>(size),
+    };
+    image::copyLevels(data, layout, image.data.data());
+    return image;
+  }
+
+}  // namespace
+
+uint32_t image::blockBytes(VkFormat format) {
+  switch (format) {
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+    case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGBA_SRGB_BLOCK: return 8;
+    case VK_FORMAT_BC3_UNORM_BLOCK:
+    case VK_FORMAT_BC3_SRGB_BLOCK:
+    case VK_FORMAT_BC7_UNORM_BLOCK:
+    case VK_FORMAT_BC7_SRGB_BLOCK: return 16;
+    default: return 0;
+  }
+}
+
+bool image::isSrgb(VkFormat format) {
+  switch (format) {
+    case VK_FORMAT_R8G8B8A8_SRGB:
+    case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+    case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+    case VK_FORMAT_BC3_SRGB_BLOCK:
+    case VK_FORMAT_BC7_SRGB_BLOCK: return true;
+    default: return false;
+  }
+}
+
+size_t image::blockChainSize(VkFormat format, uint32_t width, uint32_t height, uint32_t levels) {
+  size_t size = 0;
+  for (uint32_t level = 0; level < levels; level++) size += levelSize(format, width, height, level);
+  return size;
+}
+
+bool image::isCompressedFile(const std::string& filename) {
+  std::string extension = std::filesystem::path(filename).extension().string();
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+  return extension == ".ktx2" || extension == ".dds";
+}
+
+image::CompressedLayout image::layoutCompressed(const uint8_t* data, size_t size, bool srgb) {
+  if (size >= sizeof(Ktx2Identifier) && std::memcmp(data, Ktx2Identifier, sizeof(Ktx2Identifier)) == 0) {
+    return layoutKtx2(data, size);
+  }
+  if (size >= 4 && std::memcmp(data, "DDS ", 4) == 0) {
+    return layoutDds(data, size, srgb);
+  }
+
+  throw std::runtime_error("unknown compressed texture container!");
+}
+
+image::CompressedLayout image::layoutKtx2(const uint8_t* data, size_t size) {
+  if (size < Ktx2HeaderSize || std::memcmp(data, Ktx2Identifier, sizeof(Ktx2Identifier)) != 0) {
+    throw std::runtime_error("not a KTX2 file!");
+  }
+
+  CompressedLayout layout = {
+      .format  = static_cast<VkFormat>(read<uint32_t>(data, 12)),
+      .width   = read<uint32_t>(data, 20),
+      .height  = read<uint32_t>(data, 24),
+      .levels  = std::max(1u, read<uint32_t>(data, 40)),  // 0 asks for the mips to be generated
+      .offsets = {},
+  };
+  const uint32_t depth = read<uint32_t>(data, 28), layers = read<uint32_t>(data, 32), faces = read<uint32_t>(data, 36);
+
+  if (!isBlockCompressed(layout.format)) {
+    throw std::runtime_error("unsupported KTX2 format, expected BC1, BC3 or BC7!");
+  }
+  if (read<uint32_t>(data, 44) != 0) {
+    throw std::runtime_error("supercompressed KTX2 files are not supported!");
+  }
+  if (layout.width == 0 || layout.height == 0 || depth > 1 || layers > 1 || faces != 1
+      || layout.levels > mipLevels(layout.width, layout.height)) {
+    throw std::runtime_error("only 2D KTX2 textures are supported!");
+  }
+  if (Ktx2HeaderSize + size_t(layout.levels) * 24 > size) {
+    throw std::runtime_error("truncated KTX2 file!");
+  }
+
+  // The level index starts with the level 0, the data the other way around
+  for (uint32_t level = 0; level < layout.levels; level++) {
+    const uint64_t offset = read<uint64_t>(data, Ktx2HeaderSize + level * 24);
+    const uint64_t length = read<uint64_t>(data, Ktx2HeaderSize + level * 24 + 8);
+
+    if (length != levelSize(layout.format, layout.width, layout.height, level) || offset > size
+        || length > size - offset) {
+      throw std::runtime_error("truncated KTX2 file!");
+    }
+    layout.offsets.push_back(static_cast<size_t>(offset));
+  }
+
+  return layout;
+}
+
+image::CompressedLayout image::layoutDds(const uint8_t* data, size_t size, bool srgb) {
+  if (size < DdsHeaderSize || std::memcmp(data, "DDS ", 4) != 0) {
+    throw std::runtime_error("not a DDS file!");
+  }
+
+  const uint32_t flags = read<uint32_t>(data, 8), mipMapCount = read<uint32_t>(data, 28);
+  const uint32_t pixelFlags = read<uint32_t>(data, 80), code = read<uint32_t>(data, 84);
+  const uint32_t caps2 = read<uint32_t>(data, 112);
+
+  CompressedLayout layout = {
+      .format  = VK_FORMAT_UNDEFINED,
+      .width   = read<uint32_t>(data, 16),
+      .height  = read<uint32_t>(data, 12),
+      .levels  = (flags & DdsMipMapCount) ? std::max(1u, mipMapCount) : 1,
+      .offsets = {},
+  };
+  size_t offset = DdsHeaderSize;
+
+  if (pixelFlags & DdsPixelFourCC) {
+    if (code == fourCC('D', 'X', 'T', '1')) {
+      layout.format = srgb ? VK_FORMAT_BC1_RGBA_SRGB_BLOCK : VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+    } else if (code == fourCC('D', 'X', 'T', '5')) {
+      layout.format = srgb ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+    } else if (code == fourCC('D', 'X', '1', '0') && size >= DdsHeaderSize + DdsDx10HeaderSize) {
+      if (read<uint32_t>(data, offset + 4) != DdsTexture2D || read<uint32_t>(data, offset + 12) > 1) {
+        throw std::runtime_error("only 2D DDS textures are supported!");
+      }
+
+      // DXGI_FORMAT
+      switch (read<uint32_t>(data, offset)) {
+        case 71: layout.format = VK_FORMAT_BC1_RGBA_UNORM_BLOCK; break;
+        case 72: layout.format = VK_FORMAT_BC1_RGBA_SRGB_BLOCK; break;
+        case 77: layout.format = VK_FORMAT_BC3_UNORM_BLOCK; break;
+        case 78: layout.format = VK_FORMAT_BC3_SRGB_BLOCK; break;
+        case 98: layout.format = VK_FORMAT_BC7_UNORM_BLOCK; break;
+        case 99: layout.format = VK_FORMAT_BC7_SRGB_BLOCK; break;
+        default: break;
+      }
+      offset += DdsDx10HeaderSize;
+    }
+  }
+
+  if (layout.format == VK_FORMAT_UNDEFINED) {
+    throw std::runtime_error("unsupported DDS format, expected BC1, BC3 or BC7!");
+  }
+  if (layout.width == 0 || layout.height == 0 || (caps2 & DdsCubemap)
+      || layout.levels > mipLevels(layout.width, layout.height)) {
+    throw std::runtime_error("only 2D DDS textures are supported!");
+  }
+  if (blockChainSize(layout.format, layout.width, layout.height, layout.levels) > size - offset) {
+    throw std::runtime_error("truncated DDS file!");
+  }
+
+  // One after the other, from the level 0
+  for (uint32_t level = 0; level < layout.levels; level++) {
+    layout.offsets.push_back(offset);
+    offset += levelSize(layout.format, layout.width, layout.height, level);
+  }
+
+  return layout;
+}
+
+void image::copyLevels(const uint8_t* data, const CompressedLayout& layout, uint8_t* blocks) {
+  for (uint32_t level = 0; level < layout.levels; level++) {
+    const size_t size = levelSize(layout.format, layout.width, layout.height, level);
+    std::memcpy(blocks, data + layout.offsets[level], size);
+    blocks += size;
+  }
+}
+
+image::CompressedImage image::loadCompressed(const std::string& filename, bool srgb) {
+  const MappedFile file(filename);
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(file.data());
+
+  return gather(data, layoutCompressed(data, file.size(), srgb));
+}
+
+image::CompressedImage image::parseKtx2(const uint8_t* data, size_t size) {
+  return gather(data, layoutKtx2(data, size));
+}
+
+image::CompressedImage image::parseDds(const uint8_t* data, size_t size, bool srgb) {
+  return gather(data, layoutDds(data, size, srgb));
+}
+
+std::vector<uint8_t> image::decompress(VkFormat format, uint32_t width, uint32_t height, uint32_t levels,
+                                      const uint8_t* blocks) {
+  std::vector<uint8_t> pixels(mipChainSize(width, height, levels));
+  const uint32_t bytes = blockBytes(format);
+
+  uint8_t* out = pixels.data();
+  for (uint32_t level = 0; level < levels; level++) {
+    const uint32_t levelWidth = mipSize(width, level), levelHeight = mipSize(height, level);
+
+    for (uint32_t by = 0; by < (levelHeight + 3) / 4; by++) {
+      for (uint32_t bx = 0; bx < (levelWidth + 3) / 4; bx++, blocks += bytes) {
+        uint8_t texels[16 * 4];
+        decodeBlock(format, blocks, texels);
+
+        // The blocks on the right and bottom edges overhang the sizes which aren't a multiple of 4
+        const uint32_t columns = std::min(4u, levelWidth - bx * 4);
+        for (uint32_t y = 0; y < 4 && by * 4 + y < levelHeight; y++) {
+          std::memcpy(out + (size_t(by * 4 + y) * levelWidth + bx * 4) * 4, texels + y * 16, columns * 4);
+        }
+      }
+    }
+    out += size_t(levelWidth) * levelHeight * 4;
+  }
+
+  return pixels;
+}
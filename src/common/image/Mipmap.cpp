@@ -0,0 +1,95 @@
+// clang-format off
+#include <common/image/Mipmap.hpp>
+#include <array>                      // for array
+#include <bit>                        // for bit_width
+#include <cmath>                      // for pow
+// clang-format on
+
+using namespace vkl;
+
+namespace {
+
+  constexpr uint32_t EncodeSteps = 4096;
+
+  const std::array<float, 256>& srgbToLinear() {
+    static const std::array<float, 256> table = []() {
+      std::array<float, 256> values;
+      for (uint32_t i = 0; i < 256; i++) {
+        const float c = i / 255.0f;
+        values[i]     = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+      }
+      return values;
+    }();
+    return table;
+  }
+
+  // Indexed by the linear value scaled to [0, EncodeSteps)
+  const std::array<uint8_t, EncodeSteps>& linearToSrgb() {
+    static const std::array<uint8_t, EncodeSteps> table = []() {
+      std::array<uint8_t, EncodeSteps> values;
+      for (uint32_t i = 0; i < EncodeSteps; i++) {
+        const float c = i / float(EncodeSteps - 1);
+        const float s = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+        values[i]     = static_cast<uint8_t>(s * 255.0f + 0.5f);
+      }
+      return values;
+    }();
+    return table;
+  }
+
+  void downsample(const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight, uint8_t* dst, bool srgb) {
+    const uint32_t width = image::mipSize(srcWidth, 1), height = image::mipSize(srcHeight, 1);
+    const std::array<float, 256>& toLinear        = srgbToLinear();
+    const std::array<uint8_t, EncodeSteps>& toSrgb = linearToSrgb();
+
+    for (uint32_t y = 0; y < height; y++) {
+      const uint8_t* row0 = src + size_t(std::min(2 * y, srcHeight - 1)) * srcWidth * 4;
+      const uint8_t* row1 = src + size_t(std::min(2 * y + 1, srcHeight - 1)) * srcWidth * 4;
+      uint8_t* out        = dst + size_t(y) * width * 4;
+
+      for (uint32_t x = 0; x < width; x++) {
+        const uint32_t x0 = std::min(2 * x, srcWidth - 1) * 4, x1 = std::min(2 * x + 1, srcWidth - 1) * 4;
+
+        for (uint32_t c = 0; c < 4; c++) {
+          if (srgb && c < 3) {
+            const float mean = (toLinear[row0[x0 + c]] + toLinear[row0[x1 + c]] + toLinear[row1[x0 + c]]
+                                + toLinear[row1[x1 + c]])
+                               * 0.25f;
+            out[x * 4 + c] = toSrgb[static_cast<uint32_t>(mean * (EncodeSteps - 1) + 0.5f)];
+          } else {
+            out[x * 4 + c] = static_cast<uint8_t>((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) / 4);
+          }
+        }
+      }
+    }
+  }
+
+}  // namespace
+
+uint32_t image::mipLevels(uint32_t width, uint32_t height) {
+  return static_cast<uint32_t>(std::bit_width(std::max({width, height, 1u})));
+}
+
+size_t image::mipChainSize(uint32_t width, uint32_t height, uint32_t levels) {
+  size_t size = 0;
+  for (uint32_t level = 0; level < levels; level++) {
+    size += size_t(mipSize(width, level)) * mipSize(height, level) * 4;
+  }
+  return size;
+}
+
+void image::buildMipChain(std::vector<uint8_t>& pixels, uint32_t width, uint32_t height, uint32_t levels, bool srgb) {
+  pixels.resize(mipChainSize(width, height, levels));
+  buildMipChain(pixels.data(), width, height, levels, srgb);
+}
+
+void image::buildMipChain(uint8_t* pixels, uint32_t width, uint32_t height, uint32_t levels, bool srgb) {
+  size_t offset = 0;
+  for (uint32_t level = 1; level < levels; level++) {
+    const uint32_t srcWidth = mipSize(width, level - 1), srcHeight = mipSize(height, level - 1);
+    const size_t next       = offset + size_t(srcWidth) * srcHeight * 4;
+
+    downsample(pixels + offset, srcWidth, srcHeight, pixels + next, srgb);
+    offset = next;
+  }
+}
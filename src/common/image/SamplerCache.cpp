@@ -0,0 +1,107 @@
+// clang-format off
+#include <common/image/SamplerCache.hpp>
+#include <common/Device.hpp>  // for Device
+#include <functional>         // for hash
+#include <stdexcept>          // for runtime_error
+// clang-format on
+
+using namespace vkl;
+
+namespace {
+
+  template <typename T> void combine(size_t& seed, const T& value) {
+    seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+
+}  // namespace
+
+size_t SamplerCache::Hash::operator()(const Key& key) const {
+  size_t seed = 0;
+  combine(seed, key.flags);
+  combine(seed, key.magFilter);
+  combine(seed, key.minFilter);
+  combine(seed, key.mipmapMode);
+  combine(seed, key.addressModeU);
+  combine(seed, key.addressModeV);
+  combine(seed, key.addressModeW);
+  combine(seed, key.mipLodBias);
+  combine(seed, key.anisotropyEnable);
+  combine(seed, key.maxAnisotropy);
+  combine(seed, key.compareEnable);
+  combine(seed, key.compareOp);
+  combine(seed, key.minLod);
+  combine(seed, key.maxLod);
+  combine(seed, key.borderColor);
+  combine(seed, key.unnormalizedCoordinates);
+  return seed;
+}
+
+SamplerCache::Key SamplerCache::MakeKey(const VkSamplerCreateInfo& info) {
+  // An extension structure could change the sampler in a way the key doesn't see
+  if (info.pNext != nullptr) {
+    throw std::runtime_error("sampler cache can't share samplers with a pNext chain!");
+  }
+
+  return {
+      .flags                   = info.flags,
+      .magFilter               = info.magFilter,
+      .minFilter               = info.minFilter,
+      .mipmapMode              = info.mipmapMode,
+      .addressModeU            = info.addressModeU,
+      .addressModeV            = info.addressModeV,
+      .addressModeW            = info.addressModeW,
+      .mipLodBias              = info.mipLodBias,
+      .anisotropyEnable        = info.anisotropyEnable,
+      .maxAnisotropy           = info.maxAnisotropy,
+      .compareEnable           = info.compareEnable,
+      .compareOp               = info.compareOp,
+      .minLod                  = info.minLod,
+      .maxLod                  = info.maxLod,
+      .borderColor             = info.borderColor,
+      .unnormalizedCoordinates = info.unnormalizedCoordinates,
+  };
+}
+
+SamplerCache::Handle SamplerCache::acquire(const VkSamplerCreateInfo& info) {
+  const Key key = MakeKey(info);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  // An expired entry is one whose last handle is being released, it waits for the lock to erase it
+  const auto found = m_samplers.find(key);
+  if (found != m_samplers.end()) {
+    if (Handle sampler = found->second.lock()) {
+      m_hits++;
+      return sampler;
+    }
+  }
+
+  VkSampler sampler;
+  if (vkCreateSampler(m_device.logical(), &info, nullptr, &sampler) != VK_SUCCESS) {
+    throw std::runtime_error("failed to create sampler!");
+  }
+
+  const Handle handle(new VkSampler(sampler), [this, key](const VkSampler* released) { release(key, released); });
+  m_samplers[key] = handle;
+  m_misses++;
+  m_live++;
+
+  return handle;
+}
+
+SamplerCache::Stats SamplerCache::stats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return {m_hits, m_misses, m_live};
+}
+
+void SamplerCache::release(const Key& key, const VkSampler* sampler) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  vkDestroySampler(m_device.logical(), *sampler, nullptr);
+  delete sampler;
+  m_live--;
+
+  // Unless a new sampler took its place in the meantime
+  const auto found = m_samplers.find(key);
+  if (found != m_samplers.end() && found->second.expired()) m_samplers.erase(found);
+}
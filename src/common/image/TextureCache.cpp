@@ -0,0 +1,30 @@
+// clang-format off
+#include <common/image/TextureCache.hpp>
+#include <filesystem>                 // for weakly_canonical
+#include <memory>                     // for make_shared
+#include <system_error>               // for error_code
+// clang-format on
+
+using namespace vkl;
+
+TextureCache::Key TextureCache::MakeKey(const std::string& path, VkFormat format) {
+  std::error_code error;
+  const std::filesystem::path canonical = std::filesystem::weakly_canonical(path, error);
+
+  return {error ? path : canonical.string(), format};
+}
+
+std::shared_ptr<Texture> TextureCache::acquire(StagingRing& staging, const Key& key, const Texture::Pixels& pixels) {
+  return m_textures.acquire(key, [&] {
+    const Texture::Pixels decoded = pixels.empty() ? Texture::Decode(key.path, key.format, m_tailSize > 0)
+                                                   : Texture::Pixels{};
+    const Texture::Pixels& source = pixels.empty() ? decoded : pixels;
+
+    return std::make_shared<Texture>(m_device, staging, source, key.format, m_tailSize);
+  });
+}
+
+TextureCache::Stats TextureCache::stats() const {
+  const SharedCache<Key, Texture>::Stats stats = m_textures.stats();
+  return {stats.hits, stats.misses, stats.entries, stats.residentBytes};
+}
@@ -0,0 +1,130 @@
+// clang-format off
+#include <common/image/TextureStreamer.hpp>
+#include <common/ThreadPool.hpp>  // for ThreadPool
+#include <algorithm>              // for clamp
+#include <chrono>                 // for seconds
+#include <cstdint>                // for int64_t
+// clang-format on
+
+using namespace vkl;
+
+void TextureStreamer::track(const std::vector<std::shared_ptr<Texture>>& textures,
+                            const std::vector<TextureCache::Key>& keys) {
+  for (Entry& entry : m_entries) entry.texture->releaseRetired();
+  m_entries.clear();
+  m_retiring.clear();
+
+  for (size_t i = 0; i < textures.size() && i < keys.size(); i++) {
+    if (textures[i]->tailLevel() == 0) continue;
+
+    m_entries.push_back({
+        .texture    = textures[i],
+        .key        = keys[i],
+        .wanted     = textures[i]->residentLevel(),
+        .idleFrames = 0,
+        .decoding   = {},
+        .pixels     = {},
+    });
+  }
+}
+
+void TextureStreamer::feedback(const Texture& texture, const TextureFeedback& feedback) {
+  if (feedback.samples == 0) return;
+
+  for (Entry& entry : m_entries) {
+    if (entry.texture.get() != &texture) continue;
+
+    // The level asked for is relative to the first level of the view, which is the resident one
+    const int64_t level = int64_t(texture.residentLevel()) + feedback.minLod / TextureFeedback::LodScale
+                          - TextureFeedback::LodBias;
+    entry.wanted        = static_cast<uint32_t>(std::clamp<int64_t>(level, 0, texture.mipLevels() - 1));
+    entry.idleFrames    = 0;
+  }
+}
+
+bool TextureStreamer::update(StagingRing& staging) {
+  const uint64_t generation = m_generation + 1;
+  bool changed              = false;
+  VkDeviceSize spent        = 0;
+
+  for (Entry& entry : m_entries) {
+    Texture& texture = *entry.texture;
+
+    if (entry.idleFrames >= m_evictFrames) {
+      if (texture.residentLevel() < texture.tailLevel()) {
+        texture.evict(staging, texture.tailLevel(), generation);
+        m_evictions++;
+        changed = true;
+      }
+      entry.wanted = texture.tailLevel();
+    } else if (entry.wanted < texture.residentLevel() && spent < m_frameBudget) {
+      const Texture::Pixels* pixels = decoded(entry);
+
+      if (pixels) {
+        // The next level at least, then as many as the budget leaves room for
+        uint32_t level    = texture.residentLevel() - 1;
+        VkDeviceSize size = texture.levelSize(level);
+        while (level > entry.wanted && spent + size + texture.levelSize(level - 1) <= m_frameBudget) {
+          size += texture.levelSize(--level);
+        }
+
+        texture.stream(staging, *pixels, level, generation);
+        spent += size;
+        m_streamedBytes += size;
+        m_promotions++;
+        changed = true;
+      }
+    }
+
+    // Nothing more to copy, the host copy of the levels goes
+    if (entry.wanted >= texture.residentLevel()) {
+      entry.pixels = {};
+      if (entry.decoding.valid() && entry.decoding.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        entry.decoding.get();
+      }
+    }
+
+    entry.idleFrames++;
+  }
+
+  if (!changed) return false;
+
+  // The frames sample the new views after the copies, which are submitted to their queue first
+  m_generation = generation;
+  m_retiring.push_back({generation, staging.submitPending()});
+  return true;
+}
+
+void TextureStreamer::releaseRetired(StagingRing& staging, uint64_t generation) {
+  uint64_t released = 0;
+  while (!m_retiring.empty() && m_retiring.front().generation <= generation
+         && staging.done(m_retiring.front().serial)) {
+    released = m_retiring.front().generation;
+    m_retiring.pop_front();
+  }
+  if (released == 0) return;
+
+  for (Entry& entry : m_entries) entry.texture->releaseRetired(released);
+}
+
+TextureStreamer::Stats TextureStreamer::stats() const {
+  size_t decoding = 0;
+  for (const Entry& entry : m_entries) decoding += entry.decoding.valid() ? 1 : 0;
+
+  return {m_streamedBytes, m_promotions, m_evictions, decoding};
+}
+
+const Texture::Pixels* TextureStreamer::decoded(Entry& entry) {
+  if (!entry.pixels.empty()) return &entry.pixels;
+
+  if (!entry.decoding.valid()) {
+    entry.decoding = ThreadPool::Shared().submit([key = entry.key]() {
+      return Texture::Decode(key.path, key.format, true);
+    });
+  }
+
+  if (entry.decoding.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return nullptr;
+
+  entry.pixels = entry.decoding.get();
+  return &entry.pixels;
+}
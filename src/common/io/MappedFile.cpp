@@ -0,0 +1,97 @@
+// clang-format off
+#include <common/io/MappedFile.hpp>
+#include <stdexcept>                 // for runtime_error
+
+#ifdef _WIN32
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>                 // for open, O_RDONLY
+#  include <sys/mman.h>              // for mmap, munmap, madvise
+#  include <sys/stat.h>              // for fstat
+#  include <unistd.h>                // for close
+#endif
+// clang-format on
+
+using namespace vkl;
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path) {
+  m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                       FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (m_file == INVALID_HANDLE_VALUE) {
+    m_file = nullptr;
+    throw std::runtime_error("failed to open : " + path);
+  }
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(m_file, &fileSize)) {
+    CloseHandle(m_file);
+    throw std::runtime_error("failed to get the size of : " + path);
+  }
+
+  m_size = static_cast<size_t>(fileSize.QuadPart);
+
+  // A zero-length file can't be mapped, data() stays null
+  if (m_size == 0) return;
+
+  m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (m_mapping == nullptr) {
+    CloseHandle(m_file);
+    throw std::runtime_error("failed to map : " + path);
+  }
+
+  m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+  if (m_data == nullptr) {
+    CloseHandle(m_mapping);
+    CloseHandle(m_file);
+    throw std::runtime_error("failed to map : " + path);
+  }
+}
+
+MappedFile::~MappedFile() {
+  if (m_data != nullptr) UnmapViewOfFile(m_data);
+  if (m_mapping != nullptr) CloseHandle(m_mapping);
+  if (m_file != nullptr) CloseHandle(m_file);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) {
+  m_fd = open(path.c_str(), O_RDONLY);
+  if (m_fd < 0) {
+    throw std::runtime_error("failed to open : " + path);
+  }
+
+  struct stat st;
+  if (fstat(m_fd, &st) != 0) {
+    close(m_fd);
+    throw std::runtime_error("failed to get the size of : " + path);
+  }
+
+  m_size = static_cast<size_t>(st.st_size);
+
+  // A zero-length file can't be mapped, data() stays null
+  if (m_size == 0) return;
+
+  void* addr = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+  if (addr == MAP_FAILED) {
+    close(m_fd);
+    throw std::runtime_error("failed to map : " + path);
+  }
+
+  // The file is read front to back by the parsers, let the kernel read ahead
+  madvise(addr, m_size, MADV_SEQUENTIAL);
+
+  m_data = static_cast<const char*>(addr);
+}
+
+MappedFile::~MappedFile() {
+  if (m_data != nullptr) munmap(const_cast<char*>(m_data), m_size);
+  if (m_fd >= 0) close(m_fd);
+}
+
+#endif
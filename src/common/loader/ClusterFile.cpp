@@ -0,0 +1,595 @@
+// clang-format off
+#include <common/loader/ClusterFile.hpp>
+#include <algorithm>                    // for sort, min, max, clamp, upper_bound
+#include <cfloat>                       // for FLT_MAX
+#include <cmath>                        // for cbrt, ceil
+#include <cstring>                      // for memcpy, memcmp
+#include <filesystem>                   // for path, file_size, last_write_time
+#include <fstream>                      // for ifstream, ofstream
+#include <iostream>                     // for cout, cerr, endl
+#include <stdexcept>                    // for runtime_error
+#include <system_error>                 // for error_code
+#include <unordered_map>                // for unordered_map
+#include <utility>                      // for pair
+#include <common/loader/MeshCache.hpp>  // for MeshCache
+#include <common/loader/ObjLoader.hpp>  // for ObjLoader, ObjChunk, ObjCorner, ObjData
+// clang-format on
+
+using namespace vkl;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+  constexpr char kMagic[8]    = {'V', 'K', 'C', 'L', 'U', 'S', 'T', '\0'};
+  constexpr size_t kAlignment = 16;
+
+  // Cells of the grid along each axis, at most
+  constexpr uint32_t kMaxGridSize = 64;
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t vertexSize;  // catch a change of Vertex / Material / Cluster without a version bump
+    uint32_t materialSize;
+    uint32_t clusterSize;
+    uint32_t sourceCount;
+    uint32_t materialCount;
+    uint32_t maxVertices;
+    uint32_t maxIndices;
+    uint64_t triangleCount;
+    uint64_t clusterCount;
+    uint64_t vertexCount;
+    uint64_t indexCount;
+    uint64_t clusterOffset;  // in bytes from the start of the file
+    uint64_t vertexOffset;
+    uint64_t indexOffset;
+    float min[3];
+    float max[3];
+  };
+
+  struct Stamp {
+    int64_t mtime;
+    uint64_t size;
+  };
+
+  // A triangle as parsed, before it goes to a cluster
+  struct Triangle {
+    ObjCorner corners[3];
+    int materialId;
+  };
+
+  struct CornerHash {
+    size_t operator()(const ObjCorner& corner) const {
+      uint64_t h = static_cast<uint32_t>(corner.v);
+      h          = (h ^ static_cast<uint32_t>(corner.vt)) * 0xff51afd7ed558ccdull;
+      h          = (h ^ static_cast<uint32_t>(corner.vn)) * 0xc4ceb9fe1a85ec53ull;
+      return static_cast<size_t>(h ^ (h >> 32));
+    }
+  };
+
+  int64_t modificationTime(const std::string& path, std::error_code& ec) {
+    return static_cast<int64_t>(fs::last_write_time(path, ec).time_since_epoch().count());
+  }
+
+  inline uint64_t aligned(uint64_t offset) { return (offset + kAlignment - 1) / kAlignment * kAlignment; }
+
+  // What a build writes next to the cluster file, removed however the build ends
+  struct TempFiles {
+    std::string positions, normals, texcoords, triangles, cells, vertices, indices;
+
+    explicit TempFiles(const std::string& base)
+        : positions(base + ".positions.tmp"),
+          normals(base + ".normals.tmp"),
+          texcoords(base + ".texcoords.tmp"),
+          triangles(base + ".triangles.tmp"),
+          cells(base + ".cells.tmp"),
+          vertices(base + ".vertices.tmp"),
+          indices(base + ".indices.tmp") {}
+
+    ~TempFiles() {
+      std::error_code ec;
+      for (const std::string* path : {&positions, &normals, &texcoords, &triangles, &cells, &vertices, &indices}) {
+        fs::remove(*path, ec);
+      }
+    }
+  };
+
+  template <typename T> void writeArray(std::ofstream& out, const T* data, size_t count) {
+    out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+  }
+
+  void writeString(std::ofstream& out, const std::string& value) {
+    const uint32_t length = static_cast<uint32_t>(value.size());
+    writeArray(out, &length, 1);
+    out.write(value.data(), length);
+  }
+
+  void pad(std::ofstream& out) {
+    static const char zeros[kAlignment] = {};
+    const uint64_t offset               = static_cast<uint64_t>(out.tellp());
+    out.write(zeros, static_cast<std::streamsize>(aligned(offset) - offset));
+  }
+
+  void append(std::ofstream& out, const std::string& path) {
+    std::error_code ec;
+    if (fs::file_size(path, ec) == 0 || ec) return;
+
+    std::ifstream in(path, std::ios::binary);
+    out << in.rdbuf();
+  }
+
+  // Interleave the bits of 3 coordinates of 10 bits
+  uint32_t morton(uint32_t x, uint32_t y, uint32_t z) {
+    const auto spread = [](uint32_t v) {
+      v = (v | (v << 16)) & 0x030000FF;
+      v = (v | (v << 8)) & 0x0300F00F;
+      v = (v | (v << 4)) & 0x030C30C3;
+      v = (v | (v << 2)) & 0x09249249;
+      return v;
+    };
+    return spread(x) | (spread(y) << 1) | (spread(z) << 2);
+  }
+
+  /**
+   * Cut runs of nearby triangles in clusters, and write them as they are made
+   */
+  class ClusterWriter {
+  public:
+    std::vector<ClusterFile::Cluster> clusters;
+    uint64_t vertexCount = 0;
+    uint64_t indexCount  = 0;
+    uint32_t maxVertices = 0;
+    uint32_t maxIndices  = 0;
+
+    ClusterWriter(const TempFiles& tmp,
+                  uint32_t maxTriangles,
+                  const float* positions,
+                  const float* normals,
+                  const float* texcoords)
+        : m_vertexFile(tmp.vertices, std::ios::binary | std::ios::trunc),
+          m_indexFile(tmp.indices, std::ios::binary | std::ios::trunc),
+          m_maxTriangles(std::max(maxTriangles, 1u)),
+          m_maxVertices(std::max(maxTriangles, 3u)),
+          m_positions(positions),
+          m_normals(normals),
+          m_texcoords(texcoords) {}
+
+    /**
+     * @brief Triangles of a cell, grouped by material then along a Morton curve, so each cluster stays compact
+     */
+    void write(const Triangle* triangles, const uint64_t* ids, size_t count) {
+      glm::vec3 min(FLT_MAX), max(-FLT_MAX);
+      for (size_t i = 0; i < count; ++i) {
+        const glm::vec3 c = centroid(triangles[ids[i]]);
+        min               = glm::min(min, c);
+        max               = glm::max(max, c);
+      }
+      const glm::vec3 extent = max - min;
+
+      std::vector<std::pair<uint64_t, uint64_t>> keys(count);
+      for (size_t i = 0; i < count; ++i) {
+        const Triangle& triangle = triangles[ids[i]];
+        const glm::vec3 c        = centroid(triangle);
+
+        uint32_t q[3];
+        for (int a = 0; a < 3; ++a) {
+          q[a] = extent[a] > 0.0f ? static_cast<uint32_t>((c[a] - min[a]) / extent[a] * 1023.0f) : 0;
+        }
+        const uint64_t material = static_cast<uint32_t>(triangle.materialId + 1);
+        keys[i]                 = {(material << 32) | morton(q[0], q[1], q[2]), ids[i]};
+      }
+      std::sort(keys.begin(), keys.end());
+
+      for (const auto& [key, id] : keys) {
+        const Triangle& triangle = triangles[id];
+
+        if (!m_indices.empty()
+            && (triangle.materialId != m_material || m_indices.size() / 3 == m_maxTriangles
+                || m_vertices.size() + 3 > m_maxVertices)) {
+          close();
+        }
+        m_material = triangle.materialId;
+
+        for (const ObjCorner& corner : triangle.corners) {
+          const auto [it, inserted] = m_corners.try_emplace(corner, static_cast<uint32_t>(m_vertices.size()));
+          if (inserted) m_vertices.push_back(vertex(corner));
+          m_indices.push_back(it->second);
+        }
+      }
+
+      close();
+    }
+
+    void finish() {
+      m_vertexFile.close();
+      m_indexFile.close();
+      if (!m_vertexFile || !m_indexFile) throw std::runtime_error("failed to write the clusters!");
+    }
+
+  private:
+    std::ofstream m_vertexFile;
+    std::ofstream m_indexFile;
+
+    uint32_t m_maxTriangles;
+    uint32_t m_maxVertices;
+
+    const float* m_positions;
+    const float* m_normals;
+    const float* m_texcoords;
+
+    // The cluster being made
+    std::vector<Vertex> m_vertices;
+    std::vector<uint32_t> m_indices;
+    std::unordered_map<ObjCorner, uint32_t, CornerHash> m_corners;
+    int m_material = -1;
+
+    inline glm::vec3 position(int v) const {
+      return glm::vec3(m_positions[3 * v + 0], m_positions[3 * v + 1], m_positions[3 * v + 2]);
+    }
+
+    inline glm::vec3 centroid(const Triangle& triangle) const {
+      return (position(triangle.corners[0].v) + position(triangle.corners[1].v) + position(triangle.corners[2].v))
+             / 3.0f;
+    }
+
+    // Same as ObjLoader::Load
+    Vertex vertex(const ObjCorner& corner) const {
+      Vertex vertex{};
+
+      vertex.pos   = position(corner.v);
+      vertex.color = {1.0f, 1.0f, 1.0f};
+
+      if (corner.vn >= 0) {
+        vertex.normal = {m_normals[3 * corner.vn + 0], m_normals[3 * corner.vn + 1], m_normals[3 * corner.vn + 2]};
+      }
+      if (corner.vt >= 0) {
+        vertex.texCoord = {m_texcoords[2 * corner.vt + 0], 1.0f - m_texcoords[2 * corner.vt + 1]};
+      }
+
+      return vertex;
+    }
+
+    void close() {
+      if (m_indices.empty()) return;
+
+      ClusterFile::Cluster cluster = {
+          .firstVertex = vertexCount,
+          .firstIndex  = indexCount,
+          .min         = m_vertices[0].pos,
+          .max         = m_vertices[0].pos,
+          .materialId  = m_material,
+          .vertexCount = static_cast<uint32_t>(m_vertices.size()),
+          .indexCount  = static_cast<uint32_t>(m_indices.size()),
+      };
+      for (const Vertex& vertex : m_vertices) {
+        cluster.min = glm::min(cluster.min, vertex.pos);
+        cluster.max = glm::max(cluster.max, vertex.pos);
+      }
+      clusters.push_back(cluster);
+
+      writeArray(m_vertexFile, m_vertices.data(), m_vertices.size());
+      writeArray(m_indexFile, m_indices.data(), m_indices.size());
+
+      vertexCount += cluster.vertexCount;
+      indexCount += cluster.indexCount;
+      maxVertices = std::max(maxVertices, cluster.vertexCount);
+      maxIndices  = std::max(maxIndices, cluster.indexCount);
+
+      m_vertices.clear();
+      m_indices.clear();
+      m_corners.clear();
+    }
+  };
+
+}  // namespace
+
+std::string ClusterFile::Path(const std::string& sourcePath, const std::string& cacheDir) {
+  return fs::path(MeshCache::Path(sourcePath, cacheDir)).replace_extension(".vkclusters").string();
+}
+
+std::unique_ptr<ClusterFile> ClusterFile::Open(const std::string& sourcePath,
+                                               const std::string& cacheDir,
+                                               const ClusterBuildOption& option) {
+  const std::string path = Path(sourcePath, cacheDir);
+
+  std::error_code ec;
+  if (fs::exists(path, ec)) {
+    try {
+      std::unique_ptr<ClusterFile> file = std::make_unique<ClusterFile>(path);
+      if (file->upToDate()) return file;
+    } catch (const std::runtime_error& e) {
+      std::cerr << "Ignoring cluster file " << path << ": " << e.what() << std::endl;
+    }
+  }
+
+  Build(sourcePath, path, option);
+  return std::make_unique<ClusterFile>(path);
+}
+
+void ClusterFile::Build(const std::string& sourcePath,
+                        const std::string& clusterPath,
+                        const ClusterBuildOption& option) {
+  std::error_code ec;
+  const fs::path path(clusterPath);
+  if (path.has_parent_path()) fs::create_directories(path.parent_path(), ec);
+
+  const TempFiles tmp(clusterPath);
+
+  // 1. Parse the OBJ part after part, its attributes and triangles go to the temporary files as they are read
+  ObjData obj;
+  glm::vec3 min(FLT_MAX), max(-FLT_MAX);
+  uint64_t triangleCount = 0;
+  {
+    std::ofstream positions(tmp.positions, std::ios::binary | std::ios::trunc);
+    std::ofstream normals(tmp.normals, std::ios::binary | std::ios::trunc);
+    std::ofstream texcoords(tmp.texcoords, std::ios::binary | std::ios::trunc);
+    std::ofstream triangles(tmp.triangles, std::ios::binary | std::ios::trunc);
+
+    std::vector<Triangle> parsed;
+    ObjLoader::Stream(
+        sourcePath, option.chunkSize,
+        [&](const ObjChunk& chunk) {
+          writeArray(positions, chunk.positions.data(), chunk.positions.size());
+          writeArray(normals, chunk.normals.data(), chunk.normals.size());
+          writeArray(texcoords, chunk.texcoords.data(), chunk.texcoords.size());
+
+          for (size_t i = 0; i + 2 < chunk.positions.size(); i += 3) {
+            const glm::vec3 p(chunk.positions[i], chunk.positions[i + 1], chunk.positions[i + 2]);
+            min = glm::min(min, p);
+            max = glm::max(max, p);
+          }
+
+          parsed.resize(chunk.materialIds.size());
+          for (size_t t = 0; t < parsed.size(); ++t) {
+            parsed[t] = {{chunk.corners[3 * t], chunk.corners[3 * t + 1], chunk.corners[3 * t + 2]},
+                         chunk.materialIds[t]};
+          }
+          writeArray(triangles, parsed.data(), parsed.size());
+          triangleCount += parsed.size();
+        },
+        obj);
+
+    for (std::ofstream* file : {&positions, &normals, &texcoords, &triangles}) {
+      file->close();
+      if (!*file) throw std::runtime_error("failed to write the clusters of : " + sourcePath);
+    }
+  }
+
+  const MappedFile positionFile(tmp.positions);
+  const MappedFile normalFile(tmp.normals);
+  const MappedFile texcoordFile(tmp.texcoords);
+  const MappedFile triangleFile(tmp.triangles);
+
+  const float* positions    = reinterpret_cast<const float*>(positionFile.data());
+  const Triangle* triangles = reinterpret_cast<const Triangle*>(triangleFile.data());
+
+  // 2. The cell of each triangle, in a grid of about one cluster per cell, and the triangles of each cell
+  const uint64_t cellTarget = std::max<uint64_t>(1, triangleCount / std::max(option.clusterTriangles, 1u));
+  const uint32_t gridSize   = std::clamp(static_cast<uint32_t>(std::ceil(std::cbrt(double(cellTarget)))), 1u,
+                                         kMaxGridSize);
+
+  glm::vec3 scale;
+  for (int a = 0; a < 3; ++a) scale[a] = max[a] > min[a] ? gridSize / (max[a] - min[a]) : 0.0f;
+
+  const auto cellOf = [&](const Triangle& triangle) {
+    glm::vec3 c(0.0f);
+    for (const ObjCorner& corner : triangle.corners) {
+      c += glm::vec3(positions[3 * corner.v + 0], positions[3 * corner.v + 1], positions[3 * corner.v + 2]);
+    }
+    c /= 3.0f;
+
+    uint32_t cell[3];
+    for (int a = 0; a < 3; ++a) {
+      cell[a] = std::min(gridSize - 1, static_cast<uint32_t>(std::max(0.0f, (c[a] - min[a]) * scale[a])));
+    }
+    return cell[0] + gridSize * (cell[1] + gridSize * cell[2]);
+  };
+
+  // offsets[c] : where the triangles of the cell c start, once sorted by cell
+  std::vector<uint64_t> offsets(size_t(gridSize) * gridSize * gridSize + 1, 0);
+  {
+    std::ofstream cells(tmp.cells, std::ios::binary | std::ios::trunc);
+
+    std::vector<uint32_t> buffer;
+    buffer.reserve(1 << 16);
+    for (uint64_t t = 0; t < triangleCount; ++t) {
+      const uint32_t cell = cellOf(triangles[t]);
+      offsets[cell + 1]++;
+      buffer.push_back(cell);
+
+      if (buffer.size() == buffer.capacity()) {
+        writeArray(cells, buffer.data(), buffer.size());
+        buffer.clear();
+      }
+    }
+    writeArray(cells, buffer.data(), buffer.size());
+
+    cells.close();
+    if (!cells) throw std::runtime_error("failed to write the clusters of : " + sourcePath);
+  }
+  for (size_t c = 1; c < offsets.size(); ++c) offsets[c] += offsets[c - 1];
+
+  const MappedFile cellFile(tmp.cells);
+  const uint32_t* cells = reinterpret_cast<const uint32_t*>(cellFile.data());
+
+  // 3. Counting sort by cell, a window of the sorted order at a time so it fits in the budget (the ids, and the keys
+  // ClusterWriter sorts them by), then the clusters of each cell of the window
+  ClusterWriter writer(tmp, option.clusterTriangles, positions, reinterpret_cast<const float*>(normalFile.data()),
+                       reinterpret_cast<const float*>(texcoordFile.data()));
+
+  const uint64_t window = std::max<uint64_t>(option.memoryBudget / (3 * sizeof(uint64_t)), option.clusterTriangles);
+  std::vector<uint64_t> ids;
+
+  for (uint64_t begin = 0; begin < triangleCount; begin += window) {
+    const uint64_t end = std::min(begin + window, triangleCount);
+    ids.assign(end - begin, 0);
+
+    std::vector<uint64_t> next(offsets.begin(), offsets.end() - 1);
+    for (uint64_t t = 0; t < triangleCount; ++t) {
+      const uint64_t position = next[cells[t]]++;
+      if (position >= begin && position < end) ids[position - begin] = t;
+    }
+
+    for (uint64_t position = begin; position < end;) {
+      const size_t cell     = std::upper_bound(offsets.begin(), offsets.end(), position) - offsets.begin() - 1;
+      const uint64_t runEnd = std::min(offsets[cell + 1], end);
+      writer.write(triangles, ids.data() + (position - begin), runEnd - position);
+      position = runEnd;
+    }
+  }
+  writer.finish();
+
+  // 4. The file itself, written to a temporary file then renamed, so a reader never sees a partial one
+  std::vector<std::string> sources = {sourcePath};
+  sources.insert(sources.end(), obj.materialFiles.begin(), obj.materialFiles.end());
+
+  Header header = {
+      .magic         = {},
+      .version       = Version,
+      .vertexSize    = sizeof(Vertex),
+      .materialSize  = sizeof(Material),
+      .clusterSize   = sizeof(Cluster),
+      .sourceCount   = static_cast<uint32_t>(sources.size()),
+      .materialCount = static_cast<uint32_t>(obj.materials.size()),
+      .maxVertices   = writer.maxVertices,
+      .maxIndices    = writer.maxIndices,
+      .triangleCount = triangleCount,
+      .clusterCount  = writer.clusters.size(),
+      .vertexCount   = writer.vertexCount,
+      .indexCount    = writer.indexCount,
+      .clusterOffset = 0,
+      .vertexOffset  = 0,
+      .indexOffset   = 0,
+      .min           = {min.x, min.y, min.z},
+      .max           = {max.x, max.y, max.z},
+  };
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+
+  const std::string tmpPath = clusterPath + ".tmp";
+  {
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    writeArray(out, &header, 1);
+
+    for (const std::string& source : sources) {
+      const Stamp stamp = {
+          .mtime = modificationTime(source, ec),
+          .size  = static_cast<uint64_t>(fs::file_size(source, ec)),
+      };
+      writeArray(out, &stamp, 1);
+      writeString(out, source);
+    }
+
+    for (const ObjMaterial& material : obj.materials) writeArray(out, &material.material, 1);
+    for (const ObjMaterial& material : obj.materials) writeString(out, material.diffuseTexname);
+
+    pad(out);
+    header.clusterOffset = static_cast<uint64_t>(out.tellp());
+    writeArray(out, writer.clusters.data(), writer.clusters.size());
+
+    pad(out);
+    header.vertexOffset = static_cast<uint64_t>(out.tellp());
+    append(out, tmp.vertices);
+
+    pad(out);
+    header.indexOffset = static_cast<uint64_t>(out.tellp());
+    append(out, tmp.indices);
+
+    out.seekp(0);
+    writeArray(out, &header, 1);
+
+    out.close();
+    if (!out) {
+      fs::remove(tmpPath, ec);
+      throw std::runtime_error("failed to write : " + clusterPath);
+    }
+  }
+
+  fs::rename(tmpPath, clusterPath, ec);
+  if (ec) {
+    fs::remove(tmpPath, ec);
+    throw std::runtime_error("failed to write : " + clusterPath);
+  }
+
+  std::cout << "Clusters: " << writer.clusters.size() << " of " << triangleCount << " triangles, grid " << gridSize
+            << "^3" << std::endl;
+}
+
+ClusterFile::ClusterFile(const std::string& path) : m_file(path) {
+  const char* data  = m_file.data();
+  const size_t size = m_file.size();
+  size_t offset     = 0;
+
+  const auto take = [&](size_t bytes) {
+    if (offset > size || bytes > size - offset) throw std::runtime_error("truncated cluster file : " + path);
+    const char* p = data + offset;
+    offset += bytes;
+    return p;
+  };
+  const auto string = [&]() {
+    uint32_t length;
+    std::memcpy(&length, take(sizeof(length)), sizeof(length));
+    return std::string(take(length), length);
+  };
+  // The arrays are at the offsets the header gives
+  const auto array = [&](uint64_t arrayOffset, uint64_t count, size_t elementSize) {
+    if (arrayOffset > size || count > (size - arrayOffset) / elementSize) {
+      throw std::runtime_error("truncated cluster file : " + path);
+    }
+    return data + arrayOffset;
+  };
+
+  Header header;
+  std::memcpy(&header, take(sizeof(Header)), sizeof(Header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != Version
+      || header.vertexSize != sizeof(Vertex) || header.materialSize != sizeof(Material)
+      || header.clusterSize != sizeof(Cluster)) {
+    throw std::runtime_error("not a cluster file of this version : " + path);
+  }
+
+  for (uint32_t i = 0; i < header.sourceCount; ++i) {
+    Stamp stamp;
+    std::memcpy(&stamp, take(sizeof(Stamp)), sizeof(Stamp));
+    m_sources.push_back({string(), stamp.mtime, stamp.size});
+  }
+
+  m_materials.resize(header.materialCount);
+  for (Material& material : m_materials) std::memcpy(&material, take(sizeof(Material)), sizeof(Material));
+  m_textures.resize(header.materialCount);
+  for (std::string& texture : m_textures) texture = string();
+
+  const Cluster* clusters = reinterpret_cast<const Cluster*>(
+      array(header.clusterOffset, header.clusterCount, sizeof(Cluster)));
+  m_clusters.assign(clusters, clusters + header.clusterCount);
+
+  m_vertices = reinterpret_cast<const Vertex*>(array(header.vertexOffset, header.vertexCount, sizeof(Vertex)));
+  m_indices  = reinterpret_cast<const uint32_t*>(array(header.indexOffset, header.indexCount, sizeof(uint32_t)));
+
+  for (const Cluster& cluster : m_clusters) {
+    if (cluster.firstVertex > header.vertexCount || cluster.vertexCount > header.vertexCount - cluster.firstVertex
+        || cluster.firstIndex > header.indexCount || cluster.indexCount > header.indexCount - cluster.firstIndex
+        || cluster.vertexCount > header.maxVertices || cluster.indexCount > header.maxIndices) {
+      throw std::runtime_error("corrupted cluster file : " + path);
+    }
+  }
+
+  m_min           = glm::vec3(header.min[0], header.min[1], header.min[2]);
+  m_max           = glm::vec3(header.max[0], header.max[1], header.max[2]);
+  m_triangleCount = header.triangleCount;
+  m_maxVertices   = header.maxVertices;
+  m_maxIndices    = header.maxIndices;
+}
+
+bool ClusterFile::upToDate() const {
+  for (const Source& source : m_sources) {
+    std::error_code ec;
+
+    const uintmax_t size = fs::file_size(source.path, ec);
+    if (ec || size != source.size) return false;
+
+    const int64_t mtime = modificationTime(source.path, ec);
+    if (ec || mtime != source.mtime) return false;
+  }
+
+  return true;
+}
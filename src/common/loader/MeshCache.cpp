@@ -0,0 +1,263 @@
+// clang-format off
+#include <common/loader/MeshCache.hpp>
+#include <cstdint>                    // for uint32_t, uint64_t, int64_t
+#include <cstdio>                     // for snprintf
+#include <cstring>                    // for memcpy, memcmp
+#include <filesystem>                 // for path, file_size, last_write_time
+#include <fstream>                    // for ofstream
+#include <iostream>                   // for cerr, endl
+#include <stdexcept>                  // for runtime_error
+#include <system_error>               // for error_code
+#include <common/io/MappedFile.hpp>   // for MappedFile
+// clang-format on
+
+using namespace vkl;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+  constexpr char kMagic[8]    = {'V', 'K', 'M', 'E', 'S', 'H', '\0', '\0'};
+  constexpr size_t kAlignment = 16;
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t vertexSize;    // catch a change of Vertex / Material without a version bump
+    uint32_t materialSize;
+    uint32_t sourceCount;
+    uint64_t vertexCount;
+    uint64_t indexCount;
+    uint64_t triangleCount;
+    uint64_t materialCount;
+  };
+
+  struct Stamp {
+    int64_t mtime;
+    uint64_t size;
+    uint64_t hash;
+  };
+
+  uint64_t hashBytes(const char* data, size_t size) {
+    uint64_t h = 0x9e3779b97f4a7c15ull ^ size;
+
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+      uint64_t word;
+      std::memcpy(&word, data + i, sizeof(uint64_t));
+      h = (h ^ word) * 0xff51afd7ed558ccdull;
+      h ^= h >> 32;
+    }
+    for (; i < size; ++i) {
+      h = (h ^ static_cast<unsigned char>(data[i])) * 0x100000001b3ull;
+    }
+
+    return h;
+  }
+
+  uint64_t hashFile(const std::string& path) {
+    MappedFile file(path);
+    return hashBytes(file.data(), file.size());
+  }
+
+  int64_t modificationTime(const std::string& path, std::error_code& ec) {
+    return static_cast<int64_t>(fs::last_write_time(path, ec).time_since_epoch().count());
+  }
+
+  class Writer {
+  public:
+    template <typename T> void pod(const T& value) { append(&value, sizeof(T)); }
+
+    template <typename T> void array(const std::vector<T>& values) {
+      align();
+      append(values.data(), values.size() * sizeof(T));
+    }
+
+    void string(const std::string& value) {
+      pod(static_cast<uint32_t>(value.size()));
+      append(value.data(), value.size());
+    }
+
+    inline const std::vector<char>& bytes() const { return m_bytes; }
+
+  private:
+    std::vector<char> m_bytes;
+
+    void append(const void* data, size_t size) {
+      const char* begin = static_cast<const char*>(data);
+      m_bytes.insert(m_bytes.end(), begin, begin + size);
+    }
+
+    void align() { m_bytes.resize((m_bytes.size() + kAlignment - 1) / kAlignment * kAlignment, 0); }
+  };
+
+  class Reader {
+  public:
+    Reader(const char* data, size_t size) : m_offset(0), m_data(data), m_size(size) {}
+
+    template <typename T> T pod() {
+      T value;
+      std::memcpy(&value, take(sizeof(T)), sizeof(T));
+      return value;
+    }
+
+    template <typename T> void array(std::vector<T>& values, uint64_t count) {
+      m_offset = (m_offset + kAlignment - 1) / kAlignment * kAlignment;
+      if (count > m_size / sizeof(T)) throw std::runtime_error("truncated cache");
+
+      values.resize(count);
+      if (count > 0) std::memcpy(values.data(), take(count * sizeof(T)), count * sizeof(T));
+    }
+
+    std::string string() {
+      const uint32_t length = pod<uint32_t>();
+      return std::string(take(length), length);
+    }
+
+  private:
+    size_t m_offset;
+    const char* m_data;
+    size_t m_size;
+
+    const char* take(size_t size) {
+      if (m_offset > m_size || size > m_size - m_offset) throw std::runtime_error("truncated cache");
+      const char* p = m_data + m_offset;
+      m_offset += size;
+      return p;
+    }
+  };
+
+  // A source is unchanged if it has the same size, and the same modification time or the same content
+  bool isUpToDate(const std::string& path, const Stamp& stamp) {
+    std::error_code ec;
+
+    const uintmax_t size = fs::file_size(path, ec);
+    if (ec || size != stamp.size) return false;
+
+    const int64_t mtime = modificationTime(path, ec);
+    if (ec) return false;
+    if (mtime == stamp.mtime) return true;
+
+    // Touched (checkout, copy ...), compare the content
+    return hashFile(path) == stamp.hash;
+  }
+
+}  // namespace
+
+std::string MeshCache::Path(const std::string& sourcePath, const std::string& cacheDir, const std::string& variant) {
+  const std::string name = variant.empty() ? "" : "." + variant;
+  if (cacheDir.empty()) return sourcePath + name + ".vkmesh";
+
+  // Models with the same name may come from different directories
+  std::error_code ec;
+  const std::string absolute = fs::absolute(sourcePath, ec).string();
+
+  char suffix[32];
+  std::snprintf(suffix, sizeof(suffix), "-%016llx.vkmesh",
+                static_cast<unsigned long long>(hashBytes(absolute.data(), absolute.size())));
+
+  return (fs::path(cacheDir) / (fs::path(sourcePath).filename().string() + name + suffix)).string();
+}
+
+bool MeshCache::Read(const std::string& cachePath, MeshData& mesh) {
+  std::error_code ec;
+  if (!fs::exists(cachePath, ec)) return false;
+
+  try {
+    MappedFile file(cachePath);
+    Reader reader(file.data(), file.size());
+
+    const Header header = reader.pod<Header>();
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != Version
+        || header.vertexSize != sizeof(Vertex) || header.materialSize != sizeof(Material)) {
+      return false;
+    }
+
+    for (uint32_t i = 0; i < header.sourceCount; ++i) {
+      const Stamp stamp       = reader.pod<Stamp>();
+      const std::string path  = reader.string();
+      if (!isUpToDate(path, stamp)) return false;
+    }
+
+    MeshData data;
+    reader.array(data.vertices, header.vertexCount);
+    reader.array(data.indices, header.indexCount);
+    reader.array(data.materialIds, header.triangleCount);
+    reader.array(data.materials, header.materialCount);
+
+    data.textures.resize(header.materialCount);
+    for (std::string& texture : data.textures) texture = reader.string();
+
+    mesh = std::move(data);
+    return true;
+  } catch (const std::runtime_error& e) {
+    std::cerr << "Ignoring mesh cache " << cachePath << ": " << e.what() << std::endl;
+    return false;
+  }
+}
+
+bool MeshCache::Write(const std::string& cachePath, const std::vector<std::string>& sources, const MeshData& mesh) {
+  Writer writer;
+
+  Header header = {
+      .version       = Version,
+      .vertexSize    = sizeof(Vertex),
+      .materialSize  = sizeof(Material),
+      .sourceCount   = static_cast<uint32_t>(sources.size()),
+      .vertexCount   = mesh.vertices.size(),
+      .indexCount    = mesh.indices.size(),
+      .triangleCount = mesh.materialIds.size(),
+      .materialCount = mesh.materials.size(),
+  };
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  writer.pod(header);
+
+  try {
+    for (const std::string& source : sources) {
+      std::error_code ec;
+      const Stamp stamp = {
+          .mtime = modificationTime(source, ec),
+          .size  = static_cast<uint64_t>(fs::file_size(source)),
+          .hash  = hashFile(source),
+      };
+      writer.pod(stamp);
+      writer.string(source);
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Can't write mesh cache " << cachePath << ": " << e.what() << std::endl;
+    return false;
+  }
+
+  writer.array(mesh.vertices);
+  writer.array(mesh.indices);
+  writer.array(mesh.materialIds);
+  writer.array(mesh.materials);
+  for (size_t i = 0; i < mesh.materials.size(); ++i) {
+    writer.string(i < mesh.textures.size() ? mesh.textures[i] : "");
+  }
+
+  // Write a temporary file then rename it, so a reader never sees a partial cache
+  std::error_code ec;
+  const fs::path path(cachePath);
+  if (path.has_parent_path()) fs::create_directories(path.parent_path(), ec);
+
+  const std::string tmpPath = cachePath + ".tmp";
+  {
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    out.write(writer.bytes().data(), static_cast<std::streamsize>(writer.bytes().size()));
+    if (!out) {
+      std::cerr << "Can't write mesh cache " << cachePath << std::endl;
+      fs::remove(tmpPath, ec);
+      return false;
+    }
+  }
+
+  fs::rename(tmpPath, cachePath, ec);
+  if (ec) {
+    std::cerr << "Can't write mesh cache " << cachePath << ": " << ec.message() << std::endl;
+    fs::remove(tmpPath, ec);
+    return false;
+  }
+
+  return true;
+}
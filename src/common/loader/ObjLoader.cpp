@@ -0,0 +1,597 @@
+// clang-format off
+#include <common/loader/ObjLoader.hpp>
+#include <algorithm>                   // for min, max
+#include <charconv>                    // for from_chars
+#include <climits>                     // for INT_MIN
+#include <cstdlib>                     // for strtod
+#include <cstring>                     // for memchr, memcpy, memmove
+#include <exception>                   // for exception_ptr, current_exception
+#include <fstream>                     // for ifstream
+#include <future>                      // for future
+#include <iostream>                    // for cerr, endl
+#include <stdexcept>                   // for runtime_error
+#include <string_view>                 // for string_view
+#include <unordered_map>               // for unordered_map
+#include <common/io/MappedFile.hpp>    // for MappedFile
+// clang-format on
+
+using namespace vkl;
+
+namespace {
+
+  // Below this size, splitting the file costs more than it saves
+  constexpr size_t kMinChunkSize = 1 << 20;
+
+  constexpr int kNoIndex = INT_MIN;
+
+  enum RelativeBits : uint8_t {
+    RELATIVE_V  = 1 << 0,
+    RELATIVE_VT = 1 << 1,
+    RELATIVE_VN = 1 << 2,
+  };
+
+  /**
+   * Index triple of a face corner, as read in one chunk. Positive OBJ indices are already global (0-based), negative
+   * ones are relative to the attributes read so far: they are stored relatively to the start of the chunk and fixed up
+   * once the attribute count of the previous chunks is known.
+   */
+  struct RawIndex {
+    int v;
+    int vt;
+    int vn;
+    uint8_t relative;
+  };
+
+  struct Chunk {
+    const char* begin;
+    const char* end;
+
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<float> texcoords;
+
+    std::vector<RawIndex> corners;        // 3 per triangle
+    std::vector<int> triangleMaterials;   // index in usemtl, -1 when inherited from the previous chunks
+    std::vector<std::string> usemtl;      // material names, in order of appearance
+    std::vector<std::vector<std::string>> mtllibs;
+
+    // Filled when merging
+    size_t positionOffset = 0;
+    size_t normalOffset   = 0;
+    size_t texcoordOffset = 0;
+    size_t cornerOffset   = 0;
+    int startMaterial     = -1;
+  };
+
+  inline bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+  inline const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && isSpace(*p)) ++p;
+    return p;
+  }
+
+  inline const char* skipToken(const char* p, const char* end) {
+    while (p < end && !isSpace(*p)) ++p;
+    return p;
+  }
+
+  // Returns true if the line starts with the keyword followed by a space
+  inline bool startsWith(const char* p, const char* end, std::string_view keyword) {
+    const size_t n = keyword.size();
+    return static_cast<size_t>(end - p) > n && std::memcmp(p, keyword.data(), n) == 0 && isSpace(p[n]);
+  }
+
+  inline std::string_view trim(const char* p, const char* end) {
+    p = skipSpaces(p, end);
+    while (end > p && isSpace(end[-1])) --end;
+    return std::string_view(p, end - p);
+  }
+
+  /**
+   * Parse a floating point number, parsed as a double then narrowed like tinyobj does.
+   * On failure, value is left untouched (so it keeps its default).
+   */
+  inline const char* parseReal(const char* p, const char* end, float& value) {
+    p = skipSpaces(p, end);
+    if (p < end && *p == '+') ++p;
+
+    double result;
+#if defined(__cpp_lib_to_chars)
+    const std::from_chars_result res = std::from_chars(p, end, result);
+    if (res.ec != std::errc()) return skipToken(p, end);
+    value = static_cast<float>(result);
+    return res.ptr;
+#else
+    // Fallback for standard libraries without floating point from_chars: strtod needs a null-terminated string
+    char buffer[64];
+    const char* tokenEnd = skipToken(p, end);
+    const size_t length  = std::min<size_t>(tokenEnd - p, sizeof(buffer) - 1);
+    std::memcpy(buffer, p, length);
+    buffer[length] = '\0';
+
+    char* parsedEnd = nullptr;
+    result          = std::strtod(buffer, &parsedEnd);
+    if (parsedEnd == buffer) return tokenEnd;
+    value = static_cast<float>(result);
+    return p + (parsedEnd - buffer);
+#endif
+  }
+
+  inline const char* parseInt(const char* p, const char* end, int& value) {
+    if (p < end && *p == '+') ++p;
+    const std::from_chars_result res = std::from_chars(p, end, value);
+    if (res.ec != std::errc()) value = 0;
+    return res.ptr;
+  }
+
+  /**
+   * Convert an OBJ index (1-based, or negative for relative) into a 0-based one.
+   * Relative indices are resolved against count, the number of attributes read in the chunk so far.
+   */
+  inline int fixIndex(int idx, size_t count, uint8_t bit, uint8_t& relative) {
+    if (idx > 0) return idx - 1;
+    if (idx < 0) {
+      relative |= bit;
+      return static_cast<int>(count) + idx;
+    }
+    return kNoIndex;  // 0 is not a valid OBJ index
+  }
+
+  // Parse "v", "v/vt", "v//vn" or "v/vt/vn"
+  inline const char* parseCorner(const char* p, const char* end, const Chunk& chunk, RawIndex& index) {
+    int v = 0, vt = 0, vn = 0;
+
+    p = parseInt(p, end, v);
+    if (p < end && *p == '/') {
+      ++p;
+      if (p < end && *p == '/') {
+        ++p;
+        p = parseInt(p, end, vn);
+      } else {
+        p = parseInt(p, end, vt);
+        if (p < end && *p == '/') {
+          ++p;
+          p = parseInt(p, end, vn);
+        }
+      }
+    }
+
+    index.relative = 0;
+    index.v        = fixIndex(v, chunk.positions.size() / 3, RELATIVE_V, index.relative);
+    index.vt       = vt == 0 ? kNoIndex : fixIndex(vt, chunk.texcoords.size() / 2, RELATIVE_VT, index.relative);
+    index.vn       = vn == 0 ? kNoIndex : fixIndex(vn, chunk.normals.size() / 3, RELATIVE_VN, index.relative);
+
+    return skipToken(p, end);
+  }
+
+  void parseFace(const char* p, const char* end, Chunk& chunk, std::vector<RawIndex>& face) {
+    face.clear();
+
+    p = skipSpaces(p, end);
+    while (p < end) {
+      RawIndex index;
+      p = parseCorner(p, end, chunk, index);
+      face.push_back(index);
+      p = skipSpaces(p, end);
+    }
+
+    // Fan triangulation, the same as tinyobj
+    const int material = static_cast<int>(chunk.usemtl.size()) - 1;
+    for (size_t k = 2; k < face.size(); ++k) {
+      chunk.corners.push_back(face[0]);
+      chunk.corners.push_back(face[k - 1]);
+      chunk.corners.push_back(face[k]);
+      chunk.triangleMaterials.push_back(material);
+    }
+  }
+
+  void parseChunk(Chunk& chunk) {
+    std::vector<RawIndex> face;
+
+    const char* line = chunk.begin;
+    while (line < chunk.end) {
+      const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', chunk.end - line));
+      if (lineEnd == nullptr) lineEnd = chunk.end;
+
+      const char* p = skipSpaces(line, lineEnd);
+
+      if (startsWith(p, lineEnd, "v")) {
+        float x = 0.0f, y = 0.0f, z = 0.0f;
+        p = parseReal(p + 2, lineEnd, x);
+        p = parseReal(p, lineEnd, y);
+        p = parseReal(p, lineEnd, z);
+        chunk.positions.insert(chunk.positions.end(), {x, y, z});
+      } else if (startsWith(p, lineEnd, "vn")) {
+        float x = 0.0f, y = 0.0f, z = 0.0f;
+        p = parseReal(p + 3, lineEnd, x);
+        p = parseReal(p, lineEnd, y);
+        p = parseReal(p, lineEnd, z);
+        chunk.normals.insert(chunk.normals.end(), {x, y, z});
+      } else if (startsWith(p, lineEnd, "vt")) {
+        float u = 0.0f, v = 0.0f;
+        p = parseReal(p + 3, lineEnd, u);
+        p = parseReal(p, lineEnd, v);
+        chunk.texcoords.insert(chunk.texcoords.end(), {u, v});
+      } else if (startsWith(p, lineEnd, "f")) {
+        parseFace(p + 2, lineEnd, chunk, face);
+      } else if (startsWith(p, lineEnd, "usemtl")) {
+        chunk.usemtl.emplace_back(trim(p + 7, lineEnd));
+      } else if (startsWith(p, lineEnd, "mtllib")) {
+        std::vector<std::string> filenames;
+        p = skipSpaces(p + 7, lineEnd);
+        while (p < lineEnd) {
+          const char* tokenEnd = skipToken(p, lineEnd);
+          filenames.emplace_back(p, tokenEnd);
+          p = skipSpaces(tokenEnd, lineEnd);
+        }
+        chunk.mtllibs.push_back(std::move(filenames));
+      }
+
+      line = lineEnd + 1;
+    }
+  }
+
+  // Split [data, data + size) in line-aligned ranges
+  std::vector<Chunk> splitChunks(const char* data, size_t size, size_t maxChunks) {
+    const size_t numChunks = std::max<size_t>(1, std::min(maxChunks, size / kMinChunkSize));
+
+    std::vector<Chunk> chunks;
+    chunks.reserve(numChunks);
+
+    const char* end   = data + size;
+    const char* begin = data;
+    for (size_t i = 1; i <= numChunks && begin < end; ++i) {
+      const char* split = (i == numChunks) ? end : data + (size / numChunks) * i;
+      if (split < begin) split = begin;
+
+      const char* newLine = static_cast<const char*>(std::memchr(split, '\n', end - split));
+      split               = (newLine == nullptr) ? end : newLine + 1;
+
+      Chunk chunk = {};
+      chunk.begin = begin;
+      chunk.end   = split;
+      chunks.push_back(std::move(chunk));
+
+      begin = split;
+    }
+
+    return chunks;
+  }
+
+  inline int resolve(int index, size_t offset, bool relative, size_t count) {
+    if (index == kNoIndex) return kNoIndex;
+
+    const long long resolved = relative ? static_cast<long long>(offset) + index : index;
+    if (resolved < 0 || resolved >= static_cast<long long>(count)) {
+      throw std::runtime_error("face index out of range");
+    }
+
+    return static_cast<int>(resolved);
+  }
+
+  bool loadMaterialFile(const std::string& path, std::vector<ObjMaterial>& materials) {
+    try {
+      MappedFile file(path);
+      ObjLoader::ParseMaterials(file.data(), file.size(), materials);
+      return true;
+    } catch (const std::runtime_error&) {
+      return false;
+    }
+  }
+
+  void loadMaterialFiles(const Chunk& chunk, const std::string& baseDir, ObjData& out) {
+    for (const std::vector<std::string>& filenames : chunk.mtllibs) {
+      // Like tinyobj, the first file of the list that can be read wins. The path is taken as is (relative to the
+      // working directory) then relatively to the OBJ
+      bool found = false;
+      for (const std::string& filename : filenames) {
+        for (const std::string& path : {filename, baseDir.empty() ? std::string() : baseDir + filename}) {
+          found = !path.empty() && loadMaterialFile(path, out.materials);
+          if (found) {
+            out.materialFiles.push_back(path);
+            break;
+          }
+        }
+        if (found) break;
+      }
+
+      if (!found) {
+        std::cerr << "Material file not found: " << (filenames.empty() ? "" : filenames[0]) << std::endl;
+      }
+    }
+  }
+
+  std::string directoryOf(const std::string& path) {
+    const size_t slash = path.find_last_of("/\\");
+    return (slash == std::string::npos) ? "" : path.substr(0, slash + 1);
+  }
+
+  /**
+   * Wait for every task before rethrowing the first exception : the tasks write to the locals of Parse, none may still
+   * run once an exception leaves it
+   */
+  void waitAll(std::vector<std::future<void>>& tasks) {
+    std::exception_ptr error;
+    for (std::future<void>& task : tasks) {
+      try {
+        task.get();
+      } catch (...) {
+        if (!error) error = std::current_exception();
+      }
+    }
+    if (error) std::rethrow_exception(error);
+  }
+
+}  // namespace
+
+ObjData ObjLoader::Load(const std::string& path, ThreadPool& pool) {
+  MappedFile file(path);
+
+  try {
+    return Parse(file.data(), file.size(), directoryOf(path), pool);
+  } catch (const std::runtime_error& e) {
+    throw std::runtime_error("failed to load : " + path + " (" + e.what() + ")");
+  }
+}
+
+void ObjLoader::Stream(const std::string& path,
+                       size_t chunkSize,
+                       const std::function<void(const ObjChunk&)>& visit,
+                       ObjData& out) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) throw std::runtime_error("failed to open : " + path);
+
+  const std::string baseDir = directoryOf(path);
+
+  std::unordered_map<std::string, int> materialMap;
+  size_t numPositions = 0, numNormals = 0, numTexcoords = 0, numTriangles = 0;
+  int currentMaterial = -1;
+
+  // One part at a time, the end of its last line is kept for the next one
+  std::vector<char> buffer(std::max<size_t>(chunkSize, 1));
+  size_t kept = 0;
+  bool last   = false;
+
+  try {
+    while (!last) {
+      file.read(buffer.data() + kept, static_cast<std::streamsize>(buffer.size() - kept));
+      const size_t size = kept + static_cast<size_t>(file.gcount());
+      last              = size < buffer.size();
+
+      const char* data = buffer.data();
+      const char* end  = data + size;
+      if (!last) {
+        size_t lineEnd = size;
+        while (lineEnd > 0 && data[lineEnd - 1] != '\n') --lineEnd;
+        if (lineEnd == 0) {
+          // A line longer than the buffer
+          buffer.resize(buffer.size() * 2);
+          kept = size;
+          continue;
+        }
+        end = data + lineEnd;
+      }
+
+      Chunk chunk = {};
+      chunk.begin = data;
+      chunk.end   = end;
+      parseChunk(chunk);
+
+      const size_t materialCount = out.materials.size();
+      loadMaterialFiles(chunk, baseDir, out);
+      for (size_t i = materialCount; i < out.materials.size(); ++i) {
+        materialMap.emplace(out.materials[i].name, static_cast<int>(i));  // first definition wins
+      }
+
+      const auto findMaterial = [&materialMap](const std::string& name) {
+        const auto it = materialMap.find(name);
+        return it == materialMap.end() ? -1 : it->second;
+      };
+
+      const size_t positionOffset = numPositions, normalOffset = numNormals, texcoordOffset = numTexcoords;
+      numPositions += chunk.positions.size() / 3;
+      numNormals += chunk.normals.size() / 3;
+      numTexcoords += chunk.texcoords.size() / 2;
+      numTriangles += chunk.triangleMaterials.size();
+
+      ObjChunk part;
+      part.positions = std::move(chunk.positions);
+      part.normals   = std::move(chunk.normals);
+      part.texcoords = std::move(chunk.texcoords);
+
+      part.corners.reserve(chunk.corners.size());
+      for (const RawIndex& index : chunk.corners) {
+        const int v  = resolve(index.v, positionOffset, index.relative & RELATIVE_V, numPositions);
+        const int vt = resolve(index.vt, texcoordOffset, index.relative & RELATIVE_VT, numTexcoords);
+        const int vn = resolve(index.vn, normalOffset, index.relative & RELATIVE_VN, numNormals);
+
+        if (v == kNoIndex) throw std::runtime_error("face without vertex index");
+
+        part.corners.push_back({v, vt == kNoIndex ? -1 : vt, vn == kNoIndex ? -1 : vn});
+      }
+
+      std::vector<int> usemtl(chunk.usemtl.size());
+      for (size_t i = 0; i < usemtl.size(); ++i) usemtl[i] = findMaterial(chunk.usemtl[i]);
+
+      part.materialIds.reserve(chunk.triangleMaterials.size());
+      for (int local : chunk.triangleMaterials) part.materialIds.push_back(local < 0 ? currentMaterial : usemtl[local]);
+      if (!usemtl.empty()) currentMaterial = usemtl.back();
+
+      visit(part);
+
+      kept = static_cast<size_t>(data + size - end);
+      std::memmove(buffer.data(), end, kept);
+    }
+
+    if (numTriangles == 0) {
+      throw std::runtime_error("err: # of shapes are zero.");
+    }
+  } catch (const std::runtime_error& e) {
+    throw std::runtime_error("failed to load : " + path + " (" + e.what() + ")");
+  }
+}
+
+ObjData ObjLoader::Parse(const char* data, size_t size, const std::string& baseDir, ThreadPool& pool) {
+  ObjData out;
+
+  /* STEP 1 : Parse every chunk independently */
+
+  std::vector<Chunk> chunks = splitChunks(data, size, pool.size() * 4);
+
+  {
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(chunks.size());
+    for (Chunk& chunk : chunks) {
+      tasks.push_back(pool.submit([&chunk]() { parseChunk(chunk); }));
+    }
+    waitAll(tasks);
+  }
+
+  /* STEP 2 : Load the materials, and compute where each chunk goes in the merged arrays */
+
+  for (const Chunk& chunk : chunks) loadMaterialFiles(chunk, baseDir, out);
+
+  std::unordered_map<std::string, int> materialMap;
+  for (size_t i = 0; i < out.materials.size(); ++i) {
+    materialMap.emplace(out.materials[i].name, static_cast<int>(i));  // first definition wins
+  }
+
+  const auto findMaterial = [&materialMap](const std::string& name) {
+    const auto it = materialMap.find(name);
+    return it == materialMap.end() ? -1 : it->second;
+  };
+
+  size_t numPositions = 0, numNormals = 0, numTexcoords = 0, numCorners = 0;
+  int currentMaterial = -1;
+  for (Chunk& chunk : chunks) {
+    chunk.positionOffset = numPositions;
+    chunk.normalOffset   = numNormals;
+    chunk.texcoordOffset = numTexcoords;
+    chunk.cornerOffset   = numCorners;
+    chunk.startMaterial  = currentMaterial;
+
+    numPositions += chunk.positions.size() / 3;
+    numNormals += chunk.normals.size() / 3;
+    numTexcoords += chunk.texcoords.size() / 2;
+    numCorners += chunk.corners.size();
+
+    if (!chunk.usemtl.empty()) currentMaterial = findMaterial(chunk.usemtl.back());
+  }
+
+  if (numCorners == 0) {
+    throw std::runtime_error("err: # of shapes are zero.");
+  }
+
+  std::vector<float> positions, normals, texcoords;
+  positions.reserve(numPositions * 3);
+  normals.reserve(numNormals * 3);
+  texcoords.reserve(numTexcoords * 2);
+  for (Chunk& chunk : chunks) {
+    positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+    normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+    texcoords.insert(texcoords.end(), chunk.texcoords.begin(), chunk.texcoords.end());
+
+    std::vector<float>().swap(chunk.positions);
+    std::vector<float>().swap(chunk.normals);
+    std::vector<float>().swap(chunk.texcoords);
+  }
+
+  /* STEP 3 : Build the vertices of every chunk at their final place */
+
+  out.vertices.resize(numCorners);
+  out.materialIds.resize(numCorners / 3);
+
+  {
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(chunks.size());
+    for (Chunk& chunk : chunks) {
+      tasks.push_back(pool.submit([&]() {
+        std::vector<int> usemtl(chunk.usemtl.size());
+        for (size_t i = 0; i < usemtl.size(); ++i) usemtl[i] = findMaterial(chunk.usemtl[i]);
+
+        for (size_t t = 0; t < chunk.triangleMaterials.size(); ++t) {
+          const int local                             = chunk.triangleMaterials[t];
+          out.materialIds[chunk.cornerOffset / 3 + t] = local < 0 ? chunk.startMaterial : usemtl[local];
+        }
+
+        for (size_t c = 0; c < chunk.corners.size(); ++c) {
+          const RawIndex& index = chunk.corners[c];
+
+          const int v  = resolve(index.v, chunk.positionOffset, index.relative & RELATIVE_V, numPositions);
+          const int vt = resolve(index.vt, chunk.texcoordOffset, index.relative & RELATIVE_VT, numTexcoords);
+          const int vn = resolve(index.vn, chunk.normalOffset, index.relative & RELATIVE_VN, numNormals);
+
+          if (v == kNoIndex) throw std::runtime_error("face without vertex index");
+
+          Vertex vertex{};
+
+          vertex.pos = {positions[3 * v + 0], positions[3 * v + 1], positions[3 * v + 2]};
+
+          if (vn != kNoIndex) {
+            vertex.normal = {normals[3 * vn + 0], normals[3 * vn + 1], normals[3 * vn + 2]};
+          }
+
+          vertex.color = {1.0f, 1.0f, 1.0f};
+
+          if (vt != kNoIndex) {
+            vertex.texCoord = {texcoords[2 * vt + 0], 1.0f - texcoords[2 * vt + 1]};
+          }
+
+          out.vertices[chunk.cornerOffset + c] = vertex;
+        }
+      }));
+    }
+    waitAll(tasks);
+  }
+
+  return out;
+}
+
+void ObjLoader::ParseMaterials(const char* data, size_t size, std::vector<ObjMaterial>& materials) {
+  const char* end  = data + size;
+  const char* line = data;
+
+  ObjMaterial* current = nullptr;
+
+  while (line < end) {
+    const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', end - line));
+    if (lineEnd == nullptr) lineEnd = end;
+
+    const char* p = skipSpaces(line, lineEnd);
+
+    if (startsWith(p, lineEnd, "newmtl")) {
+      // Same defaults as tinyobj::InitMaterial
+      materials.push_back({
+          .name     = std::string(trim(p + 7, lineEnd)),
+          .material = {
+              .ambient   = glm::vec3(0.0f),
+              .diffuse   = glm::vec3(0.0f),
+              .specular  = glm::vec3(0.0f),
+              .shininess = 1.0f,
+          },
+          .diffuseTexname = "",
+      });
+      current = &materials.back();
+    } else if (current != nullptr) {
+      glm::vec3* color = nullptr;
+      if (startsWith(p, lineEnd, "Ka")) color = &current->material.ambient;
+      if (startsWith(p, lineEnd, "Kd")) color = &current->material.diffuse;
+      if (startsWith(p, lineEnd, "Ks")) color = &current->material.specular;
+
+      if (color != nullptr) {
+        p = parseReal(p + 3, lineEnd, color->r);
+        p = parseReal(p, lineEnd, color->g);
+        p = parseReal(p, lineEnd, color->b);
+      } else if (startsWith(p, lineEnd, "Ns")) {
+        parseReal(p + 3, lineEnd, current->material.shininess);
+      } else if (startsWith(p, lineEnd, "map_Kd")) {
+        // Texture options (-bm, -o ...) come first, the name is the last token
+        const std::string_view args = trim(p + 7, lineEnd);
+        const size_t lastSpace      = args.find_last_of(" \t");
+        current->diffuseTexname     = std::string(lastSpace == std::string_view::npos ? args : args.substr(lastSpace + 1));
+      }
+    }
+
+    line = lineEnd + 1;
+  }
+}
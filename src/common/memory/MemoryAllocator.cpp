@@ -0,0 +1,279 @@
+// clang-format off
+#include <common/memory/MemoryAllocator.hpp>
+#include <algorithm>          // for find_if, min, max
+#include <stdexcept>          // for runtime_error
+#include <common/Device.hpp>  // for Device
+// clang-format on
+
+using namespace vkl;
+
+struct MemoryAllocator::Block {
+  VkDeviceMemory memory;
+  uint32_t memoryType;
+  uint32_t pool;  // in m_pools, Dedicated for memory of its own
+  Tlsf ranges;
+
+  uint8_t* mapped;  // null if not host visible
+  bool coherent;
+};
+
+namespace {
+
+  constexpr uint32_t Dedicated = UINT32_MAX;
+
+  uint8_t* mappedAt(const MemoryAllocator::Block& block, VkDeviceSize offset) {
+    return block.mapped ? block.mapped + offset : nullptr;
+  }
+
+}  // namespace
+
+MemoryAllocator::MemoryAllocator(const Device& device, VkDeviceSize blockSize)
+    : m_device(device), m_blockSize(blockSize) {
+  vkGetPhysicalDeviceMemoryProperties(m_device.physical(), &m_properties);
+  m_pools.resize(2 * m_properties.memoryTypeCount);
+
+  m_heaps.resize(m_properties.memoryHeapCount);
+  for (uint32_t i = 0; i < m_properties.memoryHeapCount; i++) {
+    m_heaps[i].size        = m_properties.memoryHeaps[i].size;
+    m_heaps[i].deviceLocal = (m_properties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+  }
+}
+
+MemoryAllocator::~MemoryAllocator() {
+  for (const std::vector<std::unique_ptr<Block>>& pool : m_pools) {
+    for (const std::unique_ptr<Block>& block : pool) destroyBlock(*block);
+  }
+  for (const std::unique_ptr<Block>& block : m_dedicated) destroyBlock(*block);
+}
+
+MemoryAllocator::Allocation MemoryAllocator::allocateBuffer(VkBuffer buffer,
+                                                            VkMemoryPropertyFlags properties,
+                                                            MemoryCategory category) {
+  VkMemoryRequirements requirements;
+  vkGetBufferMemoryRequirements(m_device.logical(), buffer, &requirements);
+
+  const Allocation allocation = allocate(requirements, properties, category, false);
+  if (vkBindBufferMemory(m_device.logical(), buffer, allocation.memory, allocation.offset) != VK_SUCCESS) {
+    free(allocation);
+    throw std::runtime_error("failed to bind buffer memory!");
+  }
+
+  return allocation;
+}
+
+MemoryAllocator::Allocation MemoryAllocator::allocateImage(VkImage image,
+                                                           VkMemoryPropertyFlags properties,
+                                                           MemoryCategory category) {
+  VkMemoryRequirements requirements;
+  vkGetImageMemoryRequirements(m_device.logical(), image, &requirements);
+
+  const Allocation allocation = allocate(requirements, properties, category, true);
+  if (vkBindImageMemory(m_device.logical(), image, allocation.memory, allocation.offset) != VK_SUCCESS) {
+    free(allocation);
+    throw std::runtime_error("failed to bind image memory!");
+  }
+
+  return allocation;
+}
+
+MemoryAllocator::Allocation MemoryAllocator::allocate(const VkMemoryRequirements& requirements,
+                                                      VkMemoryPropertyFlags properties,
+                                                      MemoryCategory category,
+                                                      bool image) {
+  const uint32_t type = memoryType(requirements.memoryTypeBits, properties);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  const VkDeviceSize size = blockSize(type);
+  if (requirements.size > size / 2) {
+    m_dedicated.push_back(createBlock(type, Dedicated, requirements.size));
+    Block& block                = *m_dedicated.back();
+    const Allocation allocation = {block.memory, 0, requirements.size, &block, Tlsf::Invalid, block.mapped, category};
+    count(allocation);
+    return allocation;
+  }
+
+  const uint32_t poolIndex                   = 2 * type + (image ? 1 : 0);
+  std::vector<std::unique_ptr<Block>>& pool = m_pools[poolIndex];
+  for (const std::unique_ptr<Block>& block : pool) {
+    const Tlsf::Allocation range = block->ranges.allocate(requirements.size, requirements.alignment);
+    if (range.node != Tlsf::Invalid) {
+      const Allocation allocation = {block->memory, range.offset, range.size, block.get(), range.node,
+                                     mappedAt(*block, range.offset), category};
+      count(allocation);
+      return allocation;
+    }
+  }
+
+  // At most half a block with its alignment, a new one always fits it
+  pool.push_back(createBlock(type, poolIndex, size));
+  Block& block                 = *pool.back();
+  const Tlsf::Allocation range = block.ranges.allocate(requirements.size, requirements.alignment);
+  const Allocation allocation  = {block.memory, range.offset, range.size, &block, range.node,
+                                  mappedAt(block, range.offset), category};
+  count(allocation);
+  return allocation;
+}
+
+void MemoryAllocator::free(const Allocation& allocation) {
+  if (allocation.block == nullptr) return;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  uncount(allocation);
+
+  Block* block = allocation.block;
+  if (block->pool == Dedicated) {
+    const auto found = std::find_if(m_dedicated.begin(), m_dedicated.end(),
+                                    [block](const std::unique_ptr<Block>& other) { return other.get() == block; });
+    destroyBlock(*block);
+    m_dedicated.erase(found);
+    return;
+  }
+
+  block->ranges.free(allocation.node);
+
+  // The last block of a pool stays, so that a buffer recreated each frame doesn't allocate each time
+  std::vector<std::unique_ptr<Block>>& pool = m_pools[block->pool];
+  if (block->ranges.empty() && pool.size() > 1) {
+    const auto found = std::find_if(pool.begin(), pool.end(),
+                                    [block](const std::unique_ptr<Block>& other) { return other.get() == block; });
+    destroyBlock(*block);
+    pool.erase(found);
+  }
+}
+
+void MemoryAllocator::flush(const Allocation& allocation, VkDeviceSize offset, VkDeviceSize size) const {
+  if (allocation.block == nullptr || allocation.block->coherent) return;
+
+  // The range is widened to whole atoms, which the block may end before
+  const VkDeviceSize atom  = m_device.limits().nonCoherentAtomSize;
+  const VkDeviceSize first = allocation.offset + offset;
+  const VkDeviceSize last  = allocation.offset + (size == VK_WHOLE_SIZE ? allocation.size : offset + size);
+  const VkDeviceSize begin = first / atom * atom;
+  const VkDeviceSize end   = (last + atom - 1) / atom * atom;
+
+  const VkMappedMemoryRange range = {
+      .sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
+      .memory = allocation.memory,
+      .offset = begin,
+      .size   = end >= allocation.block->ranges.size() ? VK_WHOLE_SIZE : end - begin,
+  };
+
+  if (vkFlushMappedMemoryRanges(m_device.logical(), 1, &range) != VK_SUCCESS) {
+    throw std::runtime_error("failed to flush mapped memory!");
+  }
+}
+
+std::vector<MemoryAllocator::HeapStats> MemoryAllocator::stats() const {
+  std::vector<HeapStats> heaps;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    heaps = m_heaps;
+  }
+
+  if (!m_device.memoryBudget()) return heaps;
+
+  // Queried each time, the driver updates it as this and other processes allocate
+  VkPhysicalDeviceMemoryBudgetPropertiesEXT budget = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT,
+  };
+  VkPhysicalDeviceMemoryProperties2 properties = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2,
+      .pNext = &budget,
+  };
+  vkGetPhysicalDeviceMemoryProperties2(m_device.physical(), &properties);
+
+  for (size_t i = 0; i < heaps.size(); i++) {
+    heaps[i].budget = budget.heapBudget[i];
+    heaps[i].usage  = budget.heapUsage[i];
+  }
+
+  return heaps;
+}
+
+void MemoryAllocator::writeStats(std::ostream& out) const {
+  WriteMemoryStats(out, stats());
+}
+
+MemoryAllocator::HeapStats& MemoryAllocator::heap(const Block& block) {
+  return m_heaps[m_properties.memoryTypes[block.memoryType].heapIndex];
+}
+
+void MemoryAllocator::count(const Allocation& allocation) {
+  HeapStats& stats = heap(*allocation.block);
+  stats.allocations++;
+  stats.used     += allocation.size;
+  stats.peakUsed  = std::max(stats.peakUsed, stats.used);
+
+  MemoryCategoryStats& category = stats.category(allocation.category);
+  category.allocations++;
+  category.used += allocation.size;
+  category.peak  = std::max(category.peak, category.used);
+}
+
+void MemoryAllocator::uncount(const Allocation& allocation) {
+  HeapStats& stats = heap(*allocation.block);
+  stats.allocations--;
+  stats.used -= allocation.size;
+
+  MemoryCategoryStats& category = stats.category(allocation.category);
+  category.allocations--;
+  category.used -= allocation.size;
+}
+
+uint32_t MemoryAllocator::memoryType(uint32_t typeBits, VkMemoryPropertyFlags properties) const {
+  for (uint32_t i = 0; i < m_properties.memoryTypeCount; i++) {
+    if ((typeBits & (1 << i)) && (m_properties.memoryTypes[i].propertyFlags & properties) == properties) return i;
+  }
+
+  throw std::runtime_error("failed to find a suitable memory type!");
+}
+
+VkDeviceSize MemoryAllocator::blockSize(uint32_t memoryType) const {
+  const VkDeviceSize heapSize = m_properties.memoryHeaps[m_properties.memoryTypes[memoryType].heapIndex].size;
+  return std::min(m_blockSize, heapSize / 8);
+}
+
+std::unique_ptr<MemoryAllocator::Block> MemoryAllocator::createBlock(uint32_t memoryType,
+                                                                     uint32_t pool,
+                                                                     VkDeviceSize size) {
+  const VkMemoryAllocateInfo allocInfo = {
+      .sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+      .allocationSize  = size,
+      .memoryTypeIndex = memoryType,
+  };
+
+  VkDeviceMemory memory;
+  if (vkAllocateMemory(m_device.logical(), &allocInfo, nullptr, &memory) != VK_SUCCESS) {
+    throw std::runtime_error("failed to allocate device memory!");
+  }
+
+  // Mapped for the life of the block, its ranges write through the pointer
+  const VkMemoryPropertyFlags flags = m_properties.memoryTypes[memoryType].propertyFlags;
+  void* mapped                      = nullptr;
+  if ((flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+      && vkMapMemory(m_device.logical(), memory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS) {
+    vkFreeMemory(m_device.logical(), memory, nullptr);
+    throw std::runtime_error("failed to map device memory!");
+  }
+
+  std::unique_ptr<Block> block(new Block{memory, memoryType, pool, Tlsf(size), static_cast<uint8_t*>(mapped),
+                                         (flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0});
+
+  HeapStats& stats = heap(*block);
+  stats.blocks++;
+  stats.reserved     += size;
+  stats.peakReserved  = std::max(stats.peakReserved, stats.reserved);
+
+  return block;
+}
+
+void MemoryAllocator::destroyBlock(const Block& block) {
+  HeapStats& stats = heap(block);
+  stats.blocks--;
+  stats.reserved -= block.ranges.size();
+
+  if (block.mapped) vkUnmapMemory(m_device.logical(), block.memory);
+  vkFreeMemory(m_device.logical(), block.memory, nullptr);
+}
@@ -0,0 +1,66 @@
+// clang-format off
+#include <common/memory/MemoryStats.hpp>
+#include <ostream>  // for operator<<, ostream, basic_ostream
+// clang-format on
+
+using namespace vkl;
+
+namespace {
+
+  void writeBytes(std::ostream& out, VkDeviceSize bytes, bool known) {
+    if (known) {
+      out << bytes;
+    } else {
+      out << "null";
+    }
+  }
+
+}  // namespace
+
+const char* vkl::MemoryCategoryName(MemoryCategory category) {
+  switch (category) {
+    case MemoryCategory::Vertex: return "vertex";
+    case MemoryCategory::Texture: return "texture";
+    case MemoryCategory::Attachment: return "attachment";
+    case MemoryCategory::Uniform: return "uniform";
+    case MemoryCategory::Staging: return "staging";
+    case MemoryCategory::Particles: return "particles";
+    case MemoryCategory::Grid: return "grid";
+    case MemoryCategory::Other: return "other";
+  }
+  return "other";
+}
+
+void vkl::WriteMemoryStats(std::ostream& out, const std::vector<MemoryHeapStats>& heaps) {
+  out << "{\n  \"heaps\": [";
+  for (size_t i = 0; i < heaps.size(); i++) {
+    const MemoryHeapStats& heap = heaps[i];
+    // The extension reports a budget for every heap, none means it is missing
+    const bool budget = heap.budget > 0;
+
+    out << (i == 0 ? "\n" : ",\n") << "    {\n"
+        << "      \"index\": " << i << ",\n"
+        << "      \"size\": " << heap.size << ",\n"
+        << "      \"deviceLocal\": " << (heap.deviceLocal ? "true" : "false") << ",\n"
+        << "      \"blocks\": " << heap.blocks << ",\n"
+        << "      \"allocations\": " << heap.allocations << ",\n"
+        << "      \"reserved\": " << heap.reserved << ",\n"
+        << "      \"used\": " << heap.used << ",\n"
+        << "      \"peakReserved\": " << heap.peakReserved << ",\n"
+        << "      \"peakUsed\": " << heap.peakUsed << ",\n"
+        << "      \"budget\": ";
+    writeBytes(out, heap.budget, budget);
+    out << ",\n      \"usage\": ";
+    writeBytes(out, heap.usage, budget);
+    out << ",\n      \"categories\": {";
+
+    for (size_t c = 0; c < MemoryCategoryCount; c++) {
+      const MemoryCategoryStats& category = heap.categories[c];
+      out << (c == 0 ? "\n" : ",\n") << "        \"" << MemoryCategoryName(static_cast<MemoryCategory>(c))
+          << "\": {\"allocations\": " << category.allocations << ", \"used\": " << category.used
+          << ", \"peak\": " << category.peak << "}";
+    }
+    out << "\n      }\n    }";
+  }
+  out << (heaps.empty() ? "]\n}\n" : "\n  ]\n}\n");
+}
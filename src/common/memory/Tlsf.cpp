@@ -0,0 +1,159 @@
+// clang-format off
+#include <common/memory/Tlsf.hpp>
+#include <algorithm>  // for max
+#include <bit>        // for bit_width, countr_zero
+// clang-format on
+
+using namespace vkl;
+
+Tlsf::Tlsf(uint64_t size) : m_size(size) {
+  for (std::array<uint32_t, SecondLevelCount>& heads : m_heads) heads.fill(Invalid);
+
+  // A single free range, the whole block
+  const uint32_t node = newNode();
+  m_nodes[node]       = {0, size, Invalid, Invalid, Invalid, Invalid, true};
+  if (size > 0) insertFree(node);
+}
+
+Tlsf::Allocation Tlsf::allocate(uint64_t size, uint64_t alignment) {
+  size = std::max<uint64_t>(size, 1);
+
+  // Enough for the padding wherever the range starts
+  uint32_t node = findFree(size + alignment - 1);
+  if (node == Invalid) return {0, 0, Invalid};
+  removeFree(node);
+
+  const uint64_t offset = (m_nodes[node].offset + alignment - 1) & ~(alignment - 1);
+  if (offset > m_nodes[node].offset) {
+    const uint32_t padding = node;
+    node                   = split(padding, offset - m_nodes[padding].offset);
+    insertFree(padding);
+  }
+  if (m_nodes[node].size > size) insertFree(split(node, size));
+
+  m_nodes[node].free = false;
+  m_used += size;
+  m_count++;
+
+  return {offset, size, node};
+}
+
+void Tlsf::free(uint32_t node) {
+  m_used -= m_nodes[node].size;
+  m_count--;
+  m_nodes[node].free = true;
+
+  // The neighbours, if free, are merged into the range
+  const uint32_t next = m_nodes[node].nextPhysical;
+  if (next != Invalid && m_nodes[next].free) {
+    removeFree(next);
+    m_nodes[node].size += m_nodes[next].size;
+    m_nodes[node].nextPhysical = m_nodes[next].nextPhysical;
+    if (m_nodes[next].nextPhysical != Invalid) m_nodes[m_nodes[next].nextPhysical].prevPhysical = node;
+    m_unused.push_back(next);
+  }
+
+  const uint32_t prev = m_nodes[node].prevPhysical;
+  if (prev != Invalid && m_nodes[prev].free) {
+    removeFree(prev);
+    m_nodes[prev].size += m_nodes[node].size;
+    m_nodes[prev].nextPhysical = m_nodes[node].nextPhysical;
+    if (m_nodes[node].nextPhysical != Invalid) m_nodes[m_nodes[node].nextPhysical].prevPhysical = prev;
+    m_unused.push_back(node);
+    node = prev;
+  }
+
+  insertFree(node);
+}
+
+void Tlsf::Mapping(uint64_t size, uint32_t& firstLevel, uint32_t& secondLevel) {
+  if (size < SecondLevelCount) {
+    firstLevel  = 0;
+    secondLevel = static_cast<uint32_t>(size);
+    return;
+  }
+
+  const uint32_t log2 = static_cast<uint32_t>(std::bit_width(size)) - 1;
+  firstLevel          = log2 - SecondLevelLog2 + 1;
+  secondLevel         = static_cast<uint32_t>(size >> (log2 - SecondLevelLog2)) - SecondLevelCount;
+}
+
+uint32_t Tlsf::findFree(uint64_t size) const {
+  // Rounded up to the next class, so that any range of the class found fits
+  if (size >= SecondLevelCount) {
+    const uint32_t log2 = static_cast<uint32_t>(std::bit_width(size)) - 1;
+    size += (uint64_t(1) << (log2 - SecondLevelLog2)) - 1;
+  }
+
+  uint32_t firstLevel, secondLevel;
+  Mapping(size, firstLevel, secondLevel);
+  if (firstLevel >= FirstLevelCount) return Invalid;
+
+  uint32_t secondMap = m_secondLevel[firstLevel] & (~0u << secondLevel);
+  if (secondMap == 0) {
+    // The larger classes start at the next first level
+    const uint64_t firstMap = firstLevel + 1 < 64 ? m_firstLevel & (~uint64_t(0) << (firstLevel + 1)) : 0;
+    if (firstMap == 0) return Invalid;
+
+    firstLevel = static_cast<uint32_t>(std::countr_zero(firstMap));
+    secondMap  = m_secondLevel[firstLevel];
+  }
+
+  return m_heads[firstLevel][std::countr_zero(secondMap)];
+}
+
+void Tlsf::insertFree(uint32_t node) {
+  uint32_t firstLevel, secondLevel;
+  Mapping(m_nodes[node].size, firstLevel, secondLevel);
+
+  uint32_t& head          = m_heads[firstLevel][secondLevel];
+  m_nodes[node].free      = true;
+  m_nodes[node].prevFree  = Invalid;
+  m_nodes[node].nextFree  = head;
+  if (head != Invalid) m_nodes[head].prevFree = node;
+  head = node;
+
+  m_secondLevel[firstLevel] |= 1u << secondLevel;
+  m_firstLevel |= uint64_t(1) << firstLevel;
+}
+
+void Tlsf::removeFree(uint32_t node) {
+  uint32_t firstLevel, secondLevel;
+  Mapping(m_nodes[node].size, firstLevel, secondLevel);
+
+  const Node& removed = m_nodes[node];
+  if (removed.prevFree != Invalid) m_nodes[removed.prevFree].nextFree = removed.nextFree;
+  if (removed.nextFree != Invalid) m_nodes[removed.nextFree].prevFree = removed.prevFree;
+
+  uint32_t& head = m_heads[firstLevel][secondLevel];
+  if (head == node) {
+    head = removed.nextFree;
+    if (head == Invalid) {
+      m_secondLevel[firstLevel] &= ~(1u << secondLevel);
+      if (m_secondLevel[firstLevel] == 0) m_firstLevel &= ~(uint64_t(1) << firstLevel);
+    }
+  }
+}
+
+uint32_t Tlsf::split(uint32_t node, uint64_t size) {
+  const uint32_t rest = newNode();
+
+  Node& front = m_nodes[node];
+  m_nodes[rest] = {front.offset + size, front.size - size, node, front.nextPhysical, Invalid, Invalid, false};
+  if (front.nextPhysical != Invalid) m_nodes[front.nextPhysical].prevPhysical = rest;
+  front.nextPhysical = rest;
+  front.size         = size;
+
+  return rest;
+}
+
+uint32_t Tlsf::newNode() {
+  if (!m_unused.empty()) {
+    const uint32_t node = m_unused.back();
+    m_unused.pop_back();
+    return node;
+  }
+
+  m_nodes.emplace_back();
+  return static_cast<uint32_t>(m_nodes.size() - 1);
+}
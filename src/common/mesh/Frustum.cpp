@@ -0,0 +1,35 @@
+// clang-format off
+#include <common/mesh/Frustum.hpp>
+#include <glm/glm.hpp>               // for vec4, dot, length
+// clang-format on
+
+using namespace vkl;
+
+mesh::Frustum mesh::extractFrustum(const glm::mat4& viewProj) {
+  // Gribb & Hartmann : the rows of the matrix, glm stores its columns
+  const glm::mat4 m = glm::transpose(viewProj);
+
+  Frustum frustum = {{
+      m[3] + m[0],  // left
+      m[3] - m[0],  // right
+      m[3] + m[1],  // bottom (top with a flipped y)
+      m[3] - m[1],  // top
+      m[3] + m[2],  // near
+      m[3] - m[2],  // far
+  }};
+
+  for (glm::vec4& plane : frustum.planes) plane /= glm::length(glm::vec3(plane));
+
+  return frustum;
+}
+
+bool mesh::intersects(const Frustum& frustum, const glm::vec3& min, const glm::vec3& max) {
+  for (const glm::vec4& plane : frustum.planes) {
+    // The corner furthest along the normal of the plane
+    const glm::vec3 corner = glm::vec3(plane.x >= 0.0f ? max.x : min.x, plane.y >= 0.0f ? max.y : min.y,
+                                       plane.z >= 0.0f ? max.z : min.z);
+    if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f) return false;
+  }
+
+  return true;
+}
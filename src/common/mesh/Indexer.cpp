@@ -0,0 +1,57 @@
+// clang-format off
+#include <common/mesh/Indexer.hpp>
+#include <cstring>                   // for memcmp, memcpy
+// clang-format on
+
+using namespace vkl;
+
+namespace {
+
+  constexpr uint32_t kEmpty = UINT32_MAX;
+
+  // Vertex is only made of floats, so it has no padding and can be hashed / compared as raw words
+  static_assert(sizeof(Vertex) % sizeof(uint32_t) == 0);
+
+  inline uint64_t hashVertex(const Vertex& vertex) {
+    uint32_t words[sizeof(Vertex) / sizeof(uint32_t)];
+    std::memcpy(words, &vertex, sizeof(Vertex));
+
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (uint32_t word : words) {
+      h = (h ^ word) * 0x100000001b3ull;
+      h ^= h >> 29;
+    }
+    return h;
+  }
+
+}  // namespace
+
+void mesh::indexVertices(const std::vector<Vertex>& corners,
+                         std::vector<Vertex>& vertices,
+                         std::vector<uint32_t>& indices) {
+  vertices.clear();
+  indices.resize(corners.size());
+
+  // Open addressing with linear probing, kept at most half full
+  size_t capacity = 16;
+  while (capacity < corners.size() * 2) capacity *= 2;
+  const size_t mask = capacity - 1;
+
+  std::vector<uint32_t> table(capacity, kEmpty);
+
+  for (size_t i = 0; i < corners.size(); ++i) {
+    const Vertex& corner = corners[i];
+
+    size_t slot = hashVertex(corner) & mask;
+    while (table[slot] != kEmpty && std::memcmp(&vertices[table[slot]], &corner, sizeof(Vertex)) != 0) {
+      slot = (slot + 1) & mask;
+    }
+
+    if (table[slot] == kEmpty) {
+      table[slot] = static_cast<uint32_t>(vertices.size());
+      vertices.push_back(corner);
+    }
+
+    indices[i] = table[slot];
+  }
+}
@@ -0,0 +1,73 @@
+// clang-format off
+#include <common/mesh/Lod.hpp>
+#include <algorithm>                 // for max
+#include <cmath>                     // for tan
+#include <common/mesh/Simplify.hpp>  // for simplifyLevels, SimplifiedMesh
+// clang-format on
+
+using namespace vkl;
+
+mesh::LodChain mesh::buildLodChain(const MeshData& mesh, const std::vector<float>& ratios) {
+  LodChain chain;
+  chain.indices     = mesh.indices;
+  chain.materialIds = mesh.materialIds;
+  chain.materialIds.resize(mesh.indices.size() / 3, -1);
+  chain.levels.push_back({0, static_cast<uint32_t>(mesh.indices.size()), 0.0f});
+
+  glm::vec3 boxMin(0.0f), boxMax(0.0f);
+  for (size_t v = 0; v < mesh.vertices.size(); ++v) {
+    boxMin = (v == 0) ? mesh.vertices[v].pos : glm::min(boxMin, mesh.vertices[v].pos);
+    boxMax = (v == 0) ? mesh.vertices[v].pos : glm::max(boxMax, mesh.vertices[v].pos);
+  }
+  chain.center = (boxMin + boxMax) * 0.5f;
+  chain.radius = 0.0f;
+  for (const Vertex& vertex : mesh.vertices) {
+    chain.radius = std::max(chain.radius, glm::length(vertex.pos - chain.center));
+  }
+
+  std::vector<size_t> targets;
+  for (float ratio : ratios) targets.push_back(static_cast<size_t>(mesh.indices.size() / 3 * ratio) * 3);
+
+  const float maxError = chain.radius * LodMaxRelativeError;
+  if (!targets.empty()) {
+    for (SimplifiedMesh& level : simplifyLevels(mesh.indices, mesh.vertices, mesh.materialIds, targets, maxError)) {
+      if (level.indices.empty() || level.indices.size() >= chain.levels.back().indexCount) continue;
+
+      chain.levels.push_back(
+          {static_cast<uint32_t>(chain.indices.size()), static_cast<uint32_t>(level.indices.size()), level.error});
+      chain.indices.insert(chain.indices.end(), level.indices.begin(), level.indices.end());
+      for (uint32_t source : level.sources) chain.materialIds.push_back(chain.materialIds[source]);
+    }
+  }
+
+  // One draw per material and per level; the full mesh is usually grouped already, by splitMeshlets
+  for (LodLevel& level : chain.levels) {
+    const std::vector<MaterialRange> ranges =
+        sortByMaterial(chain.indices, chain.materialIds, level.firstIndex, level.indexCount);
+    level.firstRange = static_cast<uint32_t>(chain.ranges.size());
+    level.rangeCount = static_cast<uint32_t>(ranges.size());
+    chain.ranges.insert(chain.ranges.end(), ranges.begin(), ranges.end());
+  }
+
+  return chain;
+}
+
+float mesh::projectedError(float error, float distance, float viewportHeight, float fovy) {
+  return error / std::max(distance, 1e-4f) * viewportHeight / (2.0f * std::tan(fovy * 0.5f));
+}
+
+size_t mesh::selectLod(const LodChain& chain,
+                       const glm::vec3& viewer,
+                       float viewportHeight,
+                       float fovy,
+                       float maxPixelError) {
+  // The closest point of the bounding sphere : the error is never underestimated
+  const float distance = glm::length(viewer - chain.center) - chain.radius;
+
+  size_t level = 0;
+  while (level + 1 < chain.levels.size()
+         && projectedError(chain.levels[level + 1].error, distance, viewportHeight, fovy) <= maxPixelError) {
+    ++level;
+  }
+  return level;
+}
@@ -0,0 +1,45 @@
+// clang-format off
+#include <common/mesh/MaterialRange.hpp>
+#include <algorithm>                  // for stable_sort
+#include <numeric>                    // for iota
+// clang-format on
+
+using namespace vkl;
+
+std::vector<mesh::MaterialRange> mesh::sortByMaterial(std::vector<uint32_t>& indices,
+                                                      std::vector<int>& materialIds,
+                                                      uint32_t firstIndex,
+                                                      uint32_t indexCount) {
+  std::vector<MaterialRange> ranges;
+  if (indexCount == 0) return ranges;
+
+  if (materialIds.size() * 3 != indices.size()) {
+    ranges.push_back({firstIndex, indexCount, -1});
+    return ranges;
+  }
+
+  const uint32_t firstTriangle = firstIndex / 3;
+  const uint32_t triangleCount = indexCount / 3;
+
+  std::vector<uint32_t> order(triangleCount);
+  std::iota(order.begin(), order.end(), firstTriangle);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](uint32_t a, uint32_t b) { return materialIds[a] < materialIds[b]; });
+
+  const std::vector<uint32_t> sourceIndices(indices.begin() + firstIndex, indices.begin() + firstIndex + indexCount);
+  const std::vector<int> sourceMaterials(materialIds.begin() + firstTriangle,
+                                         materialIds.begin() + firstTriangle + triangleCount);
+
+  for (uint32_t t = 0; t < triangleCount; ++t) {
+    const uint32_t source = order[t] - firstTriangle;
+    for (uint32_t k = 0; k < 3; ++k) indices[firstIndex + t * 3 + k] = sourceIndices[source * 3 + k];
+    materialIds[firstTriangle + t] = sourceMaterials[source];
+
+    if (ranges.empty() || ranges.back().materialId != materialIds[firstTriangle + t]) {
+      ranges.push_back({firstIndex + t * 3, 0, materialIds[firstTriangle + t]});
+    }
+    ranges.back().indexCount += 3;
+  }
+
+  return ranges;
+}
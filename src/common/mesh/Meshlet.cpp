@@ -0,0 +1,341 @@
+// clang-format off
+#include <common/mesh/Meshlet.hpp>
+#include <algorithm>                  // for min
+#include <array>                      // for array
+#include <cmath>                      // for sqrt
+#include <limits>                     // for numeric_limits
+#include <map>                        // for map
+#include <stdexcept>                  // for runtime_error
+#include <common/mesh/Adjacency.hpp>  // for TriangleAdjacency, positionRemap
+#include <common/mesh/MaterialRange.hpp>  // for sortByMaterial, MaterialRange
+#include <common/mesh/Optimize.hpp>   // for vertexCacheOrder
+// clang-format on
+
+using namespace vkl;
+
+namespace {
+
+  // Same triangle, same winding, whatever its first corner
+  std::array<uint32_t, 3> canonicalTriangle(uint32_t a, uint32_t b, uint32_t c) {
+    return std::min({std::array<uint32_t, 3>{a, b, c}, {b, c, a}, {c, a, b}});
+  }
+
+}  // namespace
+
+mesh::Meshlets mesh::buildMeshlets(const std::vector<uint32_t>& indices,
+                                   const std::vector<Vertex>& vertices,
+                                   uint32_t maxVertices,
+                                   uint32_t maxTriangles,
+                                   std::vector<uint32_t>* triangleOrder) {
+  // Local indices are stored on 8 bits
+  if (maxVertices < 3 || maxVertices > 256 || maxTriangles == 0) {
+    throw std::runtime_error("invalid meshlet limits");
+  }
+
+  const size_t triangleCount = indices.size() / 3;
+
+  // Neighbourhood is by position, the limits are on the vertices
+  const std::vector<uint32_t> positions = positionRemap(vertices);
+  std::vector<uint32_t> positionIndices(indices.size());
+  for (size_t i = 0; i < indices.size(); ++i) positionIndices[i] = positions[indices[i]];
+
+  const TriangleAdjacency adjacency(positionIndices, vertices.size());
+
+  std::vector<uint32_t> live(vertices.size());
+  for (size_t v = 0; v < vertices.size(); ++v) live[v] = adjacency.valence(static_cast<uint32_t>(v));
+
+  std::vector<bool> emitted(triangleCount, false);
+  std::vector<uint32_t> local(vertices.size(), UINT32_MAX);  // index in the current meshlet
+
+  Meshlets result;
+  Meshlet current = {0, 0, 0, 0};
+  glm::vec3 centroidSum(0.0f);
+  glm::vec3 boxMin(0.0f), boxMax(0.0f);
+
+  if (triangleOrder != nullptr) triangleOrder->clear();
+
+  auto centroid = [&](size_t triangle) {
+    return (vertices[indices[triangle * 3]].pos + vertices[indices[triangle * 3 + 1]].pos
+            + vertices[indices[triangle * 3 + 2]].pos)
+           / 3.0f;
+  };
+
+  auto newVertexCount = [&](size_t triangle) {
+    const uint32_t a = indices[triangle * 3], b = indices[triangle * 3 + 1], c = indices[triangle * 3 + 2];
+    return uint32_t(local[a] == UINT32_MAX) + uint32_t(local[b] == UINT32_MAX && b != a)
+           + uint32_t(local[c] == UINT32_MAX && c != a && c != b);
+  };
+
+  auto add = [&](size_t triangle) {
+    for (int k = 0; k < 3; ++k) {
+      const uint32_t vertex = indices[triangle * 3 + k];
+      if (local[vertex] == UINT32_MAX) {
+        local[vertex] = current.vertexCount++;
+        result.vertices.push_back(vertex);
+      }
+      result.triangles.push_back(static_cast<uint8_t>(local[vertex]));
+      --live[positions[vertex]];
+
+      const glm::vec3& pos = vertices[vertex].pos;
+      if (current.triangleCount == 0 && k == 0) boxMin = boxMax = pos;
+      boxMin = glm::min(boxMin, pos);
+      boxMax = glm::max(boxMax, pos);
+    }
+
+    emitted[triangle] = true;
+    ++current.triangleCount;
+    centroidSum += centroid(triangle);
+    if (triangleOrder != nullptr) triangleOrder->push_back(static_cast<uint32_t>(triangle));
+  };
+
+  auto finish = [&]() {
+    if (current.triangleCount == 0) return;
+
+    std::vector<uint32_t> meshletIndices(current.triangleCount * 3);
+    for (size_t i = 0; i < meshletIndices.size(); ++i) {
+      const uint32_t vertex = result.vertices[current.vertexOffset + result.triangles[current.triangleOffset * 3 + i]];
+      meshletIndices[i]     = vertex;
+      local[vertex]         = UINT32_MAX;
+    }
+
+    result.meshlets.push_back(current);
+    result.bounds.push_back(computeBounds(meshletIndices.data(), meshletIndices.size(), vertices));
+
+    current = {
+        .vertexOffset   = static_cast<uint32_t>(result.vertices.size()),
+        .triangleOffset = static_cast<uint32_t>(result.triangles.size() / 3),
+        .vertexCount    = 0,
+        .triangleCount  = 0,
+    };
+    centroidSum = glm::vec3(0.0f);
+  };
+
+  size_t cursor = 0;
+  for (;;) {
+    // Among the live triangles around the meshlet, the one needing the fewest new vertices, then the closest
+    int64_t best       = -1;
+    uint32_t bestNew   = 4;
+    float bestDistance = std::numeric_limits<float>::max();
+
+    if (current.triangleCount > 0) {
+      const glm::vec3 center = centroidSum / static_cast<float>(current.triangleCount);
+
+      for (uint32_t i = current.vertexOffset; i < result.vertices.size(); ++i) {
+        const uint32_t position = positions[result.vertices[i]];
+        if (live[position] == 0) continue;
+
+        for (uint32_t a = adjacency.offsets[position]; a < adjacency.offsets[position + 1]; ++a) {
+          const uint32_t triangle = adjacency.triangles[a];
+          if (emitted[triangle]) continue;
+
+          const uint32_t extra = newVertexCount(triangle);
+          if (current.vertexCount + extra > maxVertices || extra > bestNew) continue;
+
+          const glm::vec3 offset = centroid(triangle) - center;
+          const float distance   = glm::dot(offset, offset);
+          if (extra < bestNew || distance < bestDistance) {
+            best         = triangle;
+            bestNew      = extra;
+            bestDistance = distance;
+          }
+        }
+      }
+    }
+
+    // Nothing connected : take the next triangle in input order, if it lies near the meshlet (triangle soups, several
+    // parts touching each other ...)
+    if (best < 0) {
+      while (cursor < triangleCount && emitted[cursor]) ++cursor;
+      if (cursor == triangleCount) break;
+
+      if (current.triangleCount > 0) {
+        const glm::vec3 margin(glm::length(boxMax - boxMin) * 0.5f);
+        bool near = current.vertexCount + newVertexCount(cursor) <= maxVertices;
+        for (int k = 0; k < 3 && near; ++k) {
+          const glm::vec3& pos = vertices[indices[cursor * 3 + k]].pos;
+          near = pos.x >= boxMin.x - margin.x && pos.y >= boxMin.y - margin.y && pos.z >= boxMin.z - margin.z
+                 && pos.x <= boxMax.x + margin.x && pos.y <= boxMax.y + margin.y && pos.z <= boxMax.z + margin.z;
+        }
+
+        if (!near) {
+          finish();
+          continue;
+        }
+      }
+
+      best = static_cast<int64_t>(cursor);
+    }
+
+    add(static_cast<size_t>(best));
+    if (current.triangleCount == maxTriangles) finish();
+  }
+
+  finish();
+  return result;
+}
+
+mesh::Meshlets mesh::splitMeshlets(MeshData& mesh, uint32_t maxVertices, uint32_t maxTriangles) {
+  // A meshlet never mixes materials, so the triangles of a material stay contiguous
+  const std::vector<MaterialRange> ranges =
+      sortByMaterial(mesh.indices, mesh.materialIds, 0, static_cast<uint32_t>(mesh.indices.size()));
+
+  Meshlets meshlets;
+  for (const MaterialRange& range : ranges) {
+    const std::vector<uint32_t> indices(mesh.indices.begin() + range.firstIndex,
+                                        mesh.indices.begin() + range.firstIndex + range.indexCount);
+    const Meshlets group = buildMeshlets(indices, mesh.vertices, maxVertices, maxTriangles);
+
+    const uint32_t vertexOffset   = static_cast<uint32_t>(meshlets.vertices.size());
+    const uint32_t triangleOffset = range.firstIndex / 3;
+    for (Meshlet meshlet : group.meshlets) {
+      meshlet.vertexOffset += vertexOffset;
+      meshlet.triangleOffset += triangleOffset;
+      meshlets.meshlets.push_back(meshlet);
+    }
+    meshlets.bounds.insert(meshlets.bounds.end(), group.bounds.begin(), group.bounds.end());
+    meshlets.vertices.insert(meshlets.vertices.end(), group.vertices.begin(), group.vertices.end());
+    meshlets.triangles.insert(meshlets.triangles.end(), group.triangles.begin(), group.triangles.end());
+  }
+
+  // The greedy growth visits the triangles in no cache friendly order, Tipsify them inside each meshlet
+  for (const Meshlet& meshlet : meshlets.meshlets) {
+    uint8_t* triangles = meshlets.triangles.data() + meshlet.triangleOffset * 3;
+    const std::vector<uint32_t> local(triangles, triangles + meshlet.triangleCount * 3);
+    const std::vector<uint32_t> order = vertexCacheOrder(local, meshlet.vertexCount);
+    for (uint32_t t = 0; t < meshlet.triangleCount; ++t) {
+      for (uint32_t k = 0; k < 3; ++k) triangles[t * 3 + k] = static_cast<uint8_t>(local[order[t] * 3 + k]);
+    }
+  }
+
+  // Triangles of the meshlets are contiguous, the index buffer can be drawn meshlet by meshlet
+  for (const Meshlet& meshlet : meshlets.meshlets) {
+    for (uint32_t i = 0; i < meshlet.triangleCount * 3; ++i) {
+      const uint32_t corner = meshlet.triangleOffset * 3 + i;
+      mesh.indices[corner]  = meshlets.vertices[meshlet.vertexOffset + meshlets.triangles[corner]];
+    }
+  }
+
+  return meshlets;
+}
+
+mesh::MeshletBounds mesh::computeBounds(const uint32_t* indices, size_t indexCount, const std::vector<Vertex>& vertices) {
+  MeshletBounds bounds = {glm::vec3(0.0f), 0.0f, glm::vec3(0.0f), 1.0f};
+  if (indexCount == 0) return bounds;
+
+  // Sphere around the bounding box, not the tightest but cheap and stable
+  glm::vec3 boxMin = vertices[indices[0]].pos, boxMax = boxMin;
+  for (size_t i = 1; i < indexCount; ++i) {
+    boxMin = glm::min(boxMin, vertices[indices[i]].pos);
+    boxMax = glm::max(boxMax, vertices[indices[i]].pos);
+  }
+
+  bounds.center = (boxMin + boxMax) * 0.5f;
+  for (size_t i = 0; i < indexCount; ++i) {
+    bounds.radius = glm::max(bounds.radius, glm::length(vertices[indices[i]].pos - bounds.center));
+  }
+
+  // Cone around the face normals
+  std::vector<glm::vec3> normals;
+  normals.reserve(indexCount / 3);
+  glm::vec3 sum(0.0f);
+
+  for (size_t i = 0; i + 2 < indexCount; i += 3) {
+    const glm::vec3& p0 = vertices[indices[i]].pos;
+    const glm::vec3 normal = glm::cross(vertices[indices[i + 1]].pos - p0, vertices[indices[i + 2]].pos - p0);
+    const float length     = glm::length(normal);
+    if (length == 0.0f) continue;
+
+    normals.push_back(normal / length);
+    sum += normals.back();
+  }
+
+  const float sumLength = glm::length(sum);
+  if (normals.empty() || sumLength == 0.0f) return bounds;
+
+  const glm::vec3 axis = sum / sumLength;
+  float minDot         = 1.0f;
+  for (const glm::vec3& normal : normals) minDot = glm::min(minDot, glm::dot(normal, axis));
+
+  // Past ~85 degrees the cone can almost never reject the meshlet
+  if (minDot <= 0.1f) return bounds;
+
+  // The normals are within acos(minDot) of the axis, the meshlet is backfacing from the directions within
+  // 90 - acos(minDot) of it : cos(90 - a) = sin(a)
+  bounds.coneAxis   = axis;
+  bounds.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+  return bounds;
+}
+
+bool mesh::validateMeshlets(const Meshlets& meshlets,
+                            const std::vector<uint32_t>& indices,
+                            size_t vertexCount,
+                            uint32_t maxVertices,
+                            uint32_t maxTriangles,
+                            std::string& error) {
+  if (meshlets.bounds.size() != meshlets.meshlets.size()) {
+    error = "bounds and meshlets counts differ";
+    return false;
+  }
+
+  std::map<std::array<uint32_t, 3>, int> remaining;
+  for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+    ++remaining[canonicalTriangle(indices[i], indices[i + 1], indices[i + 2])];
+  }
+
+  uint32_t triangleOffset = 0;
+  for (size_t m = 0; m < meshlets.meshlets.size(); ++m) {
+    const Meshlet& meshlet  = meshlets.meshlets[m];
+    const std::string where = "meshlet " + std::to_string(m) + ": ";
+
+    if (meshlet.triangleCount == 0 || meshlet.triangleCount > maxTriangles || meshlet.vertexCount > maxVertices) {
+      error = where + "limits not respected";
+      return false;
+    }
+    if (meshlet.triangleOffset != triangleOffset) {
+      error = where + "triangles not contiguous with the previous meshlet";
+      return false;
+    }
+    if (size_t(meshlet.vertexOffset) + meshlet.vertexCount > meshlets.vertices.size()
+        || (size_t(meshlet.triangleOffset) + meshlet.triangleCount) * 3 > meshlets.triangles.size()) {
+      error = where + "out of the meshlet arrays";
+      return false;
+    }
+    triangleOffset += meshlet.triangleCount;
+
+    for (uint32_t v = 0; v < meshlet.vertexCount; ++v) {
+      if (meshlets.vertices[meshlet.vertexOffset + v] >= vertexCount) {
+        error = where + "references a missing vertex";
+        return false;
+      }
+    }
+
+    for (uint32_t t = 0; t < meshlet.triangleCount; ++t) {
+      uint32_t corners[3];
+      for (int k = 0; k < 3; ++k) {
+        const uint8_t localIndex = meshlets.triangles[(meshlet.triangleOffset + t) * 3 + k];
+        if (localIndex >= meshlet.vertexCount) {
+          error = where + "local index out of the meshlet";
+          return false;
+        }
+        corners[k] = meshlets.vertices[meshlet.vertexOffset + localIndex];
+      }
+
+      auto it = remaining.find(canonicalTriangle(corners[0], corners[1], corners[2]));
+      if (it == remaining.end() || it->second == 0) {
+        error = where + "triangle " + std::to_string(t) + " is not in the mesh, or is already in a meshlet";
+        return false;
+      }
+      --it->second;
+    }
+  }
+
+  for (const auto& [triangle, count] : remaining) {
+    if (count != 0) {
+      error = "triangle " + std::to_string(triangle[0]) + " " + std::to_string(triangle[1]) + " "
+              + std::to_string(triangle[2]) + " is in no meshlet";
+      return false;
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,288 @@
+// clang-format off
+#include <common/mesh/Optimize.hpp>
+#include <algorithm>                  // for stable_sort
+#include <common/mesh/Adjacency.hpp>  // for TriangleAdjacency
+#include <glm/glm.hpp>                // for vec3, cross, dot, length
+// clang-format on
+
+using namespace vkl;
+
+namespace {
+
+  /**
+   * @brief FIFO cache simulated with timestamps : a vertex is in the cache if less than cacheSize vertices entered it
+   * since it did. Bumping the time by more than cacheSize flushes it.
+   */
+  class CacheSimulator {
+  public:
+    CacheSimulator(size_t vertexCount, uint32_t cacheSize)
+        : m_cacheTime(vertexCount, 0), m_time(cacheSize + 1), m_cacheSize(cacheSize) {}
+
+    // Return the number of vertices of the triangle which had to be transformed
+    uint32_t triangle(const uint32_t* corners) {
+      uint32_t misses = 0;
+      for (int k = 0; k < 3; ++k) {
+        const uint32_t vertex = corners[k];
+        if (m_time - m_cacheTime[vertex] > m_cacheSize) {
+          m_cacheTime[vertex] = m_time++;
+          ++misses;
+        }
+      }
+      return misses;
+    }
+
+    void flush() { m_time += m_cacheSize + 1; }
+
+  private:
+    std::vector<uint32_t> m_cacheTime;
+    uint32_t m_time;
+    uint32_t m_cacheSize;
+  };
+
+  void permuteTriangles(const std::vector<uint32_t>& order, std::vector<uint32_t>& indices, std::vector<int>& materialIds) {
+    std::vector<uint32_t> newIndices(indices.size());
+    for (size_t t = 0; t < order.size(); ++t) {
+      for (int k = 0; k < 3; ++k) newIndices[t * 3 + k] = indices[order[t] * 3 + k];
+    }
+    indices = std::move(newIndices);
+
+    if (materialIds.size() == order.size()) {
+      std::vector<int> newMaterialIds(materialIds.size());
+      for (size_t t = 0; t < order.size(); ++t) newMaterialIds[t] = materialIds[order[t]];
+      materialIds = std::move(newMaterialIds);
+    }
+  }
+
+}  // namespace
+
+mesh::VertexCacheStats mesh::analyzeVertexCache(const std::vector<uint32_t>& indices,
+                                                size_t vertexCount,
+                                                uint32_t cacheSize) {
+  VertexCacheStats stats;
+  if (indices.empty() || vertexCount == 0) return stats;
+
+  CacheSimulator cache(vertexCount, cacheSize);
+
+  size_t misses = 0;
+  for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+    misses += cache.triangle(&indices[i]);
+  }
+
+  stats.acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+  stats.atvr = static_cast<float>(misses) / static_cast<float>(vertexCount);
+  return stats;
+}
+
+std::vector<uint32_t> mesh::vertexCacheOrder(const std::vector<uint32_t>& indices,
+                                             size_t vertexCount,
+                                             uint32_t cacheSize) {
+  const size_t triangleCount = indices.size() / 3;
+  const TriangleAdjacency adjacency(indices, vertexCount);
+
+  std::vector<uint32_t> live(vertexCount);
+  for (size_t v = 0; v < vertexCount; ++v) live[v] = adjacency.valence(static_cast<uint32_t>(v));
+
+  std::vector<uint32_t> cacheTime(vertexCount, 0);
+  std::vector<bool> emitted(triangleCount, false);
+  std::vector<uint32_t> deadEnd;
+  std::vector<uint32_t> candidates;
+
+  uint32_t time = cacheSize + 1;
+  size_t cursor  = 0;
+
+  std::vector<uint32_t> order;
+  order.reserve(triangleCount);
+
+  // Once the fan is exhausted : go back to a recent vertex which still has triangles, or to the next one in input order
+  auto skipDeadEnd = [&]() -> int64_t {
+    while (!deadEnd.empty()) {
+      const uint32_t vertex = deadEnd.back();
+      deadEnd.pop_back();
+      if (live[vertex] > 0) return vertex;
+    }
+    for (; cursor < vertexCount; ++cursor) {
+      if (live[cursor] > 0) return static_cast<int64_t>(cursor);
+    }
+    return -1;
+  };
+
+  int64_t fanning = skipDeadEnd();
+  while (fanning >= 0) {
+    candidates.clear();
+
+    for (uint32_t a = adjacency.offsets[fanning]; a < adjacency.offsets[fanning + 1]; ++a) {
+      const uint32_t triangle = adjacency.triangles[a];
+      if (emitted[triangle]) continue;
+
+      for (int k = 0; k < 3; ++k) {
+        const uint32_t vertex = indices[triangle * 3 + k];
+        deadEnd.push_back(vertex);
+        candidates.push_back(vertex);
+        --live[vertex];
+        if (time - cacheTime[vertex] > cacheSize) cacheTime[vertex] = time++;
+      }
+
+      emitted[triangle] = true;
+      order.push_back(triangle);
+    }
+
+    // Next fan : the candidate the most recently cached which will still be in the cache once its remaining triangles
+    // are emitted (each one can push 2 vertices), or a candidate with live triangles
+    int64_t best         = -1;
+    int64_t bestPriority = -1;
+    for (uint32_t vertex : candidates) {
+      if (live[vertex] == 0) continue;
+
+      int64_t priority = 0;
+      if (time - cacheTime[vertex] + 2 * live[vertex] <= cacheSize) priority = time - cacheTime[vertex];
+      if (priority > bestPriority) {
+        best         = vertex;
+        bestPriority = priority;
+      }
+    }
+
+    fanning = (best >= 0) ? best : skipDeadEnd();
+  }
+
+  return order;
+}
+
+std::vector<uint32_t> mesh::overdrawOrder(const std::vector<uint32_t>& indices,
+                                          const std::vector<Vertex>& vertices,
+                                          uint32_t cacheSize,
+                                          float threshold) {
+  const size_t triangleCount = indices.size() / 3;
+
+  // Hard boundaries : the triangles whose 3 vertices miss, the cache has been flushed there anyway
+  std::vector<size_t> hard;
+  {
+    CacheSimulator cache(vertices.size(), cacheSize);
+    for (size_t t = 0; t < triangleCount; ++t) {
+      if (cache.triangle(&indices[t * 3]) == 3 || t == 0) hard.push_back(t);
+    }
+  }
+  hard.push_back(triangleCount);
+
+  // Soft boundaries : split a hard cluster each time its running ACMR is good enough
+  std::vector<size_t> clusters;
+  for (size_t c = 0; c + 1 < hard.size(); ++c) {
+    const size_t start = hard[c];
+    const size_t end   = hard[c + 1];
+
+    CacheSimulator cache(vertices.size(), cacheSize);
+    size_t clusterMisses = 0;
+    for (size_t t = start; t < end; ++t) clusterMisses += cache.triangle(&indices[t * 3]);
+    const float clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - start);
+
+    cache.flush();
+    clusters.push_back(start);
+
+    size_t misses = 0, count = 0;
+    for (size_t t = start; t < end; ++t) {
+      misses += cache.triangle(&indices[t * 3]);
+      ++count;
+
+      if (t + 1 < end && static_cast<float>(misses) / static_cast<float>(count) <= clusterThreshold) {
+        clusters.push_back(t + 1);
+        cache.flush();
+        misses = count = 0;
+      }
+    }
+
+    // The tail of the run has rarely reached the threshold, merge it in the previous cluster
+    if (count > 0 && clusters.back() != start) clusters.pop_back();
+  }
+  clusters.push_back(triangleCount);
+
+  // Area weighted centroid and normal of each cluster, and of the whole mesh
+  struct Cluster {
+    size_t start, end;
+    glm::vec3 centroid;
+    glm::vec3 normal;
+    float area;
+    float sortKey;
+  };
+
+  std::vector<Cluster> sorted;
+  sorted.reserve(clusters.size() - 1);
+
+  glm::vec3 meshCentroid(0.0f);
+  float meshArea = 0.0f;
+
+  for (size_t c = 0; c + 1 < clusters.size(); ++c) {
+    Cluster cluster = {clusters[c], clusters[c + 1], glm::vec3(0.0f), glm::vec3(0.0f), 0.0f, 0.0f};
+
+    for (size_t t = cluster.start; t < cluster.end; ++t) {
+      const glm::vec3& p0 = vertices[indices[t * 3 + 0]].pos;
+      const glm::vec3& p1 = vertices[indices[t * 3 + 1]].pos;
+      const glm::vec3& p2 = vertices[indices[t * 3 + 2]].pos;
+
+      const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+      const float area       = glm::length(normal);
+
+      cluster.centroid += (p0 + p1 + p2) * (area / 3.0f);
+      cluster.normal += normal;
+      cluster.area += area;
+    }
+
+    meshCentroid += cluster.centroid;
+    meshArea += cluster.area;
+
+    if (cluster.area > 0.0f) cluster.centroid /= cluster.area;
+    sorted.push_back(cluster);
+  }
+
+  if (meshArea > 0.0f) meshCentroid /= meshArea;
+
+  for (Cluster& cluster : sorted) {
+    const float length = glm::length(cluster.normal);
+    cluster.sortKey    = (length > 0.0f) ? glm::dot(cluster.centroid - meshCentroid, cluster.normal / length) : 0.0f;
+  }
+
+  // Outward facing clusters, far from the center, first
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+
+  std::vector<uint32_t> order;
+  order.reserve(triangleCount);
+  for (const Cluster& cluster : sorted) {
+    for (size_t t = cluster.start; t < cluster.end; ++t) order.push_back(static_cast<uint32_t>(t));
+  }
+
+  return order;
+}
+
+std::vector<uint32_t> mesh::vertexFetchRemap(const std::vector<uint32_t>& indices, size_t vertexCount) {
+  std::vector<uint32_t> remap(vertexCount, UINT32_MAX);
+
+  uint32_t next = 0;
+  for (uint32_t index : indices) {
+    if (remap[index] == UINT32_MAX) remap[index] = next++;
+  }
+
+  return remap;
+}
+
+mesh::OptimizeStats mesh::optimizeMesh(MeshData& mesh, uint32_t cacheSize) {
+  OptimizeStats stats;
+  stats.before = analyzeVertexCache(mesh.indices, mesh.vertices.size(), cacheSize);
+
+  permuteTriangles(vertexCacheOrder(mesh.indices, mesh.vertices.size(), cacheSize), mesh.indices, mesh.materialIds);
+  permuteTriangles(overdrawOrder(mesh.indices, mesh.vertices, cacheSize), mesh.indices, mesh.materialIds);
+
+  const std::vector<uint32_t> remap = vertexFetchRemap(mesh.indices, mesh.vertices.size());
+
+  size_t used = 0;
+  for (uint32_t index : remap) used += (index != UINT32_MAX);
+
+  std::vector<Vertex> vertices(used);
+  for (size_t v = 0; v < remap.size(); ++v) {
+    if (remap[v] != UINT32_MAX) vertices[remap[v]] = mesh.vertices[v];
+  }
+  mesh.vertices = std::move(vertices);
+
+  for (uint32_t& index : mesh.indices) index = remap[index];
+
+  stats.after = analyzeVertexCache(mesh.indices, mesh.vertices.size(), cacheSize);
+  return stats;
+}
@@ -0,0 +1,105 @@
+// clang-format off
+#include <common/mesh/Quantize.hpp>
+#include <algorithm>                 // for min, max
+#include <cmath>                     // for abs, round
+#include <glm/gtc/packing.hpp>       // for packHalf1x16, unpackHalf1x16
+// clang-format on
+
+using namespace vkl;
+
+namespace {
+
+  inline float signNotZero(float v) { return (v >= 0.0f) ? 1.0f : -1.0f; }
+
+  inline uint16_t toUnorm16(float v) {
+    return static_cast<uint16_t>(std::round(std::clamp(v, 0.0f, 1.0f) * 65535.0f));
+  }
+
+  inline int16_t toSnorm16(float v) { return static_cast<int16_t>(std::round(std::clamp(v, -1.0f, 1.0f) * 32767.0f)); }
+
+  // Same as the GPU conversion of a SNORM format
+  inline float fromSnorm16(int16_t v) { return std::max(v / 32767.0f, -1.0f); }
+
+}  // namespace
+
+Quantization mesh::computeQuantization(const std::vector<Vertex>& vertices) {
+  Quantization quantization;
+  if (vertices.empty()) return quantization;
+
+  glm::vec3 min = vertices[0].pos;
+  glm::vec3 max = vertices[0].pos;
+  for (const Vertex& vertex : vertices) {
+    min = glm::min(min, vertex.pos);
+    max = glm::max(max, vertex.pos);
+  }
+
+  quantization.offset = glm::vec4(min, 0.0f);
+  for (int i = 0; i < 3; ++i) {
+    // A flat axis would divide by zero
+    quantization.scale[i] = (max[i] > min[i]) ? max[i] - min[i] : 1.0f;
+  }
+
+  return quantization;
+}
+
+glm::vec2 mesh::octEncode(const glm::vec3& normal) {
+  const float sum = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+  if (sum == 0.0f) return glm::vec2(0.0f);
+
+  glm::vec2 p = glm::vec2(normal.x, normal.y) / sum;
+  if (normal.z < 0.0f) {
+    p = glm::vec2((1.0f - std::abs(p.y)) * signNotZero(p.x), (1.0f - std::abs(p.x)) * signNotZero(p.y));
+  }
+
+  return p;
+}
+
+glm::vec3 mesh::octDecode(const glm::vec2& encoded) {
+  glm::vec3 n = glm::vec3(encoded.x, encoded.y, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+
+  const float t = std::max(-n.z, 0.0f);
+  n.x += (n.x >= 0.0f) ? -t : t;
+  n.y += (n.y >= 0.0f) ? -t : t;
+
+  return glm::normalize(n);
+}
+
+CompactVertex mesh::compressVertex(const Vertex& vertex, const Quantization& quantization) {
+  CompactVertex compact = {};
+
+  for (int i = 0; i < 3; ++i) {
+    compact.pos[i] = toUnorm16((vertex.pos[i] - quantization.offset[i]) / quantization.scale[i]);
+  }
+
+  const glm::vec2 normal = octEncode(vertex.normal);
+  compact.normal[0]      = toSnorm16(normal.x);
+  compact.normal[1]      = toSnorm16(normal.y);
+
+  compact.texCoord[0] = glm::packHalf1x16(vertex.texCoord.x);
+  compact.texCoord[1] = glm::packHalf1x16(vertex.texCoord.y);
+
+  return compact;
+}
+
+Vertex mesh::decompressVertex(const CompactVertex& compact, const Quantization& quantization) {
+  Vertex vertex{};
+
+  for (int i = 0; i < 3; ++i) {
+    vertex.pos[i] = quantization.offset[i] + (compact.pos[i] / 65535.0f) * quantization.scale[i];
+  }
+
+  vertex.normal   = octDecode(glm::vec2(fromSnorm16(compact.normal[0]), fromSnorm16(compact.normal[1])));
+  vertex.color    = glm::vec3(1.0f);
+  vertex.texCoord = glm::vec2(glm::unpackHalf1x16(compact.texCoord[0]), glm::unpackHalf1x16(compact.texCoord[1]));
+
+  return vertex;
+}
+
+std::vector<CompactVertex> mesh::compressVertices(const std::vector<Vertex>& vertices,
+                                                  const Quantization& quantization) {
+  std::vector<CompactVertex> compact(vertices.size());
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    compact[i] = compressVertex(vertices[i], quantization);
+  }
+  return compact;
+}
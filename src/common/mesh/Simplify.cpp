@@ -0,0 +1,417 @@
+// clang-format off
+#include <common/mesh/Simplify.hpp>
+#include <algorithm>                  // for sort, max, find
+#include <cmath>                      // for sqrt
+#include <numeric>                    // for iota
+#include <unordered_map>              // for unordered_map
+#include <common/mesh/Adjacency.hpp>  // for TriangleAdjacency, positionRemap
+#include <glm/glm.hpp>                // for vec3, cross, dot, length
+// clang-format on
+
+using namespace vkl;
+
+namespace {
+
+  /**
+   * @brief Sum of squared distances to a set of planes, as the symmetric matrix of p^T A p + 2 b.p + c
+   */
+  struct Quadric {
+    double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+    double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+    double c      = 0.0;
+    double weight = 0.0;  // sum of the weights, to turn the sum in a mean squared distance
+
+    void addPlane(const glm::vec3& n, double d, double w) {
+      a00 += w * n.x * n.x;
+      a01 += w * n.x * n.y;
+      a02 += w * n.x * n.z;
+      a11 += w * n.y * n.y;
+      a12 += w * n.y * n.z;
+      a22 += w * n.z * n.z;
+      b0 += w * n.x * d;
+      b1 += w * n.y * d;
+      b2 += w * n.z * d;
+      c += w * d * d;
+      weight += w;
+    }
+
+    Quadric& operator+=(const Quadric& other) {
+      a00 += other.a00, a01 += other.a01, a02 += other.a02;
+      a11 += other.a11, a12 += other.a12, a22 += other.a22;
+      b0 += other.b0, b1 += other.b1, b2 += other.b2;
+      c += other.c;
+      weight += other.weight;
+      return *this;
+    }
+
+    // Mean squared distance of p to the planes
+    double error(const glm::vec3& p) const {
+      if (weight <= 0.0) return 0.0;
+
+      const double x = p.x, y = p.y, z = p.z;
+      const double square = a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z);
+      return std::max(square + 2.0 * (b0 * x + b1 * y + b2 * z) + c, 0.0) / weight;
+    }
+  };
+
+  enum class VertexKind : uint8_t {
+    Manifold,  // may collapse onto any neighbour
+    Border,    // on one open boundary, slides along it
+    Seam,      // on one UV / normal seam or material boundary, slides along it
+    Locked,    // corner, crossing of seams, non-manifold
+  };
+
+  struct Edge {
+    uint32_t forward  = 0;  // triangles going from the lowest to the highest position
+    uint32_t backward = 0;
+    bool seam         = false;
+    uint32_t triangle;             // the first triangle seen
+    uint32_t lowWedge, highWedge;  // its vertices, compared with the other side
+    int material;
+  };
+
+  inline uint64_t edgeKey(uint32_t a, uint32_t b) {
+    return (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+  }
+
+  /**
+   * @brief The working state : the triangles, as vertices of the source mesh, and the quadrics of each position
+   *
+   * Positions are identified by their first vertex (positionRemap), the topology is the one of the positions.
+   */
+  class Simplifier {
+  public:
+    Simplifier(const std::vector<uint32_t>& indices,
+               const std::vector<Vertex>& vertices,
+               const std::vector<int>& materialIds,
+               float maxError)
+        : m_vertices(vertices),
+          m_materialIds(materialIds),
+          m_positions(mesh::positionRemap(vertices)),
+          m_indices(indices),
+          m_sources(indices.size() / 3),
+          m_faces(vertices.size()),
+          m_borders(vertices.size()),
+          m_maxCost(static_cast<double>(maxError) * maxError),
+          m_kinds(vertices.size(), VertexKind::Manifold) {
+      std::iota(m_sources.begin(), m_sources.end(), 0);
+
+      for (size_t t = 0; t < m_sources.size(); ++t) {
+        const glm::vec3& p0 = position(t, 0);
+        const glm::vec3 normal = glm::cross(position(t, 1) - p0, position(t, 2) - p0);
+        const float length     = glm::length(normal);
+        if (length == 0.0f) continue;
+
+        // Weighted by area
+        Quadric quadric;
+        quadric.addPlane(normal / length, -glm::dot(normal / length, p0), 0.5 * length);
+        for (int k = 0; k < 3; ++k) m_faces[corner(t, k)] += quadric;
+      }
+
+      classify();
+    }
+
+    inline const std::vector<uint32_t>& indices() const { return m_indices; }
+    inline const std::vector<uint32_t>& sources() const { return m_sources; }
+    inline float error() const { return static_cast<float>(std::sqrt(m_cost)); }
+
+    /**
+     * @brief Collapse the cheapest independent edges until targetTriangles is reached
+     * @return The number of collapses, 0 when the mesh can't be simplified any more within the error limit
+     */
+    size_t pass(size_t targetTriangles);
+
+  private:
+    struct Collapse {
+      uint32_t from, to;
+      double cost;
+    };
+
+    const std::vector<Vertex>& m_vertices;
+    const std::vector<int>& m_materialIds;
+    const std::vector<uint32_t> m_positions;
+
+    std::vector<uint32_t> m_indices;
+    std::vector<uint32_t> m_sources;
+    std::vector<Quadric> m_faces;    // planes of the triangles around each position
+    std::vector<Quadric> m_borders;  // planes through the open edges, perpendicular to their triangle
+    double m_maxCost;
+    double m_cost = 0.0;  // the highest collapse cost so far
+    std::vector<VertexKind> m_kinds;
+
+    inline uint32_t corner(size_t triangle, int k) const { return m_positions[m_indices[triangle * 3 + k]]; }
+    inline const glm::vec3& position(size_t triangle, int k) const { return m_vertices[corner(triangle, k)].pos; }
+
+    inline int material(size_t triangle) const {
+      const uint32_t source = m_sources[triangle];
+      return (source < m_materialIds.size()) ? m_materialIds[source] : -1;
+    }
+
+    std::unordered_map<uint64_t, Edge> edges() const;
+    void classify();
+    double cost(uint32_t from, uint32_t to) const;
+    bool commit(const Collapse& collapse,
+                const mesh::TriangleAdjacency& adjacency,
+                std::vector<uint8_t>& touched,
+                std::vector<uint8_t>& removed,
+                size_t& triangles);
+  };
+
+  std::unordered_map<uint64_t, Edge> Simplifier::edges() const {
+    std::unordered_map<uint64_t, Edge> result;
+    result.reserve(m_indices.size());
+
+    for (size_t t = 0; t < m_indices.size() / 3; ++t) {
+      for (int k = 0; k < 3; ++k) {
+        const uint32_t a = corner(t, k), b = corner(t, (k + 1) % 3);
+        if (a == b) continue;
+
+        const uint32_t wedgeA = m_indices[t * 3 + k], wedgeB = m_indices[t * 3 + (k + 1) % 3];
+        const uint32_t low = (a < b) ? wedgeA : wedgeB, high = (a < b) ? wedgeB : wedgeA;
+
+        auto [it, inserted] = result.try_emplace(edgeKey(a, b));
+        Edge& edge          = it->second;
+        if (inserted) {
+          edge.triangle  = static_cast<uint32_t>(t);
+          edge.lowWedge  = low;
+          edge.highWedge = high;
+          edge.material  = material(t);
+        } else if (edge.lowWedge != low || edge.highWedge != high || edge.material != material(t)) {
+          edge.seam = true;
+        }
+        (a < b) ? ++edge.forward : ++edge.backward;
+      }
+    }
+
+    return result;
+  }
+
+  void Simplifier::classify() {
+    std::vector<uint32_t> borders(m_vertices.size(), 0), seams(m_vertices.size(), 0), locked(m_vertices.size(), 0);
+
+    for (const auto& [key, edge] : edges()) {
+      const uint32_t a = static_cast<uint32_t>(key >> 32), b = static_cast<uint32_t>(key);
+
+      if (edge.forward > 1 || edge.backward > 1) {
+        locked[a] = locked[b] = 1;
+      } else if (edge.forward + edge.backward == 1) {
+        ++borders[a], ++borders[b];
+
+        // Keep the boundary in place : a plane through the edge, perpendicular to its face, weighted by length
+        const glm::vec3& pa   = m_vertices[a].pos;
+        const glm::vec3 along = m_vertices[b].pos - pa;
+        const glm::vec3& p0   = position(edge.triangle, 0);
+        const glm::vec3 face  = glm::cross(position(edge.triangle, 1) - p0, position(edge.triangle, 2) - p0);
+        glm::vec3 normal      = glm::cross(along, face);
+        const float length    = glm::length(normal);
+        if (length > 0.0f) {
+          normal /= length;
+          Quadric quadric;
+          quadric.addPlane(normal, -glm::dot(normal, pa), glm::length(along));
+          m_borders[a] += quadric;
+          m_borders[b] += quadric;
+        }
+      } else if (edge.seam) {
+        ++seams[a], ++seams[b];
+      }
+    }
+
+    for (size_t v = 0; v < m_vertices.size(); ++v) {
+      if (m_positions[v] != v) continue;
+
+      if (locked[v]) {
+        m_kinds[v] = VertexKind::Locked;
+      } else if (borders[v] > 0) {
+        m_kinds[v] = (borders[v] == 2 && seams[v] == 0) ? VertexKind::Border : VertexKind::Locked;
+      } else if (seams[v] > 0) {
+        m_kinds[v] = (seams[v] == 2) ? VertexKind::Seam : VertexKind::Locked;
+      }
+    }
+  }
+
+  // Squared distance to the surface, or to its borders, whichever is the worst
+  double Simplifier::cost(uint32_t from, uint32_t to) const {
+    Quadric faces = m_faces[from], borders = m_borders[from];
+    faces += m_faces[to];
+    borders += m_borders[to];
+    return std::max(faces.error(m_vertices[to].pos), borders.error(m_vertices[to].pos));
+  }
+
+  size_t Simplifier::pass(size_t targetTriangles) {
+    size_t triangles = m_indices.size() / 3;
+    if (triangles <= targetTriangles) return 0;
+
+    std::vector<Collapse> candidates;
+    for (const auto& [key, edge] : edges()) {
+      if (edge.forward > 1 || edge.backward > 1) continue;
+
+      const bool border = (edge.forward + edge.backward == 1);
+      auto allowed      = [&](uint32_t from) {
+        switch (m_kinds[from]) {
+          case VertexKind::Manifold: return true;
+          case VertexKind::Border: return border;
+          case VertexKind::Seam: return edge.seam && !border;
+          default: return false;
+        }
+      };
+
+      const uint32_t a = static_cast<uint32_t>(key >> 32), b = static_cast<uint32_t>(key);
+      const double costA = allowed(a) ? cost(a, b) : -1.0;
+      const double costB = allowed(b) ? cost(b, a) : -1.0;
+
+      if (costA >= 0.0 && (costB < 0.0 || costA <= costB)) {
+        candidates.push_back({a, b, costA});
+      } else if (costB >= 0.0) {
+        candidates.push_back({b, a, costB});
+      }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const Collapse& x, const Collapse& y) {
+      return (x.cost != y.cost) ? x.cost < y.cost : (x.from != y.from) ? x.from < y.from : x.to < y.to;
+    });
+
+    std::vector<uint32_t> positionIndices(m_indices.size());
+    for (size_t i = 0; i < m_indices.size(); ++i) positionIndices[i] = m_positions[m_indices[i]];
+    const mesh::TriangleAdjacency adjacency(positionIndices, m_vertices.size());
+
+    std::vector<uint8_t> touched(m_vertices.size(), 0);
+    std::vector<uint8_t> removed(triangles, 0);
+
+    // Only the cheapest third in one pass, so the error grows evenly over the mesh
+    const size_t limit = std::max<size_t>(1, candidates.size() / 3);
+
+    size_t collapses = 0;
+    for (size_t c = 0; c < candidates.size() && triangles > targetTriangles; ++c) {
+      if ((c >= limit && collapses > 0) || candidates[c].cost > m_maxCost) break;
+      if (commit(candidates[c], adjacency, touched, removed, triangles)) ++collapses;
+    }
+
+    size_t kept = 0;
+    for (size_t t = 0; t < removed.size(); ++t) {
+      if (removed[t]) continue;
+      for (int k = 0; k < 3; ++k) m_indices[kept * 3 + k] = m_indices[t * 3 + k];
+      m_sources[kept++] = m_sources[t];
+    }
+    m_indices.resize(kept * 3);
+    m_sources.resize(kept);
+
+    return collapses;
+  }
+
+  bool Simplifier::commit(const Collapse& collapse,
+                          const mesh::TriangleAdjacency& adjacency,
+                          std::vector<uint8_t>& touched,
+                          std::vector<uint8_t>& removed,
+                          size_t& triangles) {
+    const uint32_t from = collapse.from, to = collapse.to;
+    if (touched[from] || touched[to]) return false;
+
+    auto cornerOf = [&](uint32_t triangle, uint32_t vertex) -> int {
+      for (int k = 0; k < 3; ++k) {
+        if (corner(triangle, k) == vertex) return k;
+      }
+      return -1;
+    };
+
+    // Each vertex at `from` moves to the vertex at `to` on the same side of the seams
+    std::vector<std::pair<uint32_t, uint32_t>> wedges;
+    std::vector<uint32_t> linked;  // third corners of the triangles of the edge
+    for (uint32_t a = adjacency.offsets[from]; a < adjacency.offsets[from + 1]; ++a) {
+      const uint32_t t = adjacency.triangles[a];
+      const int j      = cornerOf(t, to);
+      if (j < 0) continue;
+
+      const int k          = cornerOf(t, from);
+      const uint32_t wedge = m_indices[t * 3 + k];
+      auto same            = [wedge](const std::pair<uint32_t, uint32_t>& w) { return w.first == wedge; };
+      if (std::find_if(wedges.begin(), wedges.end(), same) == wedges.end()) {
+        wedges.push_back({wedge, m_indices[t * 3 + j]});
+      }
+      linked.push_back(corner(t, 3 - j - k));
+    }
+    if (wedges.empty()) return false;
+
+    auto mapped = [&](uint32_t wedge) -> int64_t {
+      for (const auto& [source, target] : wedges) {
+        if (source == wedge) return target;
+      }
+      return -1;
+    };
+
+    // Link condition : the only common neighbours are the ones of the edge, or the surface would pinch
+    std::vector<uint32_t> ring;
+    for (uint32_t a = adjacency.offsets[to]; a < adjacency.offsets[to + 1]; ++a) {
+      for (int k = 0; k < 3; ++k) ring.push_back(corner(adjacency.triangles[a], k));
+    }
+
+    const glm::vec3& target = m_vertices[to].pos;
+    for (uint32_t a = adjacency.offsets[from]; a < adjacency.offsets[from + 1]; ++a) {
+      const uint32_t t = adjacency.triangles[a];
+      if (cornerOf(t, to) >= 0) continue;
+
+      const int k = cornerOf(t, from);
+      if (mapped(m_indices[t * 3 + k]) < 0) return false;
+
+      for (int n = 1; n < 3; ++n) {
+        const uint32_t neighbour = corner(t, (k + n) % 3);
+        if (std::find(ring.begin(), ring.end(), neighbour) != ring.end()
+            && std::find(linked.begin(), linked.end(), neighbour) == linked.end()) {
+          return false;
+        }
+      }
+
+      // The triangles which stay must not flip
+      glm::vec3 p[3] = {position(t, 0), position(t, 1), position(t, 2)};
+      const glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+      p[k]                   = target;
+      const glm::vec3 after  = glm::cross(p[1] - p[0], p[2] - p[0]);
+      if (glm::dot(before, after) <= 0.0f) return false;
+    }
+
+    for (uint32_t a = adjacency.offsets[from]; a < adjacency.offsets[from + 1]; ++a) {
+      const uint32_t t = adjacency.triangles[a];
+      for (int k = 0; k < 3; ++k) touched[corner(t, k)] = 1;
+
+      if (cornerOf(t, to) >= 0) {
+        removed[t] = 1;
+        --triangles;
+      } else {
+        const int k          = cornerOf(t, from);
+        m_indices[t * 3 + k] = static_cast<uint32_t>(mapped(m_indices[t * 3 + k]));
+      }
+    }
+
+    m_faces[to] += m_faces[from];
+    m_borders[to] += m_borders[from];
+    m_cost = std::max(m_cost, collapse.cost);
+    return true;
+  }
+
+}  // namespace
+
+std::vector<mesh::SimplifiedMesh> mesh::simplifyLevels(const std::vector<uint32_t>& indices,
+                                                       const std::vector<Vertex>& vertices,
+                                                       const std::vector<int>& materialIds,
+                                                       const std::vector<size_t>& targetIndexCounts,
+                                                       float maxError) {
+  Simplifier simplifier(indices, vertices, materialIds, maxError);
+
+  std::vector<SimplifiedMesh> levels;
+  for (size_t target : targetIndexCounts) {
+    while (simplifier.pass(target / 3) > 0) {
+    }
+    levels.push_back({simplifier.indices(), simplifier.sources(), simplifier.error()});
+  }
+
+  return levels;
+}
+
+std::vector<uint32_t> mesh::simplify(const std::vector<uint32_t>& indices,
+                                     const std::vector<Vertex>& vertices,
+                                     size_t targetIndexCount,
+                                     float maxError,
+                                     float* error) {
+  std::vector<SimplifiedMesh> levels = simplifyLevels(indices, vertices, {}, {targetIndexCount}, maxError);
+  if (error != nullptr) *error = levels.front().error;
+  return std::move(levels.front().indices);
+}
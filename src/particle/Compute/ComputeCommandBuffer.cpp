@@ -138,8 +138,11 @@ void ComputeCommandBuffer::createCommandBuffers() {
   // First pass: Clear Grid
   // -------------------------------------------------------------------------------------------------------
   vkCmdBindPipeline(m_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_computePipeline.pipeline(0));
+  // Recorded once, with the constants of the first image's region
+  const std::vector<uint32_t> dynamicOffsets = m_descriptorSets.dynamicOffsets(0);
   vkCmdBindDescriptorSets(m_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_computePipeline.layout(), 0, 1,
-                          &m_descriptorSets.descriptor(0), 0, 0);
+                          &m_descriptorSets.descriptor(0), static_cast<uint32_t>(dynamicOffsets.size()),
+                          dynamicOffsets.data());
   vkCmdDispatch(m_commandBuffer, NUM_CELLS / 256, 1, 1);
 
   // Add memory barrier to ensure that the computer shader has finished writing to the buffer
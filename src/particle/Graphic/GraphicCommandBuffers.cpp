@@ -83,8 +83,10 @@ void GraphicCommandBuffers::createCommandBuffers() {
     vkCmdBeginRenderPass(m_commandBuffers[i], &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
 
     vkCmdBindPipeline(m_commandBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline.pipeline());
+    const std::vector<uint32_t> dynamicOffsets = m_descriptorSets.dynamicOffsets(i);
     vkCmdBindDescriptorSets(m_commandBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline.layout(), 0, 1,
-                            &m_descriptorSets.descriptor(i), 0, nullptr);
+                            &m_descriptorSets.descriptor(i), static_cast<uint32_t>(dynamicOffsets.size()),
+                            dynamicOffsets.data());
 
     VkDeviceSize offsets[1] = {0};
     vkCmdBindVertexBuffers(m_commandBuffers[i], 0, 1, &(storageBuffer->buffer()), offsets);
@@ -1,6 +1,6 @@
 // clang-format off
 #include <particle/Graphic/GraphicDescriptorSets.hpp>
-#include <stddef.h>                       // for size_t
+#include <vector>                         // for vector
 #include <common/VulkanHeader.hpp>           // for VkWriteDescriptorSet, vkUpd...
 #include <common/misc/DescriptorSet.hpp>  // for writeDescriptorSet
 #include <common/struct/MVP.hpp>          // for MVP
@@ -12,20 +12,16 @@
 using namespace vkl;
 
 void GraphicDescriptorSets::createDescriptorSets() {
-  allocateDescriptorSets();
+  // Un seul set : les frames ne diffèrent que par l'offset dynamique du uniform buffer
+  allocateDescriptorSets(1);
 
-  std::vector<VkWriteDescriptorSet> writeDescriptorSets;
+  const IUniformBuffers* ubo               = m_uniformBuffers[0];
+  const VkDescriptorBufferInfo& bufferInfo = ubo->descriptor(0);
 
-  // On paramètre les descripteurs (on se rappelle que l'on en a mit un par frame)
-  const IUniformBuffers* ubo = m_uniformBuffers[0];
-  for (size_t i = 0; i < m_descriptorSets.size(); i++) {
-    const VkDescriptorBufferInfo& bufferInfo = ubo->descriptor(i);
+  const std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
+      // Binding 0 :
+      misc::writeDescriptorSet(m_descriptorSets.at(0), VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 0, &bufferInfo),
+  };
 
-    writeDescriptorSets = {
-        // Binding 2 :
-        misc::writeDescriptorSet(m_descriptorSets.at(i), VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 0, &bufferInfo),
-    };
-
-    vkUpdateDescriptorSets(m_device.logical(), writeDescriptorSets.size(), writeDescriptorSets.data(), 0, nullptr);
-  }
+  vkUpdateDescriptorSets(m_device.logical(), writeDescriptorSets.size(), writeDescriptorSets.data(), 0, nullptr);
 }
@@ -4,8 +4,6 @@
 #include <common/misc/DescriptorPool.hpp>                // for descriptorPo...
 #include <common/misc/DescriptorSetLayout.hpp>           // for descriptorSe...
 #include <cstdint>                                       // for uint32_t
-#include <cstring>                                       // for memcpy
-#include <deque>                                         // for deque
 #include <memory>                                        // for allocator_tr...
 #include <stdexcept>                                     // for runtime_error
 #include <common/Application.hpp>                        // for Application
@@ -42,10 +40,9 @@ static bool isPause = true;
 
 void updateGraphicsUniformBuffers(const Device& device,
                                   const SwapChain& swapChain,
-                                  std::deque<Buffer<ParticleMVP>>& uniformBuffers,
+                                  ParticleMVP& ubo,
                                   float time,
                                   uint32_t currentImage) {
-  ParticleMVP& ubo = uniformBuffers.at(currentImage).data().at(0);
 
   ubo.model = glm::mat4(1.0f);
 
@@ -61,29 +58,18 @@ void updateGraphicsUniformBuffers(const Device& device,
   ubo.proj[1][1] *= -1;
 
   ubo.screenDim = glm::vec2(swapChain.extent().width, swapChain.extent().height);
-
-  void* data;
-  vkMapMemory(device.logical(), uniformBuffers[currentImage].memory(), 0, sizeof(ubo), 0, &data);
-  memcpy(data, &ubo, sizeof(ubo));
-  vkUnmapMemory(device.logical(), uniformBuffers[currentImage].memory());
 }
 
 void updateComputeUniformBuffers(const Device& device,
                                  const SwapChain& swapChain,
-                                 std::deque<Buffer<ComputeParticle>>& uniformBuffers,
+                                 ComputeParticle& ubo,
                                  float time,
                                  uint32_t currentImage) {
-  ComputeParticle& ubo = uniformBuffers.at(currentImage).data().at(0);
 
   ubo.deltaT         = isPause ? 0.0f : DT;
   ubo.particleCount  = NUM_PARTICLE;
   ubo.elastic_lambda = elastic_lambda;
   ubo.elastic_mu     = elastic_mu;
-
-  void* data;
-  vkMapMemory(device.logical(), uniformBuffers[currentImage].memory(), 0, sizeof(ubo), 0, &data);
-  memcpy(data, &ubo, sizeof(ubo));
-  vkUnmapMemory(device.logical(), uniformBuffers[currentImage].memory());
 }
 
 ParticleSystem::ParticleSystem(
@@ -106,14 +92,15 @@ ParticleSystem::ParticleSystem(
                          device.queueFamilyIndices().computeFamily),
 
       // Descriptor Pool
+      // A single set for all the images, bound with the dynamic offset of the image
       ps({
-          misc::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, swapChain.numImages()),
+          misc::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1),
       }),
-      dpi(misc::descriptorPoolCreateInfo(ps, swapChain.numImages())),
+      dpi(misc::descriptorPoolCreateInfo(ps, 1)),
       dp(device, dpi),
 
       psCompute({
-          misc::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1),
+          misc::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1),
           misc::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3),
       }),
       dpiCompute(misc::descriptorPoolCreateInfo(psCompute, 4)),
@@ -121,14 +108,15 @@ ParticleSystem::ParticleSystem(
 
       // Buffer
       // Graphic
-      uniformBuffersGraphic(device, swapChain, &updateGraphicsUniformBuffers),
+      uniformRing(device, swapChain),
+      uniformBuffersGraphic(uniformRing, &updateGraphicsUniformBuffers),
 
       // Compute
       storageBuffer(device,
                     commandPool,
                     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
-      uniformBuffersCompute(device, swapChain, &updateComputeUniformBuffers),
+      uniformBuffersCompute(uniformRing, &updateComputeUniformBuffers),
 
       // ~ My Vectors
       // Utile car sinon les pointeurs change, donc on copie d'abord par valeur
@@ -147,7 +135,9 @@ ParticleSystem::ParticleSystem(
       // 2. Descriptor Set Layout
       dslGraphic(device,
                  misc::descriptorSetLayoutCreateInfo({
-                     misc::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, 0),
+                     misc::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                                                      VK_SHADER_STAGE_VERTEX_BIT,
+                                                      0),
                  })),
 
       // 3. Graphic Pipeline
@@ -172,7 +162,9 @@ ParticleSystem::ParticleSystem(
               misc::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 1),
               misc::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 2),
               // Binding 1 : Uniform buffer
-              misc::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 3),
+              misc::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                                               VK_SHADER_STAGE_COMPUTE_BIT,
+                                               3),
           })),
 
       // 5. Descriptor Sets
@@ -216,6 +208,8 @@ void ParticleSystem::run() {
 
   window.mainLoop();
   vkDeviceWaitIdle(device.logical());
+
+  writeMemoryStats();
 }
 
 void ParticleSystem::drawFrame(bool& framebufferResized) {
@@ -347,6 +341,10 @@ void ParticleSystem::drawImGui() {
 
     ImGui::SliderFloat("lambda", &(elastic_lambda), 10.0f, 100.0f);
     ImGui::SliderFloat("mu", &(elastic_mu), 0.1f, 20.0f);
+
+    ImGui::Separator();
+    ImGui::Text("Memory");
+    interface.drawMemoryStats();
   }
 
   ImGui::End();
@@ -369,7 +367,8 @@ void ParticleSystem::recreateSwapChain(bool& framebufferResized) {
 
   swapChain.recreate();
 
-  // Recreated because the number of buffer is based on number of image in swapchain
+  // The ring has a region per image of the swapchain
+  uniformRing.recreate();
   uniformBuffersGraphic.recreate();
   uniformBuffersCompute.recreate();
 
@@ -10,8 +10,8 @@
 #include <common/GraphicsPipeline.hpp>  // for GraphicsPipeline
 #include <common/RenderPass.hpp>        // for RenderPass
 #include <common/SwapChain.hpp>         // for SwapChain
-#include <common/buffer/Buffer.hpp>     // for Buffer
-#include <common/struct/Vertex.hpp>     // for Vertex
+#include <common/buffer/IndexBuffer.hpp>  // for IndexBuffer
+#include <common/buffer/VertexBuffer.hpp>  // for VertexBuffer
 // clang-format on
 
 using namespace vkl;
@@ -31,66 +31,99 @@ void BasicCommandBuffers::createCommandBuffers() {
   }
 
   for (size_t i = 0; i < m_commandBuffers.size(); i++) {
-    const VkCommandBufferBeginInfo beginInfo = {
-        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+    recordCommandBuffers(static_cast<uint32_t>(i));
+  }
+}
+
+void BasicCommandBuffers::recordCommandBuffers(uint32_t bufferIdx) {
+  const VkCommandBufferBeginInfo beginInfo = {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+  };
+
+  if (vkBeginCommandBuffer(m_commandBuffers.at(bufferIdx), &beginInfo) != VK_SUCCESS) {
+    throw std::runtime_error("failed to begin recording command buffer!");
+  }
+
+  VkClearValue clearValues[2];
+  clearValues[0].color        = {{0.0f, 0.0f, 0.2f, 0.0f}};
+  clearValues[1].depthStencil = {1.0f, 0};
+
+  const VkRenderPassBeginInfo renderPassBeginInfo = {
+        .sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+        .renderPass        = m_renderPass.handle(),
+        .framebuffer       = m_renderPass.frameBuffer(bufferIdx),
+        .renderArea = {
+            .offset = {0, 0},
+            .extent = m_swapChain.extent(),
+        },
+        .clearValueCount   = 2,
+        .pClearValues      = clearValues,
     };
 
-    if (vkBeginCommandBuffer(m_commandBuffers.at(i), &beginInfo) != VK_SUCCESS) {
-      throw std::runtime_error("failed to begin recording command buffer!");
+  vkCmdBeginRenderPass(m_commandBuffers.at(bufferIdx), &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+  // {
+  //   // Set depth bias (aka "Polygon offset")
+  //   // Required to avoid shadow mapping artifacts
+  //   vkCmdSetDepthBias(m_commandBuffers.at(bufferIdx), 1.25f, 0.0f, 1.75f);
+
+  //   vkCmdBindPipeline(m_commandBuffers.at(bufferIdx), VK_PIPELINE_BIND_POINT_GRAPHICS,
+  //   m_graphicsPipeline.depthPipeline()); vkCmdBindDescriptorSets(m_commandBuffers.at(bufferIdx),
+  //   VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline.layout(), 0, 1,
+  //   &(m_descriptorSets.depthDescriptor(bufferIdx)), 0, nullptr);
+
+  //   const VkBuffer vertexBuffers[] = {m_vertexBuffer.buffer()};
+  //   const VkDeviceSize offsets[]   = {0};
+  //   vkCmdBindVertexBuffers(m_commandBuffers.at(bufferIdx), 0, 1, vertexBuffers, offsets);
+  //   vkCmdDraw(m_commandBuffers.at(bufferIdx), m_vertexBuffer.count(), 1, 0, 0);
+  // }
+
+  // // Très important pour passer a la prochain subpass
+  // vkCmdNextSubpass(m_commandBuffers.at(bufferIdx), VK_SUBPASS_CONTENTS_INLINE);
+
+  {
+    vkCmdBindPipeline(m_commandBuffers.at(bufferIdx), VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline.pipeline());
+    const std::vector<uint32_t> dynamicOffsets = m_descriptorSets.dynamicOffsets(bufferIdx);
+    vkCmdBindDescriptorSets(m_commandBuffers.at(bufferIdx), VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            m_graphicsPipeline.layout(), 0, 1, &(m_descriptorSets.descriptor(bufferIdx)),
+                            static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
+
+    // m_buffers holds the vertex buffer then the index buffer
+    const VertexBuffer* vertexBuffer = dynamic_cast<const VertexBuffer*>(m_buffers[0]);
+    const IndexBuffer* indexBuffer   = dynamic_cast<const IndexBuffer*>(m_buffers[1]);
+    // Position stream at binding 0, attribute stream at binding 1
+    const VkBuffer vertexBuffers[] = {vertexBuffer->buffer(), vertexBuffer->buffer()};
+    const VkDeviceSize offsets[]   = {vertexBuffer->positionOffset(), vertexBuffer->attributeOffset()};
+    vkCmdBindVertexBuffers(m_commandBuffers.at(bufferIdx), 0, 2, vertexBuffers, offsets);
+    vkCmdPushConstants(m_commandBuffers.at(bufferIdx), m_graphicsPipeline.layout(), VK_SHADER_STAGE_VERTEX_BIT, 0,
+                       sizeof(Quantization), &vertexBuffer->quantization());
+    vkCmdBindIndexBuffer(m_commandBuffers.at(bufferIdx), indexBuffer->buffer(), 0, indexBuffer->indexType());
+
+    // One draw per material and a single descriptor set for all of them: the fragment shader reads its material from
+    // the storage buffer, and its texture from the array at the index the material holds
+    for (uint32_t r = m_lod.firstRange; r < m_lod.firstRange + m_lod.rangeCount; r++) {
+      const mesh::MaterialRange& range = m_ranges[r];
+      const uint32_t materialIndex     = static_cast<uint32_t>(range.materialId);
+      vkCmdPushConstants(m_commandBuffers.at(bufferIdx), m_graphicsPipeline.layout(), VK_SHADER_STAGE_FRAGMENT_BIT,
+                         sizeof(Quantization), sizeof(uint32_t), &materialIndex);
+      vkCmdDrawIndexed(m_commandBuffers.at(bufferIdx), range.indexCount, 1, range.firstIndex, 0, 0);
     }
+  }
 
-    VkClearValue clearValues[2];
-    clearValues[0].color        = {{0.0f, 0.0f, 0.2f, 0.0f}};
-    clearValues[1].depthStencil = {1.0f, 0};
-
-    const VkRenderPassBeginInfo renderPassBeginInfo = {
-          .sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-          .renderPass        = m_renderPass.handle(),
-          .framebuffer       = m_renderPass.frameBuffer(i),
-          .renderArea = {
-              .offset = {0, 0},
-              .extent = m_swapChain.extent(),
-          },
-          .clearValueCount   = 2,
-          .pClearValues      = clearValues,
-      };
-
-    vkCmdBeginRenderPass(m_commandBuffers.at(i), &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-    // {
-    //   // Set depth bias (aka "Polygon offset")
-    //   // Required to avoid shadow mapping artifacts
-    //   vkCmdSetDepthBias(m_commandBuffers.at(i), 1.25f, 0.0f, 1.75f);
-
-    //   vkCmdBindPipeline(m_commandBuffers.at(i), VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline.depthPipeline());
-    //   vkCmdBindDescriptorSets(m_commandBuffers.at(i), VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline.layout(),
-    //   0, 1, &(m_descriptorSets.depthDescriptor(i)), 0, nullptr);
-
-    //   const VkBuffer vertexBuffers[] = {m_vertexBuffer.buffer()};
-    //   const VkDeviceSize offsets[]   = {0};
-    //   vkCmdBindVertexBuffers(m_commandBuffers.at(i), 0, 1, vertexBuffers, offsets);
-    //   vkCmdDraw(m_commandBuffers.at(i), static_cast<uint32_t>(m_vertexBuffer.data().size()), 1, 0, 0);
-    // }
-
-    // // Très important pour passer a la prochain subpass
-    // vkCmdNextSubpass(m_commandBuffers.at(i), VK_SUBPASS_CONTENTS_INLINE);
-
-    {
-      vkCmdBindPipeline(m_commandBuffers.at(i), VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline.pipeline());
-      vkCmdBindDescriptorSets(m_commandBuffers.at(i), VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline.layout(), 0,
-                              1, &(m_descriptorSets.descriptor(i)), 0, nullptr);
-
-      const Buffer<Vertex>* vertexBuffer = dynamic_cast<const Buffer<Vertex>*>(m_buffers[0]);
-      const VkBuffer vertexBuffers[]     = {vertexBuffer->buffer()};
-      const VkDeviceSize offsets[]       = {0};
-      vkCmdBindVertexBuffers(m_commandBuffers.at(i), 0, 1, vertexBuffers, offsets);
-      vkCmdDraw(m_commandBuffers.at(i), static_cast<uint32_t>(vertexBuffer->data().size()), 1, 0, 0);
-    }
+  vkCmdEndRenderPass(m_commandBuffers.at(bufferIdx));
 
-    vkCmdEndRenderPass(m_commandBuffers.at(i));
+  // The fragment shader wrote its texture feedback with atomics, which FeedbackBuffers::take reads once the fence of
+  // the frame signals: the fence alone doesn't make shader writes visible to the host
+  const VkMemoryBarrier feedbackBarrier = {
+      .sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+      .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+      .dstAccessMask = VK_ACCESS_HOST_READ_BIT,
+  };
 
-    if (vkEndCommandBuffer(m_commandBuffers.at(i)) != VK_SUCCESS) {
-      throw std::runtime_error("failed to record command buffer!");
-    }
+  vkCmdPipelineBarrier(m_commandBuffers.at(bufferIdx), VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                       VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &feedbackBarrier, 0, nullptr, 0, nullptr);
+
+  if (vkEndCommandBuffer(m_commandBuffers.at(bufferIdx)) != VK_SUCCESS) {
+    throw std::runtime_error("failed to record command buffer!");
   }
 }
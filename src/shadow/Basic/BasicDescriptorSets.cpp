@@ -9,8 +9,10 @@
 #include <common/image/Attachment.hpp>  // for Attachment
 #include <common/QueueFamily.hpp>            // for vkl
 #include <common/RenderPass.hpp>             // for RenderPass
+#include <common/SwapChain.hpp>              // for SwapChain
 #include <common/buffer/IBuffer.hpp>         // for IBuffer, IUniformBuffers
 #include <common/image/Texture.hpp>                // for Texture;
+#include <vector>                            // for vector
 // clang-format on
 
 using namespace vkl;
@@ -21,7 +23,9 @@ using namespace vkl;
  * 2. Update avec un Buffer
  */
 void BasicDescriptorSets::createDescriptorSets() {
-  allocateDescriptorSets();
+  // The texture array is the last binding, sized to the textures of the model
+  // One per image for the shadow map and the feedback, the uniform buffer is bound with the offset of the image
+  allocateDescriptorSets(m_swapChain.numImages(), static_cast<uint32_t>(m_textures.size()));
 
   /* Update */
 
@@ -30,18 +34,15 @@ void BasicDescriptorSets::createDescriptorSets() {
   const IBuffer* materialBuffer                    = m_buffers[0];
   const VkDescriptorBufferInfo& materialBufferInfo = materialBuffer->descriptor();
 
-  // Texture Descriptor
-  const std::unique_ptr<Texture>& texture = m_textures[0];
-  const VkDescriptorImageInfo imageInfo = {
-    .sampler = texture->sample(),
-    .imageView =  texture->view(),
-    .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-  };
+  // Texture Descriptors, indexed by Material::textureIndex
+  const std::vector<VkDescriptorImageInfo> imageInfos = textureInfos();
 
   // On paramètre les descripteurs (on se rappelle que l'on en a mit un par frame)
-  const IUniformBuffers* ubo   = m_uniformBuffers[0];
+  const IUniformBuffers* ubo      = m_uniformBuffers[0];
+  const IUniformBuffers* feedback = m_uniformBuffers[1];
   for (size_t i = 0; i < m_descriptorSets.size(); i++) {
-    const VkDescriptorBufferInfo& bufferInfo = ubo->descriptor(i);
+    const VkDescriptorBufferInfo& bufferInfo   = ubo->descriptor(i);
+    const VkDescriptorBufferInfo& feedbackInfo = feedback->descriptor(i);
 
     // Image descriptor for the shadow map attachment
     const std::unique_ptr<Attachment>& depth_map = m_attachments[i];
@@ -54,17 +55,42 @@ void BasicDescriptorSets::createDescriptorSets() {
 
     writeDescriptorSets = {
         // Binding 0 : Vertex shader uniform buffer
-        misc::writeDescriptorSet(m_descriptorSets.at(i), VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 0, &bufferInfo),
+        misc::writeDescriptorSet(m_descriptorSets.at(i), VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 0, &bufferInfo),
         // Binding 1 : Fragment shader Depth input attachment
         misc::writeDescriptorSet(m_descriptorSets.at(i), VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1,
                                  &depthDescriptor),
-        // Binding 2 : Fragment shader uniform buffer
-        misc::writeDescriptorSet(m_descriptorSets.at(i), VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2, &materialBufferInfo),
-
-        //Binding 3 :
-        misc::writeDescriptorSet(m_descriptorSets.at(i), VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 3, &imageInfo),
+        // Binding 2 : Fragment shader storage buffer (Materials)
+        misc::writeDescriptorSet(m_descriptorSets.at(i), VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2, &materialBufferInfo),
+        // Binding 3 : Fragment shader storage buffer (texture feedback)
+        misc::writeDescriptorSet(m_descriptorSets.at(i), VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3, &feedbackInfo),
+        // Binding 4 : Fragment shader texture array
+        misc::writeDescriptorSet(m_descriptorSets.at(i), VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4,
+                                 imageInfos.data(), static_cast<uint32_t>(imageInfos.size())),
     };
 
     vkUpdateDescriptorSets(m_device.logical(), writeDescriptorSets.size(), writeDescriptorSets.data(), 0, nullptr);
   }
 }
+
+void BasicDescriptorSets::writeTextures(uint32_t index) {
+  const std::vector<VkDescriptorImageInfo> imageInfos = textureInfos();
+
+  // Binding 4 : Fragment shader texture array
+  const VkWriteDescriptorSet writeDescriptorSet = misc::writeDescriptorSet(
+      m_descriptorSets.at(index), VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4, imageInfos.data(),
+      static_cast<uint32_t>(imageInfos.size()));
+
+  vkUpdateDescriptorSets(m_device.logical(), 1, &writeDescriptorSet, 0, nullptr);
+}
+
+std::vector<VkDescriptorImageInfo> BasicDescriptorSets::textureInfos() const {
+  std::vector<VkDescriptorImageInfo> imageInfos;
+  for (const std::shared_ptr<Texture>& texture : m_textures) {
+    imageInfos.push_back({
+        .sampler     = texture->sample(),
+        .imageView   = texture->view(),
+        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+    });
+  }
+  return imageInfos;
+}
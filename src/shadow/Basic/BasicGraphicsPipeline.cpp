@@ -1,5 +1,6 @@
 // clang-format off
 #include <shadow/Basic/BasicGraphicsPipeline.hpp>
+#include <shadow_mapping_compact_vert.h>     // for SHADOW_MAPPING_COMPACT_VERT
 #include <shadow_mapping_frag.h>             // for SHADOW_MAPPING_FRAG
 #include <shadow_mapping_vert.h>             // for SHADOW_MAPPING_VERT
 #include <common/VulkanHeader.hpp>              // for VkPipelineShaderStageCre...
@@ -7,7 +8,9 @@
 #include <common/Device.hpp>                 // for Device
 #include <common/RenderPass.hpp>             // for RenderPass
 #include <common/SwapChain.hpp>              // for vkl
-#include <common/misc/GraphicsPipeline.hpp>  // for pipelineShaderStageCreat...
+#include <common/misc/GraphicsPipeline.hpp>  // for pipelineShaderStageCreat..., splitVertexInput
+#include <common/misc/Specialization.hpp>    // for specializationInfo, specializationMapEntry
+#include <common/struct/CompactVertex.hpp>   // for CompactVertex, Quantization
 #include <common/struct/Vertex.hpp>          // for Vertex
 #include <stdexcept>                         // for runtime_error
 #include <vector>                            // for vector
@@ -19,8 +22,12 @@ using namespace vkl;
 BasicGraphicsPipeline::BasicGraphicsPipeline(const Device& device,
                                              const SwapChain& swapChain,
                                              const RenderPass& renderPass,
-                                             const DescriptorSetLayout& descriptorSetLayout)
-    : GraphicsPipeline(device, swapChain, renderPass, descriptorSetLayout) {
+                                             const DescriptorSetLayout& descriptorSetLayout,
+                                             VertexFormat vertexFormat,
+                                             bool textureFeedback)
+    : GraphicsPipeline(device, swapChain, renderPass, descriptorSetLayout),
+      m_vertexFormat(vertexFormat),
+      m_textureFeedback(textureFeedback) {
   createPipeline();
 }
 
@@ -28,11 +35,29 @@ BasicGraphicsPipeline::~BasicGraphicsPipeline() { destroyPipeline(); }
 
 void BasicGraphicsPipeline::createPipeline() {
   {
-    const VkDescriptorSetLayout layouts[]               = {m_descriptorSetLayout.handle()};
+    const VkDescriptorSetLayout layouts[] = {m_descriptorSetLayout.handle()};
+
+    const VkPushConstantRange pushConstantRanges[] = {
+        // Dequantization of the compact positions (unused by the float shaders)
+        {
+            .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+            .offset     = 0,
+            .size       = sizeof(Quantization),
+        },
+        // Index of the material drawn, in the material storage buffer
+        {
+            .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
+            .offset     = sizeof(Quantization),
+            .size       = sizeof(uint32_t),
+        },
+    };
+
     const VkPipelineLayoutCreateInfo pipelineLayoutInfo = {
-        .sType          = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-        .setLayoutCount = 1,
-        .pSetLayouts    = layouts,
+        .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        .setLayoutCount         = 1,
+        .pSetLayouts            = layouts,
+        .pushConstantRangeCount = 2,
+        .pPushConstantRanges    = pushConstantRanges,
     };
 
     if (vkCreatePipelineLayout(m_device.logical(), &pipelineLayoutInfo, nullptr, &m_layout) != VK_SUCCESS) {
@@ -50,16 +75,35 @@ void BasicGraphicsPipeline::createPipeline() {
   VkPipelineColorBlendStateCreateInfo colorBlending;
   VkPipelineDepthStencilStateCreateInfo depthStencil;
 
-  initDefaultPipeline<Vertex>(vertexInputInfo, inputAssembly, viewportState, rasterizer, multisampling, colorBlending,
-                              depthStencil);
+  // Position stream at binding 0, the other attributes at binding 1
+  std::vector<VkVertexInputBindingDescription> bindingDescriptions;
+  std::vector<VkVertexInputAttributeDescription> attributeDescriptions;
+  if (m_vertexFormat == VertexFormat::Compact) {
+    misc::splitVertexInput<CompactVertex>(false, bindingDescriptions, attributeDescriptions);
+  } else {
+    misc::splitVertexInput<Vertex>(false, bindingDescriptions, attributeDescriptions);
+  }
+
+  initDefaultPipeline(bindingDescriptions, attributeDescriptions, vertexInputInfo, inputAssembly, viewportState,
+                      rasterizer, multisampling, colorBlending, depthStencil);
 
   {
-    const VkShaderModule vertShaderModule = createShaderModule(SHADOW_MAPPING_VERT);
+    const std::vector<unsigned char>& vertShaderCode
+        = (m_vertexFormat == VertexFormat::Compact) ? SHADOW_MAPPING_COMPACT_VERT : SHADOW_MAPPING_VERT;
+
+    const VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
     const VkShaderModule fragShaderModule = createShaderModule(SHADOW_MAPPING_FRAG);
 
     shaderStages[0] = misc::pipelineShaderStageCreateInfo(vertShaderModule, VK_SHADER_STAGE_VERTEX_BIT);
     shaderStages[1] = misc::pipelineShaderStageCreateInfo(fragShaderModule, VK_SHADER_STAGE_FRAGMENT_BIT);
 
+    // constant_id 0 : writeFeedback
+    const VkBool32 writeFeedback                  = m_textureFeedback;
+    const VkSpecializationMapEntry specialization = misc::specializationMapEntry(0, 0, sizeof(VkBool32));
+    const VkSpecializationInfo specializationInfo
+        = misc::specializationInfo(1, &specialization, sizeof(VkBool32), &writeFeedback);
+    shaderStages[1].pSpecializationInfo = &specializationInfo;
+
     const VkGraphicsPipelineCreateInfo pipelineInfo = {
         .sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
         .stageCount          = 2,
@@ -8,9 +8,9 @@
 #include <common/GraphicsPipeline.hpp>  // for GraphicsPipeline
 #include <common/RenderPass.hpp>        // for RenderPass
 #include <common/SwapChain.hpp>         // for SwapChain
-#include <common/buffer/Buffer.hpp>     // for Buffer
+#include <common/buffer/IndexBuffer.hpp>  // for IndexBuffer
+#include <common/buffer/VertexBuffer.hpp>  // for VertexBuffer
 #include <common/buffer/IBuffer.hpp>    // for IBuffer
-#include <common/struct/Vertex.hpp>     // for Vertex
 // clang-format on
 
 #ifndef SHADOWMAP_DIM
@@ -66,15 +66,36 @@ void DepthCommandBuffers::recordCommandBuffers(uint32_t bufferIdx) {
     vkCmdSetDepthBias(m_commandBuffers.at(bufferIdx), m_depthBiasConstant, 0.0f, m_depthBiasSlope);
 
     vkCmdBindPipeline(m_commandBuffers.at(bufferIdx), VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline.pipeline());
+    const std::vector<uint32_t> dynamicOffsets = m_descriptorSets.dynamicOffsets(bufferIdx);
     vkCmdBindDescriptorSets(m_commandBuffers.at(bufferIdx), VK_PIPELINE_BIND_POINT_GRAPHICS,
-                            m_graphicsPipeline.layout(), 0, 1, &(m_descriptorSets.descriptor(bufferIdx)), 0, nullptr);
+                            m_graphicsPipeline.layout(), 0, 1, &(m_descriptorSets.descriptor(bufferIdx)),
+                            static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
 
-    const Buffer<Vertex>* vertexBuffer = dynamic_cast<const Buffer<Vertex>*>(m_buffers[0]);
+    // m_buffers holds the vertex buffer then the index buffer
+    const VertexBuffer* vertexBuffer = dynamic_cast<const VertexBuffer*>(m_buffers[0]);
+    const IndexBuffer* indexBuffer   = dynamic_cast<const IndexBuffer*>(m_buffers[1]);
 
+    // Only the position stream : the shadow map doesn't need the other attributes
     const VkBuffer vertexBuffers[] = {vertexBuffer->buffer()};
-    const VkDeviceSize offsets[]   = {0};
+    const VkDeviceSize offsets[]   = {vertexBuffer->positionOffset()};
     vkCmdBindVertexBuffers(m_commandBuffers.at(bufferIdx), 0, 1, vertexBuffers, offsets);
-    vkCmdDraw(m_commandBuffers.at(bufferIdx), static_cast<uint32_t>(vertexBuffer->data().size()), 1, 0, 0);
+    vkCmdPushConstants(m_commandBuffers.at(bufferIdx), m_graphicsPipeline.layout(), VK_SHADER_STAGE_VERTEX_BIT, 0,
+                       sizeof(Quantization), &vertexBuffer->quantization());
+    vkCmdBindIndexBuffer(m_commandBuffers.at(bufferIdx), indexBuffer->buffer(), 0, indexBuffer->indexType());
+
+    // The material doesn't matter here: the ranges which follow each other in the index buffer are drawn at once,
+    // a single draw for a whole level, one per run of resident clusters out of core (see ClusterStreamer)
+    if (m_lod.rangeCount == 0) {
+      vkCmdDrawIndexed(m_commandBuffers.at(bufferIdx), m_lod.indexCount, 1, m_lod.firstIndex, 0, 0);
+    }
+    for (uint32_t r = m_lod.firstRange; r < m_lod.firstRange + m_lod.rangeCount;) {
+      const uint32_t firstIndex = m_ranges[r].firstIndex;
+      uint32_t indexCount       = m_ranges[r].indexCount;
+      for (r++; r < m_lod.firstRange + m_lod.rangeCount && m_ranges[r].firstIndex == firstIndex + indexCount; r++) {
+        indexCount += m_ranges[r].indexCount;
+      }
+      vkCmdDrawIndexed(m_commandBuffers.at(bufferIdx), indexCount, 1, firstIndex, 0, 0);
+    }
     vkCmdEndRenderPass(m_commandBuffers.at(bufferIdx));
   }
 
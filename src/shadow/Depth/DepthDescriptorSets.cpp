@@ -1,6 +1,6 @@
 // clang-format off
 #include <shadow/Depth/DepthDescriptorSets.hpp>
-#include <stddef.h>                       // for size_t
+#include <vector>                         // for vector
 #include <common/VulkanHeader.hpp>           // for VkWriteDescriptorSet, vkUpd...
 #include <common/misc/DescriptorSet.hpp>  // for writeDescriptorSet
 #include <common/struct/Depth.hpp>        // for Depth
@@ -12,19 +12,16 @@
 using namespace vkl;
 
 void DepthDescriptorSets::createDescriptorSets() {
-  allocateDescriptorSets();
+  // A single set, the images only differ by the dynamic offset of the uniform buffer
+  allocateDescriptorSets(1);
 
   /* Update */
-  std::vector<VkWriteDescriptorSet> writeDescriptorSets;
-  const IUniformBuffers* depthUBO = m_uniformBuffers[0];
+  const IUniformBuffers* depthUBO          = m_uniformBuffers[0];
+  const VkDescriptorBufferInfo& bufferInfo = depthUBO->descriptor(0);
 
-  for (size_t i = 0; i < m_descriptorSets.size(); i++) {
-    const VkDescriptorBufferInfo& bufferInfo = depthUBO->descriptor(i);
+  const std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
+      misc::writeDescriptorSet(m_descriptorSets.at(0), VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 0, &bufferInfo),
+  };
 
-    writeDescriptorSets = {
-        misc::writeDescriptorSet(m_descriptorSets.at(i), VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 0, &bufferInfo),
-    };
-
-    vkUpdateDescriptorSets(m_device.logical(), writeDescriptorSets.size(), writeDescriptorSets.data(), 0, nullptr);
-  }
+  vkUpdateDescriptorSets(m_device.logical(), writeDescriptorSets.size(), writeDescriptorSets.data(), 0, nullptr);
 }
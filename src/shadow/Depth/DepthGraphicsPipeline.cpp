@@ -1,13 +1,15 @@
 // clang-format off
 #include <shadow/Depth/DepthGraphicsPipeline.hpp>
 #include <depth_basic_vert.h>                // for DEPTH_BASIC_VERT
+#include <depth_compact_vert.h>              // for DEPTH_COMPACT_VERT
 #include <stdint.h>                          // for uint32_t
 #include <common/VulkanHeader.hpp>              // for VkDynamicState, VkPipeli...
 #include <common/DescriptorSetLayout.hpp>    // for DescriptorSetLayout
 #include <common/Device.hpp>                 // for Device
 #include <common/RenderPass.hpp>             // for RenderPass
 #include <common/SwapChain.hpp>              // for vkl
-#include <common/misc/GraphicsPipeline.hpp>  // for pipelineShaderStageCreat...
+#include <common/misc/GraphicsPipeline.hpp>  // for pipelineShaderStageCreat..., splitVertexInput
+#include <common/struct/CompactVertex.hpp>   // for CompactVertex, Quantization
 #include <common/struct/Vertex.hpp>          // for Vertex
 #include <stdexcept>                         // for runtime_error
 #include <vector>                            // for vector
@@ -19,8 +21,9 @@ using namespace vkl;
 DepthGraphicsPipeline::DepthGraphicsPipeline(const Device& device,
                                              const SwapChain& swapChain,
                                              const RenderPass& renderPass,
-                                             const DescriptorSetLayout& descriptorSetLayout)
-    : GraphicsPipeline(device, swapChain, renderPass, descriptorSetLayout) {
+                                             const DescriptorSetLayout& descriptorSetLayout,
+                                             VertexFormat vertexFormat)
+    : GraphicsPipeline(device, swapChain, renderPass, descriptorSetLayout), m_vertexFormat(vertexFormat) {
   createPipeline();
 }
 
@@ -30,11 +33,21 @@ void DepthGraphicsPipeline::createPipeline() {
   // Creation Layout
   // TODO : made a separated method
   {
-    const VkDescriptorSetLayout layouts[]               = {m_descriptorSetLayout.handle()};
+    const VkDescriptorSetLayout layouts[] = {m_descriptorSetLayout.handle()};
+
+    // Dequantization of the compact positions (unused by the float shaders)
+    const VkPushConstantRange pushConstantRange = {
+        .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+        .offset     = 0,
+        .size       = sizeof(Quantization),
+    };
+
     const VkPipelineLayoutCreateInfo pipelineLayoutInfo = {
-        .sType          = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-        .setLayoutCount = 1,
-        .pSetLayouts    = layouts,
+        .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        .setLayoutCount         = 1,
+        .pSetLayouts            = layouts,
+        .pushConstantRangeCount = 1,
+        .pPushConstantRanges    = &pushConstantRange,
     };
 
     if (vkCreatePipelineLayout(m_device.logical(), &pipelineLayoutInfo, nullptr, &m_layout) != VK_SUCCESS) {
@@ -52,13 +65,25 @@ void DepthGraphicsPipeline::createPipeline() {
   VkPipelineColorBlendStateCreateInfo colorBlending;
   VkPipelineDepthStencilStateCreateInfo depthStencil;
 
-  initDefaultPipeline<Vertex>(vertexInputInfo, inputAssembly, viewportState, rasterizer, multisampling, colorBlending,
-                              depthStencil);
+  // The depth pass only reads the position stream
+  std::vector<VkVertexInputBindingDescription> bindingDescriptions;
+  std::vector<VkVertexInputAttributeDescription> attributeDescriptions;
+  if (m_vertexFormat == VertexFormat::Compact) {
+    misc::splitVertexInput<CompactVertex>(true, bindingDescriptions, attributeDescriptions);
+  } else {
+    misc::splitVertexInput<Vertex>(true, bindingDescriptions, attributeDescriptions);
+  }
+
+  initDefaultPipeline(bindingDescriptions, attributeDescriptions, vertexInputInfo, inputAssembly, viewportState,
+                      rasterizer, multisampling, colorBlending, depthStencil);
 
   {
     /* Depth pipeline (vertex shader only) */
 
-    const VkShaderModule vertShaderModule = createShaderModule(DEPTH_BASIC_VERT);
+    const std::vector<unsigned char>& vertShaderCode
+        = (m_vertexFormat == VertexFormat::Compact) ? DEPTH_COMPACT_VERT : DEPTH_BASIC_VERT;
+
+    const VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
     shaderStages[0] = misc::pipelineShaderStageCreateInfo(vertShaderModule, VK_SHADER_STAGE_VERTEX_BIT);
 
     // Enable depth bias
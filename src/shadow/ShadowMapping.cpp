@@ -1,13 +1,14 @@
 // clang-format off
 #include <shadow/ShadowMapping.hpp>
+#include <algorithm>                               // for min, min_element
 #include <chrono>                                  // for duration, operator-
 #include <common/misc/DescriptorPool.hpp>          // for descriptorPoolSize
 #include <common/misc/DescriptorSetLayout.hpp>     // for descriptorSetLayou...
 #include <cstdint>                                 // for uint32_t, UINT64_MAX
-#include <cstring>                                 // for memcpy
-#include <deque>                                   // for deque
+#include <iostream>                                // for cout
 #include <memory>                                  // for allocator_traits<>...
 #include <stdexcept>                               // for runtime_error
+#include <utility>                                 // for move
 #include <GLFW/glfw3.h>                            // for glfwWaitEvents
 #include <common/Application.hpp>                  // for Application, Debug...
 #include <common/DebugUtilsMessenger.hpp>          // for vkl
@@ -15,11 +16,21 @@
 #include <common/Device.hpp>                       // for Device
 #include <common/ImGui/ImGuiApp.hpp>               // for ImGuiApp
 #include <common/Model.hpp>                        // for Model
+#include <common/ModelLoader.hpp>                  // for ModelLoader
 #include <common/SwapChain.hpp>                    // for SwapChain
 #include <common/SyncObjects.hpp>                  // for SyncObjects
 #include <common/Window.hpp>                       // for Window
 #include <common/buffer/Buffer.hpp>                // for Buffer
+#include <common/buffer/IndexBuffer.hpp>           // for IndexBuffer
+#include <common/buffer/MeshletBuffer.hpp>         // for MeshletBuffer
+#include <common/buffer/StagingRing.hpp>           // for StagingRing
+#include <common/buffer/VertexBuffer.hpp>          // for VertexBuffer
 #include <common/buffer/UniformBuffers.hpp>        // for UniformBuffers
+#include <common/image/SamplerCache.hpp>           // for SamplerCache
+#include <common/buffer/ClusterStreamer.hpp>       // for ClusterStreamer
+#include <common/memory/MemoryAllocator.hpp>       // for MemoryAllocator
+#include <common/mesh/Frustum.hpp>                 // for extractFrustum, Frustum
+#include <common/mesh/Lod.hpp>                     // for selectLod, LodChain
 #include <common/struct/Depth.hpp>                 // for Depth
 #include <common/struct/DepthMVP.hpp>              // for DepthMVP
 #include <glm/glm.hpp>
@@ -51,63 +62,80 @@ static Light light = {
     .axis = glm::vec3(1.f, 1.5f, 1.f),
 };
 
+// The level of detail of each pass is chosen from these
+static const glm::vec3 cameraPosition = glm::vec3(2.0f);
+static const float cameraFOV          = 45.0f;
+static const float lightFOV           = 45.0f;
+
+// Upper bound of the texture array, the pool holds that many descriptors per image of the swap chain
+static const uint32_t maxModelTextures = 1024;
+
+// What the device allows next to the other descriptors of the fragment shader
+static uint32_t textureArraySize(const Device& device) {
+  const VkPhysicalDeviceLimits& limits = device.limits();
+  const uint32_t samplers = std::min({limits.maxPerStageDescriptorSamplers, limits.maxPerStageDescriptorSampledImages,
+                                      limits.maxDescriptorSetSamplers, limits.maxDescriptorSetSampledImages});
+  // The shadow map, and the uniform and storage buffers
+  return std::min({samplers - 1, limits.maxPerStageResources - 4, maxModelTextures});
+}
+
+static float millisecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static glm::mat4 cameraView() { return glm::lookAt(cameraPosition, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f)); }
+
+static glm::mat4 cameraProj(const SwapChain& swapChain) {
+  const float aspect = swapChain.extent().width / (float)swapChain.extent().height;
+  glm::mat4 proj     = glm::perspective(glm::radians(cameraFOV), aspect, 0.1f, 100.0f);
+  proj[1][1] *= -1;
+  return proj;
+}
+
+static glm::mat4 lightViewProj() {
+  // Keep depth range as small as possible
+  // for better shadow map precision
+  float zNear = 0.1f;
+  float zFar  = 10.0f;
+
+  glm::mat4 depthView = glm::lookAt(light.position, glm::vec3(0.0f), glm::vec3(0, 1, 0));
+  glm::mat4 depthProj = glm::perspective(glm::radians(lightFOV), 1.0f, zNear, zFar);
+
+  depthProj[1][1] *= -1;
+
+  return depthProj * depthView;
+}
+
 void updateBasicUniformBuffers(const Device& device,
                                const SwapChain& swapChain,
-                               std::deque<Buffer<DepthMVP>>& uniformBuffers,
+                               DepthMVP& ubo,
                                float time,
                                uint32_t currentImage) {
-  DepthMVP& ubo = uniformBuffers.at(currentImage).data().at(0);
 
   ubo.model = glm::mat4(1.0f);
-  ubo.view  = glm::lookAt(glm::vec3(2.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-
-  const float aspect = swapChain.extent().width / (float)swapChain.extent().height;
-  ubo.proj           = glm::perspective(glm::radians(45.0f), aspect, 0.1f, 100.0f);
+  ubo.view  = cameraView();
+  ubo.proj  = cameraProj(swapChain);
 
   // ubo.model = glm::mat4(1.0f);
   // ubo.view  = glm::lookAt(light.position, glm::vec3(0.0f), glm::vec3(0, 1, 0));
   // ubo.proj  = glm::perspective(glm::radians(80.0f), 1.0f, 0.1f, 100.0f);
 
-  ubo.proj[1][1] *= -1;
-
   light.position = glm::vec3(glm::vec4(light.axis, 1)
                              * glm::rotate(glm::mat4(1.0f), time * glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
 
   ubo.lightPos = light.position;
-
-  void* data;
-  vkMapMemory(device.logical(), uniformBuffers[currentImage].memory(), 0, sizeof(DepthMVP), 0, &data);
-  memcpy(data, &ubo, sizeof(DepthMVP));
-  vkUnmapMemory(device.logical(), uniformBuffers[currentImage].memory());
 }
 
 void updateDepthUniformBuffers(const Device& device,
                                const SwapChain& swapChain,
-                               std::deque<Buffer<Depth>>& uniformBuffers,
+                               Depth& ubo,
                                float time,
                                uint32_t currentImage) {
-  Depth& ubo = uniformBuffers.at(currentImage).data().at(0);
-
-  // Keep depth range as small as possible
-  // for better shadow map precision
-  float zNear = 0.1f;
-  float zFar  = 10.0f;
-
-  float lightFOV = 45.0f;
 
   // Matrix from light's point of view
   glm::mat4 depthModel = glm::mat4(1.0f);
-  glm::mat4 depthView  = glm::lookAt(light.position, glm::vec3(0.0f), glm::vec3(0, 1, 0));
-  glm::mat4 depthProj  = glm::perspective(glm::radians(lightFOV), 1.0f, zNear, zFar);
-
-  depthProj[1][1] *= -1;
 
-  ubo.depthMVP = depthProj * depthView * depthModel;
-
-  void* data;
-  vkMapMemory(device.logical(), uniformBuffers[currentImage].memory(), 0, sizeof(Depth), 0, &data);
-  memcpy(data, &ubo, sizeof(Depth));
-  vkUnmapMemory(device.logical(), uniformBuffers[currentImage].memory());
+  ubo.depthMVP = lightViewProj() * depthModel;
 }
 
 /**
@@ -129,23 +157,34 @@ void updateDepthUniformBuffers(const Device& device,
  * cb  is for CommandBuffers
  */
 
-ShadowMapping::ShadowMapping(const std::string& appName, const DebugOption& debugOption, const std::string& modelPath)
-    : Application(appName, debugOption),
+ShadowMapping::ShadowMapping(const std::string& appName,
+                             const DebugOption& debugOption,
+                             const std::string& modelPath,
+                             const ModelOption& modelOption)
+    // Every texture of the model is in one array, indexed by the material; the fragment shader writes how it samples
+    // them only to stream them
+    : Application(appName, debugOption, {.textureArray = true, .textureFeedback = modelOption.streamTextures}),
+
+      textureCache(device, modelOption.streamTextures ? TextureStreamer::DefaultTailSize : 0),
+      modelLoader(std::make_unique<ModelLoader>(modelPath, textureCache, modelOption)),
 
       commandPool(device, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT),
-      model(device, commandPool, modelPath),
+      stagingRing(device, device.graphicsQueue()),
+      model(Model::Placeholder(device, stagingRing, textureCache, modelOption)),
 
       // Buffer
-      vertexBuffer(device,
-                   model.vertices(),
-                   VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
-      uniformBuffers(device, swapChain, &updateBasicUniformBuffers),
-      materialUniformBuffer(device,
-                            model.materials(),
-                            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
-      depthUniformBuffer(device, swapChain, &updateDepthUniformBuffers),
+      uniformRing(device, swapChain),
+      uniformBuffers(uniformRing, &updateBasicUniformBuffers),
+      // Retained, the UI edits the materials
+      materialBuffer(std::make_unique<Buffer<Material>>(
+          device,
+          model.materials(),
+          VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+          Buffer<Material>::Retained,
+          MemoryCategory::Uniform)),
+      feedbackBuffers(device, swapChain, static_cast<uint32_t>(model.textures().size())),
+      depthUniformBuffer(uniformRing, &updateDepthUniformBuffers),
 
       /**
        * Depth
@@ -157,30 +196,41 @@ ShadowMapping::ShadowMapping(const std::string& appName, const DebugOption& debu
       dslDepth(device,
                misc::descriptorSetLayoutCreateInfo({
                    // Binding 0 : Vertex shader uniform buffer
-                   misc::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, 0),
+                   misc::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                                                    VK_SHADER_STAGE_VERTEX_BIT,
+                                                    0),
                })),
 
       // 3. Graphic Pipeline
-      gpDepth(device, swapChain, rpDepth, dslDepth),
+      gpDepth(device, swapChain, rpDepth, dslDepth, model.vertexFormat()),
 
       // 4. Descriptor Pool
+      // A single set for all the images
       psDepth({
-          misc::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, swapChain.numImages()),
+          misc::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1),
       }),
-      dpiDepth(misc::descriptorPoolCreateInfo(psDepth, swapChain.numImages())),
+      dpiDepth(misc::descriptorPoolCreateInfo(psDepth, 1)),
       dpDepth(device, dpiDepth),
 
       // ~ My Vectors
       // Utile car sinon les pointeurs change, donc on copie d'abord par valeur
       // et on passe le vecteur qui sera concervé dans la class Application
       vecUBDepth({&depthUniformBuffer}),
-      vecVertexBuffer({&vertexBuffer}),
+      vecVertexBuffer({&model.vertexBuffer(), &model.indexBuffer()}),
 
       // 5. Descriptor Sets
       dsDepth(device, swapChain, dslDepth, dpDepth, {}, vecUBDepth),
 
       // 6. Command Buffers
-      cbDepth(device, rpDepth, swapChain, gpDepth, commandPool, dsDepth, vecVertexBuffer),
+      cbDepth(device,
+              rpDepth,
+              swapChain,
+              gpDepth,
+              commandPool,
+              dsDepth,
+              vecVertexBuffer,
+              model.lodChain().levels[0],
+              model.lodChain().ranges),
 
       /**
        * Basic
@@ -189,42 +239,74 @@ ShadowMapping::ShadowMapping(const std::string& appName, const DebugOption& debu
       rpBasic(device, swapChain),
 
       // 2. Descriptor Set Layout
+      maxTextures(textureArraySize(device)),
       dslBasic(device,
                // ce que le shader attend en entré
-               misc::descriptorSetLayoutCreateInfo({
-                   // Binding 0 : Vertex shader uniform buffer
-                   misc::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, 0),
-                   // Binding 1 : Fragment shader sampler (shadow map)
-                   misc::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                                                    VK_SHADER_STAGE_FRAGMENT_BIT,
-                                                    1),
-                   // Binding 2 : Fragment shader uniform buffer (Material)
-                   misc::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT, 2),
-
-                    // Binding 3 : Fragment shader uniform buffer (Texture)
-                   misc::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, 3),
-               })),
+               misc::descriptorSetLayoutCreateInfo(
+                   {
+                       // Binding 0 : Vertex shader uniform buffer
+                       misc::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                                                        VK_SHADER_STAGE_VERTEX_BIT,
+                                                        0),
+                       // Binding 1 : Fragment shader sampler (shadow map)
+                       misc::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                                        VK_SHADER_STAGE_FRAGMENT_BIT,
+                                                        1),
+                       // Binding 2 : Fragment shader storage buffer (Materials, indexed by a push constant)
+                       misc::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                                        VK_SHADER_STAGE_FRAGMENT_BIT,
+                                                        2),
+                       // Binding 3 : Fragment shader storage buffer (how each texture is sampled, read back)
+                       misc::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                                        VK_SHADER_STAGE_FRAGMENT_BIT,
+                                                        3),
+                       // Binding 4 : Fragment shader texture array, indexed by the material; last, since its size
+                       // is only known when the descriptor sets are allocated
+                       misc::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                                        VK_SHADER_STAGE_FRAGMENT_BIT,
+                                                        4,
+                                                        maxTextures),
+                   },
+                   misc::descriptorSetLayoutBindingFlagsCreateInfo({
+                       0,
+                       0,
+                       0,
+                       0,
+                       VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT,
+                   }))),
 
       // 3. Graphic Pipeline
-      gpBasic(device, swapChain, rpBasic, dslBasic),
+      gpBasic(device, swapChain, rpBasic, dslBasic, model.vertexFormat(), modelOption.streamTextures),
 
       // 4. Descriptor Pool
       psBasic({
-          misc::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, swapChain.numImages() * 2),
-          misc::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, swapChain.numImages() * 2),
+          misc::descriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, swapChain.numImages()),
+          misc::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, swapChain.numImages() * 2),
+          // The shadow map and the texture array
+          misc::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                   swapChain.numImages() * (1 + maxTextures)),
       }),
       dpiBasic(misc::descriptorPoolCreateInfo(psBasic, swapChain.numImages())),
       dpBasic(device, dpiBasic),
 
       // ~ My Vectors 2
-      vecUBBasic({&uniformBuffers}),
-      vecBBasic({&materialUniformBuffer}),
+      vecUBBasic({&uniformBuffers, &feedbackBuffers}),
+      vecBBasic({materialBuffer.get()}),
 
       // 5. Descriptor Sets
       dsBasic(device, swapChain, dslBasic, dpBasic, vecBBasic, vecUBBasic, model.textures(), rpDepth.attachments()),
 
       // 6. Command Buffers
-      cbBasic(device, rpBasic, swapChain, gpBasic, commandPool, dsBasic, vecVertexBuffer),
+      cbBasic(device,
+              rpBasic,
+              swapChain,
+              gpBasic,
+              commandPool,
+              dsBasic,
+              vecVertexBuffer,
+              model.lodChain().levels[cameraLod()],
+              model.lodChain().ranges),
+      textureGenerations(swapChain.numImages(), 0),
 
       /* ImGui */
       interface(instance, window, device, swapChain, gpBasic) {}
@@ -237,6 +319,8 @@ void ShadowMapping::mainLoop() {
 
   window.mainLoop();
   vkDeviceWaitIdle(device.logical());
+
+  writeMemoryStats();
 }
 
 /**
@@ -254,12 +338,20 @@ void ShadowMapping::mainLoop() {
  */
 
 void ShadowMapping::drawFrame(bool& framebufferResized) {
+  if (modelLoader && modelLoader->ready()) uploadModel();
+  if (uploadingModel && uploadingModel->uploaded(stagingRing)) swapModel();
+
   uint32_t imageIndex;
   VkResult result = prepareFrame(true, framebufferResized, imageIndex);
   if (result != VK_SUCCESS) return;
 
+  streamTextures(imageIndex);
+  if (model.outOfCore()) streamClusters(imageIndex);
+
   // Record UI draw data
   interface.recordCommandBuffers(imageIndex);
+  // The light moves, its level of detail is chosen again each frame
+  cbDepth.lod() = model.lodChain().levels[shadowLod()];
   cbDepth.recordCommandBuffers(imageIndex);
 
   /* Update Uniform Buffers */
@@ -270,9 +362,9 @@ void ShadowMapping::drawFrame(bool& framebufferResized) {
   float time       = std::chrono::duration<float, std::chrono::seconds::period>(currentTime - startTime).count();
 
   depthUniformBuffer.update(time, imageIndex);
-  uniformBuffers.data(imageIndex).at(0).depthBiasMVP = depthUniformBuffer.data(imageIndex).at(0).depthMVP;
+  uniformBuffers.data().depthBiasMVP = depthUniformBuffer.data().depthMVP;
   uniformBuffers.update(time, imageIndex);
-  materialUniformBuffer.update(time, imageIndex);
+  materialBuffer->update(time, imageIndex);
 
   /* Submit */
 
@@ -306,6 +398,11 @@ void ShadowMapping::drawFrame(bool& framebufferResized) {
 
   submitFrame(true, framebufferResized, imageIndex);
 
+  if (firstFrame) {
+    std::cout << "First frame: " << millisecondsSince(launchTime) << " ms" << std::endl;
+    firstFrame = false;
+  }
+
   currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
 }
 
@@ -328,25 +425,154 @@ void ShadowMapping::drawImGui() {
     ImGui::Text("frame: %d", ++frame);
     ImGui::Text("time: %.2f", time);
     ImGui::Text("fps: %.2f", ImGui::GetIO().Framerate);
+    if (modelLoader || uploadingModel) ImGui::Text("loading model...");
     ImGui::Separator();
     ImGui::Text("Light Setting");
     ImGui::SliderFloat3("Axis", glm::value_ptr(light.axis), 1.0f, 5.0f);
     ImGui::Separator();
     ImGui::Text("Material Setting");
-    ImGui::ColorEdit3("diffuse", glm::value_ptr(materialUniformBuffer.data().at(0).diffuse));
-    ImGui::ColorEdit3("specular", glm::value_ptr(materialUniformBuffer.data().at(0).specular));
-    ImGui::ColorEdit3("ambient", glm::value_ptr(materialUniformBuffer.data().at(0).ambient));
-    ImGui::SliderFloat("shininess", &(materialUniformBuffer.data().at(0).shininess), 0.5f, 256.0f);
+    ImGui::ColorEdit3("diffuse", glm::value_ptr(materialBuffer->data().at(0).diffuse));
+    ImGui::ColorEdit3("specular", glm::value_ptr(materialBuffer->data().at(0).specular));
+    ImGui::ColorEdit3("ambient", glm::value_ptr(materialBuffer->data().at(0).ambient));
+    ImGui::SliderFloat("shininess", &(materialBuffer->data().at(0).shininess), 0.5f, 256.0f);
     ImGui::Separator();
     ImGui::Text("Depth Setting");
     ImGui::SliderFloat("constant", &cbDepth.depthBiasConstant(), 0.0f, 5.0f);
     ImGui::SliderFloat("slope", &cbDepth.depthBiasSlope(), 0.0f, 5.0f);
+    ImGui::Separator();
+    ImGui::Text("LOD Setting");
+    ImGui::Text("camera: %zu / %zu", cameraLod(), model.lodChain().levels.size() - 1);
+    ImGui::Text("shadow: %zu / %zu", shadowLod(), model.lodChain().levels.size() - 1);
+    ImGui::SliderFloat("shadow error (px)", &shadowLodError, 0.0f, 16.0f);
+    ImGui::Separator();
+    ImGui::Text("Texture Streaming");
+    const TextureStreamer::Stats streaming = textureStreamer.stats();
+    ImGui::Text("resident: %zu KiB", textureCache.stats().residentBytes / 1024);
+    ImGui::Text("streamed: %zu KiB", streaming.streamedBytes / 1024);
+    ImGui::Text("promoted: %zu, evicted: %zu", streaming.promotions, streaming.evictions);
+    if (model.outOfCore()) {
+      ImGui::Separator();
+      ImGui::Text("Cluster Streaming");
+      const ClusterStreamer::Stats clusters = model.clusterStats();
+      ImGui::Text("drawn: %zu / %zu visible", clusters.drawn, clusters.visible);
+      ImGui::Text("slots: %zu", clusters.slots);
+      ImGui::Text("streamed: %zu KiB", clusters.streamedBytes / 1024);
+      ImGui::Text("evicted: %zu", clusters.evictions);
+    }
+    ImGui::Separator();
+    ImGui::Text("Memory");
+    interface.drawMemoryStats();
   }
 
   ImGui::End();
   ImGui::Render();
 }
 
+size_t ShadowMapping::cameraLod() const {
+  return mesh::selectLod(model.lodChain(), cameraPosition, static_cast<float>(swapChain.extent().height),
+                         glm::radians(cameraFOV), cameraLodError);
+}
+
+// The shadow map is rendered at the size of the swap chain, from the light
+size_t ShadowMapping::shadowLod() const {
+  return mesh::selectLod(model.lodChain(), light.position, static_cast<float>(swapChain.extent().height),
+                         glm::radians(lightFOV), shadowLodError);
+}
+
+void ShadowMapping::uploadModel() {
+  Model loaded = modelLoader->take();
+  modelLoader.reset();
+
+  if (loaded.textureKeys().size() > maxTextures) {
+    throw std::runtime_error("too many textures for the texture array!");
+  }
+
+  // Meanwhile the frames still draw the placeholder, uploaded() is polled once per frame
+  loaded.upload(device, stagingRing, textureCache);
+  uploadingModel = std::make_unique<Model>(std::move(loaded));
+}
+
+void ShadowMapping::swapModel() {
+  // The copies are done, only the frames in flight still draw the placeholder and use the descriptor sets
+  vkWaitForFences(device.logical(), MAX_FRAMES_IN_FLIGHT, &syncObjects.inFlightFence(0), VK_TRUE, UINT64_MAX);
+
+  model = std::move(*uploadingModel);
+  uploadingModel.reset();
+  // The textures of the placeholder the new model doesn't share
+  textureCache.trim();
+  textureStreamer.track(model.textures(), model.textureKeys());
+  feedbackBuffers.resize(static_cast<uint32_t>(model.textures().size()));
+
+  materialBuffer = std::make_unique<Buffer<Material>>(
+      device, model.materials(), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, Buffer<Material>::Retained,
+      MemoryCategory::Uniform);
+
+  // The descriptor sets and command buffers keep a reference on these vectors, not on their content
+  vecVertexBuffer = {&model.vertexBuffer(), &model.indexBuffer()};
+  vecBBasic       = {materialBuffer.get()};
+
+  dpBasic.recreate();
+  dsBasic.recreate();
+  textureGenerations.assign(swapChain.numImages(), textureStreamer.generation());
+  cbBasic.lod() = model.lodChain().levels[cameraLod()];
+  cbBasic.recreate();
+
+  std::cout << "Model ready: " << millisecondsSince(launchTime) << " ms" << std::endl;
+
+  const TextureCache::Stats stats = textureCache.stats();
+  std::cout << "Textures: " << stats.textures << " resident (" << stats.residentBytes / 1024 << " KiB), " << stats.hits
+            << " hits, " << stats.misses << " misses" << std::endl;
+
+  const SamplerCache::Stats samplers = device.samplers().stats();
+  std::cout << "Samplers: " << samplers.samplers << " live, " << samplers.hits << " hits, " << samplers.misses
+            << " misses" << std::endl;
+
+  const std::vector<MemoryAllocator::HeapStats> heaps = device.allocator().stats();
+  for (size_t i = 0; i < heaps.size(); i++) {
+    if (heaps[i].blocks == 0) continue;
+    std::cout << "Memory heap " << i << ": " << heaps[i].used / 1024 << " KiB in " << heaps[i].allocations
+              << " allocations, " << heaps[i].reserved / 1024 << " KiB in " << heaps[i].blocks << " blocks, peak "
+              << heaps[i].peakUsed / 1024 << " KiB" << std::endl;
+  }
+}
+
+void ShadowMapping::streamTextures(uint32_t imageIndex) {
+  // The frame which last rendered to the image is done; what it saw is measured against the views of its set, only
+  // those still current mean anything
+  const std::vector<TextureFeedback> feedback = feedbackBuffers.take(imageIndex);
+  if (textureGenerations[imageIndex] == textureStreamer.generation()) {
+    for (size_t i = 0; i < feedback.size() && i < model.textures().size(); i++) {
+      textureStreamer.feedback(*model.textures()[i], feedback[i]);
+    }
+  }
+
+  textureStreamer.update(stagingRing);
+
+  // The other sets are written when their image comes back, each frame draws the current views
+  if (textureGenerations[imageIndex] != textureStreamer.generation()) {
+    dsBasic.writeTextures(imageIndex);
+    textureGenerations[imageIndex] = textureStreamer.generation();
+    cbBasic.recordCommandBuffers(imageIndex);
+  }
+
+  // Once every set was written again, the frames which sampled the replaced images are done
+  textureStreamer.releaseRetired(stagingRing, *std::min_element(textureGenerations.begin(), textureGenerations.end()));
+}
+
+void ShadowMapping::streamClusters(uint32_t imageIndex) {
+  // Those the shadow map needs too, seen from the light
+  const std::vector<mesh::Frustum> frusta = {
+      mesh::extractFrustum(cameraProj(swapChain) * cameraView()),
+      mesh::extractFrustum(lightViewProj()),
+  };
+  model.streamClusters(stagingRing, frusta, cameraPosition, MAX_FRAMES_IN_FLIGHT);
+
+  // The draws follow the resident clusters, the image's command buffer is recorded again
+  cbBasic.lod() = model.lodChain().levels[0];
+  cbBasic.recordCommandBuffers(imageIndex);
+}
+
 // for resize window
 void ShadowMapping::recreateSwapChain(bool& framebufferResized) {
   glm::ivec2 size;
@@ -359,7 +585,10 @@ void ShadowMapping::recreateSwapChain(bool& framebufferResized) {
   vkDeviceWaitIdle(device.logical());
 
   swapChain.recreate();
+  uniformRing.recreate();
   uniformBuffers.recreate();
+  depthUniformBuffer.recreate();
+  feedbackBuffers.recreate();
 
   /**
    * Depth
@@ -377,6 +606,8 @@ void ShadowMapping::recreateSwapChain(bool& framebufferResized) {
   gpBasic.recreate();
   dpBasic.recreate();
   dsBasic.recreate();
+  textureGenerations.assign(swapChain.numImages(), textureStreamer.generation());
+  cbBasic.lod() = model.lodChain().levels[cameraLod()];
   cbBasic.recreate();
 
   interface.recreate();
@@ -0,0 +1,245 @@
+#include <doctest/doctest.h>
+
+#include <common/image/BlockCompression.hpp>
+#include <common/image/Mipmap.hpp>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+  // Writes the fields of a BC7 block from its lowest bit
+  struct BitWriter {
+    uint8_t block[16] = {};
+    uint32_t position = 0;
+
+    void write(uint32_t value, uint32_t count) {
+      for (uint32_t i = 0; i < count; i++, position++) {
+        block[position >> 3] |= ((value >> i) & 1) << (position & 7);
+      }
+    }
+  };
+
+  template <typename T> void put(std::vector<uint8_t>& data, size_t offset, T value) {
+    std::memcpy(data.data() + offset, &value, sizeof(T));
+  }
+
+  std::vector<uint8_t> decodeOne(VkFormat format, const uint8_t* block) {
+    return vkl::image::decompress(format, 4, 4, 1, block);
+  }
+
+}  // namespace
+
+TEST_CASE("blockChainSize") {
+  CHECK(vkl::image::blockBytes(VK_FORMAT_BC1_RGBA_SRGB_BLOCK) == 8);
+  CHECK(vkl::image::blockBytes(VK_FORMAT_BC7_UNORM_BLOCK) == 16);
+  CHECK(vkl::image::blockBytes(VK_FORMAT_R8G8B8A8_SRGB) == 0);
+
+  // 8x8 then 4x4, 2x2 and 1x1 which take a whole block each
+  CHECK(vkl::image::blockChainSize(VK_FORMAT_BC1_RGBA_UNORM_BLOCK, 8, 8, 4) == (4 + 1 + 1 + 1) * 8);
+  CHECK(vkl::image::blockChainSize(VK_FORMAT_BC3_UNORM_BLOCK, 6, 5, 1) == 4 * 16);
+
+  CHECK(vkl::image::isCompressedFile("assets/textures/atlas.KTX2"));
+  CHECK(vkl::image::isCompressedFile("atlas.dds"));
+  CHECK_FALSE(vkl::image::isCompressedFile("atlas.png"));
+}
+
+TEST_CASE("decompress BC1 and BC3") {
+  // Red and blue endpoints, the indices of the texels 0 to 3 are 0, 1, 2, 3
+  const uint8_t fourColors[8] = {0x00, 0xF8, 0x1F, 0x00, 0xE4, 0x00, 0x00, 0x00};
+
+  SUBCASE("BC1, 4 colors") {
+    const std::vector<uint8_t> pixels = decodeOne(VK_FORMAT_BC1_RGBA_UNORM_BLOCK, fourColors);
+
+    CHECK(pixels[0] == 255);
+    CHECK(pixels[2] == 0);
+    CHECK(pixels[4 + 2] == 255);
+    CHECK(pixels[8] == 170);
+    CHECK(pixels[8 + 2] == 85);
+    CHECK(pixels[12 + 3] == 255);
+    CHECK(pixels[16] == 255);  // texel 4, index 0
+  }
+
+  SUBCASE("BC1, 3 colors and transparent black") {
+    uint8_t threeColors[8];
+    std::memcpy(threeColors, fourColors, 8);
+    std::swap(threeColors[0], threeColors[2]);
+    std::swap(threeColors[1], threeColors[3]);
+
+    const std::vector<uint8_t> rgba = decodeOne(VK_FORMAT_BC1_RGBA_UNORM_BLOCK, threeColors);
+    CHECK(rgba[8] == 127);
+    CHECK(rgba[8 + 2] == 127);
+    CHECK(rgba[12 + 0] == 0);
+    CHECK(rgba[12 + 3] == 0);
+
+    const std::vector<uint8_t> rgb = decodeOne(VK_FORMAT_BC1_RGB_UNORM_BLOCK, threeColors);
+    CHECK(rgb[12 + 3] == 255);
+  }
+
+  SUBCASE("BC3") {
+    // Alpha from 255 to 0 in 7 steps, texels 0 to 3 take the indices 0, 1, 2, 7
+    uint8_t block[16] = {255, 0, 0x88, 0x0E, 0x00, 0x00, 0x00, 0x00};
+    std::memcpy(block + 8, fourColors, 8);
+
+    const std::vector<uint8_t> pixels = decodeOne(VK_FORMAT_BC3_UNORM_BLOCK, block);
+    CHECK(pixels[3] == 255);
+    CHECK(pixels[4 + 3] == 0);
+    CHECK(pixels[8 + 3] == 218);
+    CHECK(pixels[12 + 3] == 36);
+    CHECK(pixels[12] == 85);  // always 4 colors
+  }
+}
+
+TEST_CASE("decompress BC7") {
+  SUBCASE("Mode 6") {
+    BitWriter bits;
+    bits.write(1 << 6, 7);
+    for (uint32_t c = 0; c < 3; c++) {
+      bits.write(c == 0 ? 127 : 0, 7);
+      bits.write(c == 2 ? 127 : 0, 7);
+    }
+    bits.write(127, 7);
+    bits.write(63, 7);
+    bits.write(1, 1);  // p-bits
+    bits.write(0, 1);
+    bits.write(0, 3);   // texel 0, anchor
+    bits.write(15, 4);  // texel 1
+    bits.write(8, 4);   // texel 2
+
+    const std::vector<uint8_t> pixels = decodeOne(VK_FORMAT_BC7_UNORM_BLOCK, bits.block);
+    CHECK(pixels[0] == 255);
+    CHECK(pixels[1] == 1);  // the p-bit of the first endpoint
+    CHECK(pixels[3] == 255);
+    CHECK(pixels[4] == 0);
+    CHECK(pixels[4 + 2] == 254);
+    CHECK(pixels[4 + 3] == 126);
+    CHECK(pixels[8] == (30 * 255 + 34 * 0 + 32) >> 6);
+  }
+
+  SUBCASE("Mode 1, two subsets") {
+    // Partition 0 : the two right columns are the second subset, its anchor is the texel 15
+    BitWriter bits;
+    bits.write(1 << 1, 2);
+    bits.write(0, 6);
+    for (uint32_t c = 0; c < 3; c++) {
+      for (uint32_t s = 0; s < 2; s++) {
+        bits.write(s == 0 ? 63 : 0, 6);
+        bits.write(s == 0 ? 63 : 0, 6);
+      }
+    }
+    bits.write(1, 1);  // shared p-bits
+    bits.write(0, 1);
+
+    const std::vector<uint8_t> pixels = decodeOne(VK_FORMAT_BC7_UNORM_BLOCK, bits.block);
+    for (uint32_t i = 0; i < 16; i++) {
+      CHECK(pixels[i * 4] == ((i % 4) < 2 ? 255 : 0));
+      CHECK(pixels[i * 4 + 3] == 255);
+    }
+  }
+
+  SUBCASE("Reserved mode") {
+    const uint8_t block[16] = {};
+    CHECK(decodeOne(VK_FORMAT_BC7_UNORM_BLOCK, block) == std::vector<uint8_t>(16 * 4, 0));
+  }
+
+  SUBCASE("Partial blocks") {
+    const uint8_t blocks[8 * 3] = {0x00, 0xF8, 0x1F, 0x00};
+    const std::vector<uint8_t> pixels = vkl::image::decompress(VK_FORMAT_BC1_RGBA_UNORM_BLOCK, 6, 2, 2, blocks);
+
+    REQUIRE(pixels.size() == vkl::image::mipChainSize(6, 2, 2));
+    CHECK(pixels[(6 + 3) * 4] == 255);
+    CHECK(pixels[(6 + 5) * 4] == 0);
+  }
+}
+
+TEST_CASE("parseKtx2") {
+  const uint8_t identifier[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+  // 8x8 BC7, 4 levels, stored from the smallest
+  std::vector<uint8_t> file(80 + 4 * 24);
+  std::memcpy(file.data(), identifier, 12);
+  put<uint32_t>(file, 12, VK_FORMAT_BC7_SRGB_BLOCK);
+  put<uint32_t>(file, 16, 1);
+  put<uint32_t>(file, 20, 8);
+  put<uint32_t>(file, 24, 8);
+  put<uint32_t>(file, 36, 1);
+  put<uint32_t>(file, 40, 4);
+
+  const size_t sizes[4] = {4 * 16, 16, 16, 16};
+  for (int level = 3; level >= 0; level--) {
+    put<uint64_t>(file, 80 + level * 24, file.size());
+    put<uint64_t>(file, 80 + level * 24 + 8, sizes[level]);
+    file.resize(file.size() + sizes[level], static_cast<uint8_t>(level));
+  }
+
+  SUBCASE("Levels from the level 0") {
+    const vkl::image::CompressedImage image = vkl::image::parseKtx2(file.data(), file.size());
+
+    CHECK(image.format == VK_FORMAT_BC7_SRGB_BLOCK);
+    CHECK(image.width == 8);
+    CHECK(image.levels == 4);
+    REQUIRE(image.data.size() == 7 * 16);
+    CHECK(image.data.front() == 0);
+    CHECK(image.data[4 * 16] == 1);
+    CHECK(image.data.back() == 3);
+  }
+
+  SUBCASE("Layout only") {
+    const vkl::image::CompressedLayout layout = vkl::image::layoutCompressed(file.data(), file.size(), false);
+
+    REQUIRE(layout.offsets.size() == 4);
+    CHECK(layout.offsets[3] == 80 + 4 * 24);
+    CHECK(layout.offsets[0] == 80 + 4 * 24 + 3 * 16);
+
+    std::vector<uint8_t> blocks(7 * 16);
+    vkl::image::copyLevels(file.data(), layout, blocks.data());
+    CHECK(blocks == vkl::image::parseKtx2(file.data(), file.size()).data);
+  }
+
+  SUBCASE("Supercompressed") {
+    put<uint32_t>(file, 44, 2);
+    CHECK_THROWS_AS(vkl::image::parseKtx2(file.data(), file.size()), std::runtime_error);
+  }
+
+  SUBCASE("Truncated") {
+    CHECK_THROWS_AS(vkl::image::parseKtx2(file.data(), file.size() - 1), std::runtime_error);
+  }
+}
+
+TEST_CASE("parseDds") {
+  std::vector<uint8_t> file(128);
+  std::memcpy(file.data(), "DDS ", 4);
+  put<uint32_t>(file, 4, 124);
+  put<uint32_t>(file, 8, 0x20000);
+  put<uint32_t>(file, 12, 4);
+  put<uint32_t>(file, 16, 8);
+  put<uint32_t>(file, 28, 2);
+  put<uint32_t>(file, 80, 0x4);
+
+  SUBCASE("DXT1, as sRGB") {
+    std::memcpy(file.data() + 84, "DXT1", 4);
+    file.resize(128 + (2 + 1) * 8);
+
+    const vkl::image::CompressedImage image = vkl::image::parseDds(file.data(), file.size(), true);
+    CHECK(image.format == VK_FORMAT_BC1_RGBA_SRGB_BLOCK);
+    CHECK(image.width == 8);
+    CHECK(image.height == 4);
+    CHECK(image.levels == 2);
+    CHECK(image.data.size() == 3 * 8);
+  }
+
+  SUBCASE("DX10 BC7") {
+    std::memcpy(file.data() + 84, "DX10", 4);
+    file.resize(148 + (2 + 1) * 16);
+    put<uint32_t>(file, 128, 98);
+    put<uint32_t>(file, 132, 3);
+    put<uint32_t>(file, 140, 1);
+
+    CHECK(vkl::image::parseDds(file.data(), file.size(), true).format == VK_FORMAT_BC7_UNORM_BLOCK);
+    CHECK_THROWS_AS(vkl::image::parseDds(file.data(), file.size() - 1, true), std::runtime_error);
+  }
+
+  SUBCASE("Uncompressed") {
+    put<uint32_t>(file, 80, 0x40);
+    CHECK_THROWS_AS(vkl::image::parseDds(file.data(), file.size(), false), std::runtime_error);
+  }
+}
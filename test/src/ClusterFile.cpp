@@ -0,0 +1,126 @@
+#include <doctest/doctest.h>
+
+#include <common/loader/ClusterFile.hpp>
+#include <common/loader/ObjLoader.hpp>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+  std::string writeFile(const std::string& name, const std::string& content) {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+    std::ofstream(path, std::ios::binary) << content;
+    return path.string();
+  }
+
+  // A triangle by the positions of its corners and its material, to compare meshes whatever their order
+  using Corners = std::array<float, 10>;
+
+  Corners corners(const vkl::Vertex& a, const vkl::Vertex& b, const vkl::Vertex& c, int materialId) {
+    return {a.pos.x, a.pos.y, a.pos.z, b.pos.x, b.pos.y, b.pos.z, c.pos.x, c.pos.y, c.pos.z, float(materialId)};
+  }
+
+}  // namespace
+
+TEST_CASE("ClusterFile") {
+  writeFile("vkl_test_clusters.mtl",
+            "newmtl red\n"
+            "Kd 1 0 0\n"
+            "map_Kd red.png\n"
+            "newmtl blue\n"
+            "Kd 0 0 1\n");
+
+  // A 60 x 60 grid of quads, the left half red and the right half blue
+  const int size = 60;
+  std::ostringstream content;
+  content << "mtllib vkl_test_clusters.mtl\n";
+  for (int y = 0; y <= size; ++y) {
+    for (int x = 0; x <= size; ++x) content << "v " << x << ' ' << y << ' ' << (x * y) % 5 << '\n';
+  }
+  content << "vt 0 0\nvt 1 1\nvn 0 0 1\n";
+  for (int y = 0; y < size; ++y) {
+    content << "usemtl red\n";
+    for (int x = 0; x < size; ++x) {
+      if (x == size / 2) content << "usemtl blue\n";
+      const int v = y * (size + 1) + x + 1;
+      content << "f " << v << "/1/1 " << v + 1 << "/2/1 " << v + size + 2 << "/1/1 " << v + size + 1 << "/2/1\n";
+    }
+  }
+  const std::string objPath = writeFile("vkl_test_clusters.obj", content.str());
+
+  // Parts of a few lines, and several windows of sorted triangles
+  const vkl::ClusterBuildOption option = {
+      .clusterTriangles = 64,
+      .chunkSize        = 1024,
+      .memoryBudget     = 64 << 10,
+  };
+  const std::string clusterPath = vkl::ClusterFile::Path(objPath);
+  vkl::ClusterFile::Build(objPath, clusterPath, option);
+
+  const vkl::ClusterFile file(clusterPath);
+  CHECK(file.upToDate());
+  CHECK(file.triangleCount() == size * size * 2);
+  CHECK(file.min() == glm::vec3(0.0f));
+  CHECK(file.max() == glm::vec3(size, size, 4.0f));
+
+  REQUIRE(file.materials().size() == 2);
+  CHECK(file.materials()[0].diffuse == glm::vec3(1.0f, 0.0f, 0.0f));
+  CHECK(file.textures() == std::vector<std::string>{"red.png", ""});
+
+  SUBCASE("Same triangles as ObjLoader") {
+    const vkl::ObjData obj = vkl::ObjLoader::Load(objPath);
+
+    std::vector<Corners> expected;
+    for (size_t t = 0; t < obj.materialIds.size(); ++t) {
+      expected.push_back(corners(obj.vertices[3 * t], obj.vertices[3 * t + 1], obj.vertices[3 * t + 2],
+                                 obj.materialIds[t]));
+    }
+
+    std::vector<Corners> clustered;
+    for (const vkl::ClusterFile::Cluster& cluster : file.clusters()) {
+      const vkl::Vertex* vertices = file.vertices(cluster);
+      const uint32_t* indices     = file.indices(cluster);
+
+      // Within the limits, and inside its bounds
+      CHECK(cluster.indexCount <= 64 * 3);
+      CHECK(cluster.vertexCount <= 64);
+      CHECK(cluster.indexCount <= file.maxIndices());
+      CHECK(cluster.vertexCount <= file.maxVertices());
+      for (uint32_t v = 0; v < cluster.vertexCount; ++v) {
+        CHECK(glm::min(vertices[v].pos, cluster.min) == cluster.min);
+        CHECK(glm::max(vertices[v].pos, cluster.max) == cluster.max);
+      }
+
+      for (uint32_t i = 0; i < cluster.indexCount; i += 3) {
+        REQUIRE(std::max({indices[i], indices[i + 1], indices[i + 2]}) < cluster.vertexCount);
+        clustered.push_back(
+            corners(vertices[indices[i]], vertices[indices[i + 1]], vertices[indices[i + 2]], cluster.materialId));
+      }
+    }
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(clustered.begin(), clustered.end());
+    CHECK(clustered == expected);
+  }
+
+  SUBCASE("Open") {
+    // Up to date, read as is
+    CHECK(vkl::ClusterFile::Open(objPath)->clusters().size() == file.clusters().size());
+
+    // The source changed
+    writeFile("vkl_test_clusters.obj", content.str() + "f 1 2 3\n");
+    CHECK_FALSE(file.upToDate());
+    CHECK(vkl::ClusterFile::Open(objPath)->triangleCount() == size * size * 2 + 1);
+  }
+
+  SUBCASE("Errors") {
+    CHECK_THROWS(vkl::ClusterFile(writeFile("vkl_test_clusters.bad", "not a cluster file")));
+    CHECK_THROWS(vkl::ClusterFile::Build("does_not_exist.obj", clusterPath, option));
+  }
+}
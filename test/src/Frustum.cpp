@@ -0,0 +1,43 @@
+#include <doctest/doctest.h>
+
+#include <common/mesh/Frustum.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+TEST_CASE("Frustum") {
+  // Looking down -z from the origin, 90 degrees each way
+  const glm::mat4 proj       = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+  const glm::mat4 view       = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+  const vkl::mesh::Frustum f = vkl::mesh::extractFrustum(proj * view);
+
+  SUBCASE("Inside") {
+    CHECK(vkl::mesh::intersects(f, glm::vec3(-1.0f, -1.0f, -6.0f), glm::vec3(1.0f, 1.0f, -4.0f)));
+  }
+
+  SUBCASE("Straddling a plane") {
+    // Mostly to the left of the left plane, x = z
+    CHECK(vkl::mesh::intersects(f, glm::vec3(-20.0f, -1.0f, -6.0f), glm::vec3(-5.5f, 1.0f, -5.0f)));
+    // Across the near plane
+    CHECK(vkl::mesh::intersects(f, glm::vec3(-0.01f, -0.01f, -0.2f), glm::vec3(0.01f, 0.01f, 0.05f)));
+  }
+
+  SUBCASE("Outside") {
+    // Behind the viewer
+    CHECK_FALSE(vkl::mesh::intersects(f, glm::vec3(-1.0f, -1.0f, 4.0f), glm::vec3(1.0f, 1.0f, 6.0f)));
+    // Left, right, below and above
+    CHECK_FALSE(vkl::mesh::intersects(f, glm::vec3(-20.0f, -1.0f, -6.0f), glm::vec3(-7.0f, 1.0f, -5.0f)));
+    CHECK_FALSE(vkl::mesh::intersects(f, glm::vec3(7.0f, -1.0f, -6.0f), glm::vec3(20.0f, 1.0f, -5.0f)));
+    CHECK_FALSE(vkl::mesh::intersects(f, glm::vec3(-1.0f, -20.0f, -6.0f), glm::vec3(1.0f, -7.0f, -5.0f)));
+    CHECK_FALSE(vkl::mesh::intersects(f, glm::vec3(-1.0f, 7.0f, -6.0f), glm::vec3(1.0f, 20.0f, -5.0f)));
+    // Past the far plane
+    CHECK_FALSE(vkl::mesh::intersects(f, glm::vec3(-1.0f, -1.0f, -300.0f), glm::vec3(1.0f, 1.0f, -200.0f)));
+  }
+
+  SUBCASE("Flipped y") {
+    // As the Vulkan projections of the samples
+    glm::mat4 flipped = proj;
+    flipped[1][1] *= -1;
+    const vkl::mesh::Frustum g = vkl::mesh::extractFrustum(flipped * view);
+    CHECK(vkl::mesh::intersects(g, glm::vec3(-1.0f, -1.0f, -6.0f), glm::vec3(1.0f, 1.0f, -4.0f)));
+    CHECK_FALSE(vkl::mesh::intersects(g, glm::vec3(-1.0f, 7.0f, -6.0f), glm::vec3(1.0f, 20.0f, -5.0f)));
+  }
+}
@@ -0,0 +1,28 @@
+#include <doctest/doctest.h>
+
+#include <common/mesh/Indexer.hpp>
+
+TEST_CASE("Indexer") {
+  const vkl::Vertex a = {.pos = {0, 0, 0}, .normal = {0, 0, 1}, .color = {1, 1, 1}, .texCoord = {0, 0}};
+  const vkl::Vertex b = {.pos = {1, 0, 0}, .normal = {0, 0, 1}, .color = {1, 1, 1}, .texCoord = {1, 0}};
+  const vkl::Vertex c = {.pos = {1, 1, 0}, .normal = {0, 0, 1}, .color = {1, 1, 1}, .texCoord = {1, 1}};
+  const vkl::Vertex d = {.pos = {0, 1, 0}, .normal = {0, 0, 1}, .color = {1, 1, 1}, .texCoord = {0, 1}};
+
+  // Same position as a, but another normal : must not be merged
+  const vkl::Vertex e = {.pos = {0, 0, 0}, .normal = {0, 1, 0}, .color = {1, 1, 1}, .texCoord = {0, 0}};
+
+  const std::vector<vkl::Vertex> corners = {a, b, c, a, c, d, e, b, c};
+
+  std::vector<vkl::Vertex> vertices;
+  std::vector<uint32_t> indices;
+  vkl::mesh::indexVertices(corners, vertices, indices);
+
+  REQUIRE(vertices.size() == 5);
+  REQUIRE(indices.size() == corners.size());
+
+  CHECK(indices == std::vector<uint32_t>({0, 1, 2, 0, 2, 3, 4, 1, 2}));
+  for (size_t i = 0; i < corners.size(); ++i) {
+    CHECK(vertices[indices[i]].pos == corners[i].pos);
+    CHECK(vertices[indices[i]].normal == corners[i].normal);
+  }
+}
@@ -0,0 +1,191 @@
+#include <doctest/doctest.h>
+
+#include <common/mesh/Lod.hpp>
+#include <common/mesh/Simplify.hpp>
+
+#include <cmath>
+
+namespace {
+
+  // A closed UV sphere, with a UV seam where the sectors wrap around
+  vkl::MeshData makeSphere(uint32_t rings, uint32_t sectors) {
+    vkl::MeshData mesh;
+    for (uint32_t r = 0; r <= rings; ++r) {
+      for (uint32_t s = 0; s <= sectors; ++s) {
+        const float theta = 3.14159265f * r / rings, phi = 2.0f * 3.14159265f * s / sectors;
+        vkl::Vertex vertex{};
+        vertex.pos      = {std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)};
+        vertex.normal   = vertex.pos;
+        vertex.texCoord = {static_cast<float>(s) / sectors, static_cast<float>(r) / rings};
+        mesh.vertices.push_back(vertex);
+      }
+    }
+    for (uint32_t r = 0; r < rings; ++r) {
+      for (uint32_t s = 0; s < sectors; ++s) {
+        const uint32_t a = r * (sectors + 1) + s, b = a + 1, c = a + sectors + 1, d = c + 1;
+        mesh.indices.insert(mesh.indices.end(), {a, b, c, b, d, c});
+        mesh.materialIds.insert(mesh.materialIds.end(), {0, 0});
+      }
+    }
+    return mesh;
+  }
+
+  // A flat n x n grid in the XZ plane, the left half with material 0, the right half with material 1
+  vkl::MeshData makeGrid(uint32_t n) {
+    vkl::MeshData mesh;
+    for (uint32_t y = 0; y <= n; ++y) {
+      for (uint32_t x = 0; x <= n; ++x) {
+        vkl::Vertex vertex{};
+        vertex.pos    = {static_cast<float>(x), 0.0f, static_cast<float>(y)};
+        vertex.normal = {0.0f, 1.0f, 0.0f};
+        mesh.vertices.push_back(vertex);
+      }
+    }
+    for (uint32_t y = 0; y < n; ++y) {
+      for (uint32_t x = 0; x < n; ++x) {
+        const uint32_t a = y * (n + 1) + x, b = a + 1, c = a + n + 1, d = c + 1;
+        mesh.indices.insert(mesh.indices.end(), {a, c, b, b, c, d});
+        const int material = x < n / 2 ? 0 : 1;
+        mesh.materialIds.insert(mesh.materialIds.end(), {material, material});
+      }
+    }
+    return mesh;
+  }
+
+  glm::vec3 triangleNormal(const vkl::MeshData& mesh, const std::vector<uint32_t>& indices, size_t t) {
+    const glm::vec3& p0 = mesh.vertices[indices[t * 3]].pos;
+    const glm::vec3& p1 = mesh.vertices[indices[t * 3 + 1]].pos;
+    const glm::vec3& p2 = mesh.vertices[indices[t * 3 + 2]].pos;
+    return glm::cross(p1 - p0, p2 - p0);
+  }
+
+}  // namespace
+
+TEST_CASE("simplify") {
+  const vkl::MeshData grid = makeGrid(16);
+
+  SUBCASE("Target reached on a flat surface, without error") {
+    float error = -1.0f;
+    const std::vector<uint32_t> indices =
+        vkl::mesh::simplify(grid.indices, grid.vertices, grid.indices.size() / 4, 1e-4f, &error);
+
+    CHECK(indices.size() <= grid.indices.size() / 4);
+    CHECK(error == doctest::Approx(0.0f));
+
+    // Nothing flipped nor degenerate, and the borders are kept : the area is the same
+    float area = 0.0f;
+    for (size_t t = 0; t < indices.size() / 3; ++t) {
+      const glm::vec3 normal = triangleNormal(grid, indices, t);
+      CHECK(normal.y > 0.0f);
+      area += glm::length(normal) * 0.5f;
+    }
+    CHECK(area == doctest::Approx(256.0f));
+  }
+
+  SUBCASE("Nothing is done when no collapse fits in the error") {
+    const vkl::MeshData sphere = makeSphere(8, 12);
+    const std::vector<uint32_t> indices = vkl::mesh::simplify(sphere.indices, sphere.vertices, 0, 0.0f);
+    CHECK(indices.size() == sphere.indices.size());
+  }
+
+  SUBCASE("Material boundaries are kept") {
+    const std::vector<vkl::mesh::SimplifiedMesh> levels =
+        vkl::mesh::simplifyLevels(grid.indices, grid.vertices, grid.materialIds, {grid.indices.size() / 8}, 1e-4f);
+    REQUIRE(levels.size() == 1);
+    REQUIRE(levels[0].sources.size() * 3 == levels[0].indices.size());
+
+    for (size_t t = 0; t < levels[0].sources.size(); ++t) {
+      const int material = grid.materialIds[levels[0].sources[t]];
+      for (int k = 0; k < 3; ++k) {
+        const float x = grid.vertices[levels[0].indices[t * 3 + k]].pos.x;
+        CHECK((material == 0 ? x <= 8.0f : x >= 8.0f));
+      }
+    }
+  }
+}
+
+TEST_CASE("buildLodChain") {
+  const vkl::MeshData sphere = makeSphere(40, 60);
+  const vkl::mesh::LodChain chain = vkl::mesh::buildLodChain(sphere);
+
+  REQUIRE(chain.levels.size() == 4);
+  CHECK(chain.levels[0].firstIndex == 0);
+  CHECK(chain.levels[0].indexCount == sphere.indices.size());
+  CHECK(chain.levels[0].error == 0.0f);
+  CHECK(chain.materialIds.size() * 3 == chain.indices.size());
+  CHECK(chain.radius == doctest::Approx(1.0f));
+
+  for (size_t l = 1; l < chain.levels.size(); ++l) {
+    const vkl::mesh::LodLevel& level = chain.levels[l];
+    CHECK(level.firstIndex == chain.levels[l - 1].firstIndex + chain.levels[l - 1].indexCount);
+    CHECK(level.indexCount <= static_cast<uint32_t>(sphere.indices.size() * vkl::mesh::DefaultLodRatios[l - 1]));
+    CHECK(level.error >= chain.levels[l - 1].error);
+    CHECK(level.error <= chain.radius * vkl::mesh::LodMaxRelativeError);
+
+    // Every triangle still faces outward (those at the poles are degenerate from the start)
+    for (uint32_t t = level.firstIndex / 3; t < (level.firstIndex + level.indexCount) / 3; ++t) {
+      const glm::vec3 center = sphere.vertices[chain.indices[t * 3]].pos + sphere.vertices[chain.indices[t * 3 + 1]].pos
+                               + sphere.vertices[chain.indices[t * 3 + 2]].pos;
+      CHECK(glm::dot(triangleNormal(sphere, chain.indices, t), center) > -1e-6f);
+    }
+  }
+
+  // The ranges of each level cover it, one material after the other
+  for (const vkl::mesh::LodLevel& level : chain.levels) {
+    REQUIRE(level.rangeCount >= 1);
+    uint32_t next = level.firstIndex;
+    for (uint32_t r = level.firstRange; r < level.firstRange + level.rangeCount; ++r) {
+      const vkl::mesh::MaterialRange& range = chain.ranges[r];
+      CHECK(range.firstIndex == next);
+      for (uint32_t t = range.firstIndex / 3; t < (range.firstIndex + range.indexCount) / 3; ++t) {
+        CHECK(chain.materialIds[t] == range.materialId);
+      }
+      next += range.indexCount;
+    }
+    CHECK(next == level.firstIndex + level.indexCount);
+  }
+
+  SUBCASE("Two materials") {
+    const vkl::mesh::LodChain grid = vkl::mesh::buildLodChain(makeGrid(16));
+    for (const vkl::mesh::LodLevel& level : grid.levels) {
+      REQUIRE(level.rangeCount == 2);
+      CHECK(grid.ranges[level.firstRange].materialId == 0);
+      CHECK(grid.ranges[level.firstRange + 1].materialId == 1);
+    }
+  }
+
+  SUBCASE("No ratio, only the full mesh") {
+    const vkl::mesh::LodChain full = vkl::mesh::buildLodChain(sphere, {});
+    CHECK(full.levels.size() == 1);
+    CHECK(full.indices == sphere.indices);
+  }
+}
+
+TEST_CASE("selectLod") {
+  const vkl::mesh::LodChain chain = vkl::mesh::buildLodChain(makeSphere(40, 60));
+  const float fovy                = glm::radians(45.0f);
+
+  // Inside the bounding sphere, or close to it, the full mesh
+  CHECK(vkl::mesh::selectLod(chain, glm::vec3(0.0f), 1080.0f, fovy) == 0);
+  CHECK(vkl::mesh::selectLod(chain, glm::vec3(0.0f, 0.0f, 1.5f), 1080.0f, fovy) == 0);
+
+  // Far away, the coarsest level
+  CHECK(vkl::mesh::selectLod(chain, glm::vec3(0.0f, 0.0f, 1e4f), 1080.0f, fovy) == chain.levels.size() - 1);
+
+  // Never finer when the viewer moves away or the threshold grows
+  size_t previous = 0;
+  for (float distance = 1.0f; distance < 1e3f; distance *= 1.5f) {
+    const size_t level = vkl::mesh::selectLod(chain, glm::vec3(0.0f, 0.0f, distance), 1080.0f, fovy);
+    CHECK(level >= previous);
+    CHECK(vkl::mesh::selectLod(chain, glm::vec3(0.0f, 0.0f, distance), 1080.0f, fovy, 4.0f) >= level);
+    previous = level;
+  }
+
+  // The chosen level is under the threshold, the next one isn't
+  const glm::vec3 viewer(0.0f, 0.0f, 20.0f);
+  const size_t level = vkl::mesh::selectLod(chain, viewer, 1080.0f, fovy);
+  CHECK(vkl::mesh::projectedError(chain.levels[level].error, 19.0f, 1080.0f, fovy) <= 1.0f);
+  if (level + 1 < chain.levels.size()) {
+    CHECK(vkl::mesh::projectedError(chain.levels[level + 1].error, 19.0f, 1080.0f, fovy) > 1.0f);
+  }
+}
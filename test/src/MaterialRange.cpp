@@ -0,0 +1,67 @@
+#include <doctest/doctest.h>
+
+#include <common/mesh/MaterialRange.hpp>
+
+TEST_CASE("sortByMaterial") {
+  // Triangle t is (t, t, t), so the indices tell where each triangle went
+  std::vector<uint32_t> indices;
+  for (uint32_t t = 0; t < 6; ++t) indices.insert(indices.end(), {t, t, t});
+  std::vector<int> materialIds = {2, 0, 2, 1, 0, 2};
+
+  SUBCASE("Whole buffer") {
+    const std::vector<vkl::mesh::MaterialRange> ranges = vkl::mesh::sortByMaterial(indices, materialIds, 0, 18);
+
+    // Increasing materials, and the triangles of a material keep their order
+    CHECK(materialIds == std::vector<int>{0, 0, 1, 2, 2, 2});
+    for (uint32_t t = 0, expected[] = {1, 4, 3, 0, 2, 5}; t < 6; ++t) {
+      CHECK(indices[t * 3] == expected[t]);
+      CHECK(indices[t * 3 + 2] == expected[t]);
+    }
+
+    REQUIRE(ranges.size() == 3);
+    CHECK(ranges[0].firstIndex == 0);
+    CHECK(ranges[0].indexCount == 6);
+    CHECK(ranges[0].materialId == 0);
+    CHECK(ranges[1].firstIndex == 6);
+    CHECK(ranges[1].indexCount == 3);
+    CHECK(ranges[1].materialId == 1);
+    CHECK(ranges[2].firstIndex == 9);
+    CHECK(ranges[2].indexCount == 9);
+    CHECK(ranges[2].materialId == 2);
+
+    // Already grouped, nothing moves
+    const std::vector<uint32_t> sorted = indices;
+    CHECK(vkl::mesh::sortByMaterial(indices, materialIds, 0, 18).size() == 3);
+    CHECK(indices == sorted);
+  }
+
+  SUBCASE("Sub range") {
+    const std::vector<vkl::mesh::MaterialRange> ranges = vkl::mesh::sortByMaterial(indices, materialIds, 6, 9);
+
+    // Only the triangles 2 to 4 move
+    CHECK(materialIds == std::vector<int>{2, 0, 0, 1, 2, 2});
+    CHECK(indices[0] == 0);
+    CHECK(indices[6] == 4);
+    CHECK(indices[9] == 3);
+    CHECK(indices[12] == 2);
+    CHECK(indices[15] == 5);
+
+    REQUIRE(ranges.size() == 3);
+    CHECK(ranges[0].firstIndex == 6);
+    CHECK(ranges[2].firstIndex == 12);
+    CHECK(ranges[2].indexCount == 3);
+  }
+
+  SUBCASE("No material") {
+    materialIds.clear();
+    const std::vector<uint32_t> source = indices;
+    const std::vector<vkl::mesh::MaterialRange> ranges = vkl::mesh::sortByMaterial(indices, materialIds, 0, 18);
+
+    CHECK(indices == source);
+    REQUIRE(ranges.size() == 1);
+    CHECK(ranges[0].indexCount == 18);
+    CHECK(ranges[0].materialId == -1);
+  }
+
+  SUBCASE("Empty range") { CHECK(vkl::mesh::sortByMaterial(indices, materialIds, 0, 0).empty()); }
+}
@@ -0,0 +1,71 @@
+#include <doctest/doctest.h>
+
+#include <common/memory/MemoryStats.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("MemoryStats") {
+  std::vector<vkl::MemoryHeapStats> heaps(2);
+  heaps[0].size        = 8ull << 30;
+  heaps[0].deviceLocal = true;
+  heaps[0].blocks      = 1;
+  heaps[0].allocations = 2;
+  heaps[0].reserved    = 64 << 20;
+  heaps[0].used        = 3000;
+  heaps[0].peakUsed    = 5000;
+
+  heaps[0].category(vkl::MemoryCategory::Vertex)  = {1, 1000, 1000};
+  heaps[0].category(vkl::MemoryCategory::Texture) = {1, 2000, 4000};
+
+  SUBCASE("Names") {
+    CHECK(std::string(vkl::MemoryCategoryName(vkl::MemoryCategory::Vertex)) == "vertex");
+    CHECK(std::string(vkl::MemoryCategoryName(vkl::MemoryCategory::Grid)) == "grid");
+    CHECK(std::string(vkl::MemoryCategoryName(vkl::MemoryCategory::Other)) == "other");
+  }
+
+  SUBCASE("Without budget") {
+    std::ostringstream out;
+    vkl::WriteMemoryStats(out, heaps);
+    const std::string json = out.str();
+
+    CHECK(json.find("\"size\": 8589934592") != std::string::npos);
+    CHECK(json.find("\"deviceLocal\": true") != std::string::npos);
+    CHECK(json.find("\"deviceLocal\": false") != std::string::npos);
+    CHECK(json.find("\"peakUsed\": 5000") != std::string::npos);
+    CHECK(json.find("\"texture\": {\"allocations\": 1, \"used\": 2000, \"peak\": 4000}") != std::string::npos);
+    CHECK(json.find("\"budget\": null") != std::string::npos);
+    CHECK(json.find("\"usage\": null") != std::string::npos);
+  }
+
+  SUBCASE("With budget") {
+    heaps[0].budget = 6ull << 30;
+    heaps[0].usage  = 100 << 20;
+    heaps[1].budget = 1 << 30;
+
+    std::ostringstream out;
+    vkl::WriteMemoryStats(out, heaps);
+    const std::string json = out.str();
+
+    CHECK(json.find("\"budget\": 6442450944") != std::string::npos);
+    CHECK(json.find("\"usage\": 104857600") != std::string::npos);
+    CHECK(json.find("\"usage\": 0") != std::string::npos);
+    CHECK(json.find("null") == std::string::npos);
+  }
+
+  SUBCASE("Balanced") {
+    std::ostringstream out;
+    vkl::WriteMemoryStats(out, heaps);
+    const std::string json = out.str();
+
+    int depth = 0;
+    for (char c : json) {
+      if (c == '{' || c == '[') depth++;
+      if (c == '}' || c == ']') depth--;
+      CHECK(depth >= 0);
+    }
+    CHECK(depth == 0);
+    CHECK(json.front() == '{');
+  }
+}
@@ -0,0 +1,64 @@
+#include <doctest/doctest.h>
+
+#include <common/loader/MeshCache.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+TEST_CASE("MeshCache") {
+  const fs::path dir = fs::temp_directory_path() / "vkl_test_cache";
+  fs::create_directories(dir);
+
+  const std::string source = (dir / "source.obj").string();
+  std::ofstream(source) << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+
+  vkl::MeshData mesh;
+  mesh.vertices    = {{.pos = {0, 0, 0}}, {.pos = {1, 0, 0}}, {.pos = {0, 1, 0}}};
+  mesh.indices     = {0, 1, 2};
+  mesh.materialIds = {0};
+  mesh.materials   = {{.diffuse = {1, 0, 0}, .shininess = 8.0f}};
+  mesh.textures    = {"red.png"};
+
+  const std::string cachePath = vkl::MeshCache::Path(source, (dir / "cache").string());
+  REQUIRE(vkl::MeshCache::Write(cachePath, {source}, mesh));
+
+  SUBCASE("Read back") {
+    vkl::MeshData read;
+    REQUIRE(vkl::MeshCache::Read(cachePath, read));
+
+    REQUIRE(read.vertices.size() == 3);
+    CHECK(read.vertices[1].pos == mesh.vertices[1].pos);
+    CHECK(read.indices == mesh.indices);
+    CHECK(read.materialIds == mesh.materialIds);
+    REQUIRE(read.materials.size() == 1);
+    CHECK(read.materials[0].shininess == 8.0f);
+    CHECK(read.textures == mesh.textures);
+  }
+
+  SUBCASE("Touched source is still valid") {
+    fs::last_write_time(source, fs::last_write_time(source) + std::chrono::hours(1));
+
+    vkl::MeshData read;
+    CHECK(vkl::MeshCache::Read(cachePath, read));
+  }
+
+  SUBCASE("Modified source invalidates") {
+    std::ofstream(source) << "v 0 0 0\nv 2 0 0\nv 0 1 0\nf 1 2 3\n";
+    fs::last_write_time(source, fs::last_write_time(source) + std::chrono::hours(1));
+
+    vkl::MeshData read;
+    CHECK_FALSE(vkl::MeshCache::Read(cachePath, read));
+  }
+
+  SUBCASE("Corrupted cache is ignored") {
+    fs::resize_file(cachePath, fs::file_size(cachePath) / 2);
+
+    vkl::MeshData read;
+    CHECK_FALSE(vkl::MeshCache::Read(cachePath, read));
+  }
+
+  fs::remove_all(dir);
+}
@@ -0,0 +1,169 @@
+#include <doctest/doctest.h>
+
+#include <common/mesh/Meshlet.hpp>
+#include <common/mesh/Optimize.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+  // A closed UV sphere, so meshlets face every direction
+  vkl::MeshData makeSphere(uint32_t rings, uint32_t sectors) {
+    vkl::MeshData mesh;
+    for (uint32_t r = 0; r <= rings; ++r) {
+      for (uint32_t s = 0; s <= sectors; ++s) {
+        const float theta = 3.14159265f * r / rings, phi = 2.0f * 3.14159265f * s / sectors;
+        vkl::Vertex vertex{};
+        vertex.pos    = {std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)};
+        vertex.normal = vertex.pos;
+        mesh.vertices.push_back(vertex);
+      }
+    }
+    for (uint32_t r = 0; r < rings; ++r) {
+      for (uint32_t s = 0; s < sectors; ++s) {
+        const uint32_t a = r * (sectors + 1) + s, b = a + 1, c = a + sectors + 1, d = c + 1;
+        mesh.indices.insert(mesh.indices.end(), {a, b, c, b, d, c});
+        mesh.materialIds.insert(mesh.materialIds.end(), {static_cast<int>(r % 2), static_cast<int>(r % 2)});
+      }
+    }
+    return mesh;
+  }
+
+}  // namespace
+
+TEST_CASE("buildMeshlets") {
+  const vkl::MeshData mesh = makeSphere(40, 60);
+
+  for (uint32_t maxVertices : {3u, 16u, 64u, 255u}) {
+    for (uint32_t maxTriangles : {1u, 32u, 124u}) {
+      const vkl::mesh::Meshlets meshlets =
+          vkl::mesh::buildMeshlets(mesh.indices, mesh.vertices, maxVertices, maxTriangles);
+
+      std::string error;
+      CHECK_MESSAGE(
+          vkl::mesh::validateMeshlets(meshlets, mesh.indices, mesh.vertices.size(), maxVertices, maxTriangles, error),
+          error);
+    }
+  }
+}
+
+TEST_CASE("validateMeshlets") {
+  const vkl::MeshData mesh = makeSphere(8, 8);
+  vkl::mesh::Meshlets meshlets = vkl::mesh::buildMeshlets(mesh.indices, mesh.vertices, 16, 16);
+  REQUIRE(meshlets.meshlets.size() > 1);
+
+  std::string error;
+  REQUIRE(vkl::mesh::validateMeshlets(meshlets, mesh.indices, mesh.vertices.size(), 16, 16, error));
+
+  // A triangle twice
+  vkl::mesh::Meshlets duplicated = meshlets;
+  duplicated.triangles[3]       = duplicated.triangles[0];
+  duplicated.triangles[4]       = duplicated.triangles[1];
+  duplicated.triangles[5]       = duplicated.triangles[2];
+  CHECK_FALSE(vkl::mesh::validateMeshlets(duplicated, mesh.indices, mesh.vertices.size(), 16, 16, error));
+
+  // A triangle missing
+  vkl::mesh::Meshlets missing = meshlets;
+  missing.meshlets.back().triangleCount -= 1;
+  CHECK_FALSE(vkl::mesh::validateMeshlets(missing, mesh.indices, mesh.vertices.size(), 16, 16, error));
+
+  // Flipped winding
+  vkl::mesh::Meshlets flipped = meshlets;
+  std::swap(flipped.triangles[0], flipped.triangles[1]);
+  CHECK_FALSE(vkl::mesh::validateMeshlets(flipped, mesh.indices, mesh.vertices.size(), 16, 16, error));
+
+  // Limits
+  CHECK_FALSE(vkl::mesh::validateMeshlets(meshlets, mesh.indices, mesh.vertices.size(), 8, 16, error));
+}
+
+TEST_CASE("splitMeshlets") {
+  vkl::MeshData mesh = makeSphere(20, 30);
+  const std::vector<uint32_t> source = mesh.indices;
+
+  const vkl::mesh::Meshlets meshlets = vkl::mesh::splitMeshlets(mesh);
+
+  std::string error;
+  CHECK_MESSAGE(vkl::mesh::validateMeshlets(meshlets, source, mesh.vertices.size(), 64, 124, error), error);
+
+  // The index buffer now follows the meshlets, and the materials their triangles
+  for (const vkl::mesh::Meshlet& meshlet : meshlets.meshlets) {
+    for (uint32_t t = meshlet.triangleOffset; t < meshlet.triangleOffset + meshlet.triangleCount; ++t) {
+      for (int k = 0; k < 3; ++k) {
+        CHECK(mesh.indices[t * 3 + k] == meshlets.vertices[meshlet.vertexOffset + meshlets.triangles[t * 3 + k]]);
+      }
+      // Material of the ring : the lowest row of the triangle, 31 vertices per row
+      const uint32_t row = std::min({mesh.indices[t * 3], mesh.indices[t * 3 + 1], mesh.indices[t * 3 + 2]}) / 31;
+      CHECK(mesh.materialIds[t] == static_cast<int>(row % 2));
+
+      // A meshlet holds a single material
+      CHECK(mesh.materialIds[t] == mesh.materialIds[meshlet.triangleOffset]);
+    }
+  }
+
+  // Grouped by material, in increasing order
+  CHECK(std::is_sorted(mesh.materialIds.begin(), mesh.materialIds.end()));
+}
+
+TEST_CASE("splitMeshlets vertex cache") {
+  vkl::MeshData mesh = makeSphere(40, 60);
+  std::fill(mesh.materialIds.begin(), mesh.materialIds.end(), 0);
+
+  // The triangles as the greedy growth visits them
+  const vkl::mesh::Meshlets greedy = vkl::mesh::buildMeshlets(mesh.indices, mesh.vertices);
+  std::vector<uint32_t> greedyIndices;
+  for (const vkl::mesh::Meshlet& meshlet : greedy.meshlets) {
+    for (uint32_t i = meshlet.triangleOffset * 3; i < (meshlet.triangleOffset + meshlet.triangleCount) * 3; ++i) {
+      greedyIndices.push_back(greedy.vertices[meshlet.vertexOffset + greedy.triangles[i]]);
+    }
+  }
+
+  const std::vector<uint32_t> source = mesh.indices;
+  const vkl::mesh::Meshlets meshlets = vkl::mesh::splitMeshlets(mesh);
+
+  // Same meshlets, only the order of the triangles inside them changes
+  CHECK(meshlets.meshlets.size() == greedy.meshlets.size());
+  std::string error;
+  CHECK_MESSAGE(vkl::mesh::validateMeshlets(meshlets, source, mesh.vertices.size(), 64, 124, error), error);
+
+  const vkl::mesh::VertexCacheStats before = vkl::mesh::analyzeVertexCache(greedyIndices, mesh.vertices.size());
+  const vkl::mesh::VertexCacheStats after  = vkl::mesh::analyzeVertexCache(mesh.indices, mesh.vertices.size());
+  CHECK(after.acmr <= before.acmr);
+}
+
+TEST_CASE("MeshletBounds") {
+  const vkl::MeshData mesh = makeSphere(40, 60);
+  const vkl::mesh::Meshlets meshlets = vkl::mesh::buildMeshlets(mesh.indices, mesh.vertices);
+
+  const glm::vec3 camera(0.0f, 0.0f, 5.0f);
+  size_t culled = 0;
+
+  for (size_t m = 0; m < meshlets.meshlets.size(); ++m) {
+    const vkl::mesh::Meshlet& meshlet      = meshlets.meshlets[m];
+    const vkl::mesh::MeshletBounds& bounds = meshlets.bounds[m];
+
+    bool anyFrontFacing = false;
+    for (uint32_t t = 0; t < meshlet.triangleCount; ++t) {
+      glm::vec3 p[3];
+      for (int k = 0; k < 3; ++k) {
+        const uint32_t localIndex = meshlets.triangles[(meshlet.triangleOffset + t) * 3 + k];
+        p[k]                      = mesh.vertices[meshlets.vertices[meshlet.vertexOffset + localIndex]].pos;
+
+        // The sphere holds every vertex
+        CHECK(glm::length(p[k] - bounds.center) <= bounds.radius + 1e-5f);
+      }
+
+      const glm::vec3 normal = glm::cross(p[1] - p[0], p[2] - p[0]);
+      if (glm::length(normal) > 0.0f && glm::dot(normal, camera - p[0]) > 0.0f) anyFrontFacing = true;
+    }
+
+    // The cone test is conservative : never reject a meshlet with a visible triangle
+    if (vkl::mesh::isBackfacing(bounds, camera)) {
+      CHECK_FALSE(anyFrontFacing);
+      ++culled;
+    }
+  }
+
+  // The far side of the sphere is mostly rejected
+  CHECK(culled > meshlets.meshlets.size() / 4);
+}
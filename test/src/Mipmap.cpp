@@ -0,0 +1,55 @@
+#include <doctest/doctest.h>
+
+#include <common/image/Mipmap.hpp>
+
+TEST_CASE("mipLevels") {
+  CHECK(vkl::image::mipLevels(1, 1) == 1);
+  CHECK(vkl::image::mipLevels(256, 256) == 9);
+  CHECK(vkl::image::mipLevels(300, 37) == 9);
+  CHECK(vkl::image::mipLevels(1, 1024) == 11);
+
+  CHECK(vkl::image::mipSize(300, 8) == 1);
+  CHECK(vkl::image::mipSize(37, 5) == 1);
+  CHECK(vkl::image::mipChainSize(4, 2, 3) == (8 + 2 + 1) * 4);
+}
+
+TEST_CASE("buildMipChain") {
+  // 4x4 checkerboard of black and white, opaque
+  std::vector<uint8_t> checker;
+  for (uint32_t y = 0; y < 4; ++y) {
+    for (uint32_t x = 0; x < 4; ++x) {
+      const uint8_t c = (x + y) % 2 ? 255 : 0;
+      checker.insert(checker.end(), {c, c, c, 255});
+    }
+  }
+
+  SUBCASE("Linear") {
+    std::vector<uint8_t> pixels = checker;
+    vkl::image::buildMipChain(pixels, 4, 4, 3, false);
+
+    REQUIRE(pixels.size() == vkl::image::mipChainSize(4, 4, 3));
+    for (size_t i = 16 * 4; i < pixels.size(); i += 4) {
+      CHECK(pixels[i] == 128);
+      CHECK(pixels[i + 3] == 255);
+    }
+  }
+
+  SUBCASE("sRGB, averaged in linear space") {
+    std::vector<uint8_t> pixels = checker;
+    vkl::image::buildMipChain(pixels, 4, 4, 3, true);
+
+    // Half the light of white is 188 in sRGB, not 128
+    for (size_t i = 16 * 4; i < pixels.size(); i += 4) {
+      CHECK(pixels[i] == 188);
+      CHECK(pixels[i + 3] == 255);
+    }
+  }
+
+  SUBCASE("Odd size, the last column is repeated") {
+    std::vector<uint8_t> pixels = {0, 0, 0, 0, 100, 100, 100, 100, 200, 200, 200, 200};
+    vkl::image::buildMipChain(pixels, 3, 1, 2, false);
+
+    REQUIRE(pixels.size() == (3 + 1) * 4);
+    CHECK(pixels[12] == 50);
+  }
+}
@@ -0,0 +1,195 @@
+#include <doctest/doctest.h>
+
+#define TINYOBJLOADER_IMPLEMENTATION
+#include <tiny_obj_loader.h>
+
+#include <common/ThreadPool.hpp>
+#include <common/loader/ObjLoader.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+  std::string writeFile(const std::string& name, const std::string& content) {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+    std::ofstream(path, std::ios::binary) << content;
+    return path.string();
+  }
+
+  // Flatten a tinyobj result the way Model did before ObjLoader
+  void checkSameAsTinyObj(const std::string& objPath, const vkl::ObjData& obj) {
+    tinyobj::attrib_t attrib;
+    std::vector<tinyobj::shape_t> shapes;
+    std::vector<tinyobj::material_t> materials;
+    std::string err;
+
+    const std::string baseDir = (std::filesystem::temp_directory_path() / "").string();
+    REQUIRE(tinyobj::LoadObj(&attrib, &shapes, &materials, &err, objPath.c_str(), baseDir.c_str()));
+
+    size_t corner = 0, triangle = 0;
+    for (const auto& shape : shapes) {
+      for (const auto& index : shape.mesh.indices) {
+        REQUIRE(corner < obj.vertices.size());
+        const vkl::Vertex& vertex = obj.vertices[corner++];
+
+        CHECK(vertex.pos.x == attrib.vertices[3 * index.vertex_index + 0]);
+        CHECK(vertex.pos.y == attrib.vertices[3 * index.vertex_index + 1]);
+        CHECK(vertex.pos.z == attrib.vertices[3 * index.vertex_index + 2]);
+
+        if (index.normal_index >= 0) {
+          CHECK(vertex.normal.x == attrib.normals[3 * index.normal_index + 0]);
+          CHECK(vertex.normal.y == attrib.normals[3 * index.normal_index + 1]);
+          CHECK(vertex.normal.z == attrib.normals[3 * index.normal_index + 2]);
+        }
+
+        if (index.texcoord_index >= 0) {
+          CHECK(vertex.texCoord.x == attrib.texcoords[2 * index.texcoord_index + 0]);
+          CHECK(vertex.texCoord.y == 1.0f - attrib.texcoords[2 * index.texcoord_index + 1]);
+        }
+      }
+
+      for (int materialId : shape.mesh.material_ids) {
+        REQUIRE(triangle < obj.materialIds.size());
+        CHECK(obj.materialIds[triangle++] == materialId);
+      }
+    }
+    CHECK(corner == obj.vertices.size());
+    CHECK(triangle == obj.materialIds.size());
+
+    REQUIRE(materials.size() == obj.materials.size());
+    for (size_t i = 0; i < materials.size(); ++i) {
+      CHECK(obj.materials[i].name == materials[i].name);
+      CHECK(obj.materials[i].material.diffuse.r == materials[i].diffuse[0]);
+      CHECK(obj.materials[i].material.specular.g == materials[i].specular[1]);
+      CHECK(obj.materials[i].material.shininess == materials[i].shininess);
+      CHECK(obj.materials[i].diffuseTexname == materials[i].diffuse_texname);
+    }
+  }
+
+  // Rebuild what Load returns from the parts Stream gives
+  vkl::ObjData streamObj(const std::string& objPath, size_t chunkSize) {
+    std::vector<float> positions, normals, texcoords;
+    vkl::ObjData obj;
+
+    vkl::ObjLoader::Stream(
+        objPath, chunkSize,
+        [&](const vkl::ObjChunk& chunk) {
+          positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+          normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+          texcoords.insert(texcoords.end(), chunk.texcoords.begin(), chunk.texcoords.end());
+
+          for (const vkl::ObjCorner& corner : chunk.corners) {
+            vkl::Vertex vertex{};
+            vertex.pos   = {positions[3 * corner.v + 0], positions[3 * corner.v + 1], positions[3 * corner.v + 2]};
+            vertex.color = {1.0f, 1.0f, 1.0f};
+            if (corner.vn >= 0) {
+              vertex.normal = {normals[3 * corner.vn + 0], normals[3 * corner.vn + 1], normals[3 * corner.vn + 2]};
+            }
+            if (corner.vt >= 0) vertex.texCoord = {texcoords[2 * corner.vt + 0], 1.0f - texcoords[2 * corner.vt + 1]};
+            obj.vertices.push_back(vertex);
+          }
+          obj.materialIds.insert(obj.materialIds.end(), chunk.materialIds.begin(), chunk.materialIds.end());
+        },
+        obj);
+
+    return obj;
+  }
+
+}  // namespace
+
+TEST_CASE("ObjLoader") {
+  writeFile("vkl_test.mtl",
+            "newmtl red\n"
+            "Kd 1 0 0\n"
+            "Ks 0.5 0.5 0.5\n"
+            "Ns 32\n"
+            "map_Kd red.png\n"
+            "\n"
+            "newmtl blue\r\n"
+            "Kd 0 0 1\r\n");
+
+  const std::string objPath = writeFile("vkl_test.obj",
+                                        "# comment\n"
+                                        "mtllib vkl_test.mtl\n"
+                                        "v 0 0 0\n"
+                                        "v 1 0 0\n"
+                                        "v 1 1 0\n"
+                                        "v 0 1 +1.5e-1\n"
+                                        "vt 0 0\n"
+                                        "vt 1 0\n"
+                                        "vt 1 1\n"
+                                        "vt 0 1\n"
+                                        "vn 0 0 1\n"
+                                        "f 1/1/1 2/2/1 3/3/1\n"
+                                        "usemtl red\n"
+                                        "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+                                        "usemtl blue\r\n"
+                                        "f -4//-1 -3//-1 -2//-1\n"
+                                        "usemtl unknown\n"
+                                        "f 1 3 4\n");
+
+  const vkl::ObjData obj = vkl::ObjLoader::Load(objPath);
+
+  CHECK(obj.vertices.size() == 4 * 3);
+  CHECK(obj.materials.size() == 2);
+  checkSameAsTinyObj(objPath, obj);
+
+  SUBCASE("Stream") {
+    // Parts smaller than a line make the buffer grow
+    for (size_t chunkSize : {size_t(4), size_t(64), size_t(1) << 20}) {
+      const vkl::ObjData streamed = streamObj(objPath, chunkSize);
+      CHECK(streamed.materialFiles == obj.materialFiles);
+      checkSameAsTinyObj(objPath, streamed);
+    }
+  }
+}
+
+TEST_CASE("ObjLoader chunks") {
+  // Big enough to be split, with relative indices crossing the chunk boundaries
+  std::ostringstream content;
+  for (int i = 0; i < 100000; ++i) {
+    content << "v " << i * 0.25f << ' ' << -i * 0.5f << ' ' << i % 7 << '\n';
+    content << "vt " << (i % 10) * 0.1f << ' ' << (i % 3) * 0.3f << '\n';
+    if (i >= 3) {
+      if (i % 2 == 0) {
+        content << "f -1/-1 -2/-2 -3/-3 -4/-4\n";
+      } else {
+        content << "f " << i << '/' << i << ' ' << (i / 2 + 1) << ' ' << 1 << "/1\n";
+      }
+    }
+  }
+
+  const std::string objPath = writeFile("vkl_test_chunks.obj", content.str());
+
+  vkl::ThreadPool pool(4);
+  const vkl::ObjData obj = vkl::ObjLoader::Load(objPath, pool);
+
+  checkSameAsTinyObj(objPath, obj);
+  checkSameAsTinyObj(objPath, streamObj(objPath, 4096));
+}
+
+TEST_CASE("ObjLoader chunk errors") {
+  // A bad face in the first chunk, while the others are still being resolved
+  std::ostringstream content;
+  content << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 1000000\n";
+  for (int i = 0; i < 100000; ++i) content << "v " << i << " 0 0\nf -1 -2 -3\n";
+
+  vkl::ThreadPool pool(4);
+  CHECK_THROWS(vkl::ObjLoader::Load(writeFile("vkl_test_chunk_errors.obj", content.str()), pool));
+}
+
+TEST_CASE("ObjLoader errors") {
+  CHECK_THROWS(vkl::ObjLoader::Load("does_not_exist.obj"));
+  CHECK_THROWS(vkl::ObjLoader::Load(writeFile("vkl_test_empty.obj", "v 0 0 0\n")));
+
+  vkl::ObjData obj;
+  const auto ignore = [](const vkl::ObjChunk&) {};
+  CHECK_THROWS(vkl::ObjLoader::Stream("does_not_exist.obj", 4096, ignore, obj));
+  CHECK_THROWS(vkl::ObjLoader::Stream(writeFile("vkl_test_empty.obj", "v 0 0 0\n"), 4096, ignore, obj));
+  // The vertices come after the face, in the next part
+  CHECK_THROWS(vkl::ObjLoader::Stream(writeFile("vkl_test_forward.obj", "f 1 2 3\nv 0 0 0\nv 1 0 0\nv 0 1 0\n"), 8,
+                                      ignore, obj));
+}
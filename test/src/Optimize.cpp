@@ -0,0 +1,77 @@
+#include <doctest/doctest.h>
+
+#include <common/mesh/Optimize.hpp>
+
+#include <algorithm>
+
+namespace {
+
+  // A n x n grid of quads, its triangles in a cache unfriendly order (columns of rows)
+  vkl::MeshData makeGrid(uint32_t n) {
+    vkl::MeshData mesh;
+    for (uint32_t y = 0; y <= n; ++y) {
+      for (uint32_t x = 0; x <= n; ++x) {
+        vkl::Vertex vertex{};
+        vertex.pos    = {static_cast<float>(x), static_cast<float>(y), 0.0f};
+        vertex.normal = {0.0f, 0.0f, 1.0f};
+        mesh.vertices.push_back(vertex);
+      }
+    }
+    for (uint32_t x = 0; x < n; ++x) {
+      for (uint32_t y = 0; y < n; ++y) {
+        const uint32_t a = y * (n + 1) + x, b = a + 1, c = a + n + 1, d = c + 1;
+        mesh.indices.insert(mesh.indices.end(), {a, b, d, a, d, c});
+        mesh.materialIds.insert(mesh.materialIds.end(), {static_cast<int>(x % 2), static_cast<int>(y % 3)});
+      }
+    }
+    return mesh;
+  }
+
+  // Triangles as sorted (material, positions) so two meshes can be compared whatever their order
+  std::vector<std::vector<float>> triangles(const vkl::MeshData& mesh) {
+    std::vector<std::vector<float>> result;
+    for (size_t t = 0; t < mesh.indices.size() / 3; ++t) {
+      std::vector<float> triangle = {static_cast<float>(mesh.materialIds[t])};
+      for (int k = 0; k < 3; ++k) {
+        const glm::vec3& pos = mesh.vertices[mesh.indices[t * 3 + k]].pos;
+        triangle.insert(triangle.end(), {pos.x, pos.y, pos.z});
+      }
+      result.push_back(triangle);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+}  // namespace
+
+TEST_CASE("analyzeVertexCache") {
+  // Two triangles sharing an edge : 4 vertices transformed
+  const vkl::mesh::VertexCacheStats stats = vkl::mesh::analyzeVertexCache({0, 1, 2, 2, 1, 3}, 4);
+  CHECK(stats.acmr == doctest::Approx(2.0f));
+  CHECK(stats.atvr == doctest::Approx(1.0f));
+}
+
+TEST_CASE("optimizeMesh") {
+  vkl::MeshData mesh = makeGrid(64);
+
+  // One vertex nobody uses, removed by the fetch pass
+  mesh.vertices.push_back(mesh.vertices.front());
+
+  const auto reference = triangles(mesh);
+  const vkl::mesh::OptimizeStats stats = vkl::mesh::optimizeMesh(mesh);
+
+  CHECK(mesh.vertices.size() == 65 * 65);
+  CHECK(mesh.materialIds.size() == mesh.indices.size() / 3);
+  CHECK(triangles(mesh) == reference);
+
+  CHECK(stats.after.acmr < stats.before.acmr);
+  CHECK(stats.after.acmr < 1.0f);
+  CHECK(stats.after.atvr < 1.5f);
+
+  // Vertices are numbered in order of first use
+  uint32_t next = 0;
+  for (uint32_t index : mesh.indices) {
+    CHECK(index <= next);
+    if (index == next) ++next;
+  }
+}
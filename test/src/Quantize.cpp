@@ -0,0 +1,61 @@
+#include <doctest/doctest.h>
+
+#include <common/mesh/Quantize.hpp>
+
+#include <cmath>
+
+TEST_CASE("CompactVertex") {
+  CHECK(sizeof(vkl::CompactVertex) == 16);
+
+  VkVertexInputBindingDescription bindingDescription = vkl::CompactVertex::getBindingDescription();
+  CHECK(bindingDescription.binding == 0);
+  CHECK(bindingDescription.stride == sizeof(vkl::CompactVertex));
+}
+
+TEST_CASE("Quantize") {
+  std::vector<vkl::Vertex> vertices;
+  for (int i = 0; i < 1000; ++i) {
+    const float a = i * 0.37f, b = i * 1.91f;
+    vkl::Vertex vertex{};
+    vertex.pos      = {std::cos(a) * 10.0f, std::sin(b) * 3.0f - 5.0f, i * 0.01f};
+    vertex.normal   = glm::normalize(glm::vec3(std::cos(a) * std::sin(b), std::sin(a) * std::sin(b), std::cos(b)));
+    vertex.color    = {1.0f, 1.0f, 1.0f};
+    vertex.texCoord = {(i % 100) / 100.0f, 1.0f - (i % 37) / 37.0f};
+    vertices.push_back(vertex);
+  }
+
+  const vkl::Quantization quantization = vkl::mesh::computeQuantization(vertices);
+  const std::vector<vkl::CompactVertex> compact = vkl::mesh::compressVertices(vertices, quantization);
+
+  REQUIRE(compact.size() == vertices.size());
+
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    const vkl::Vertex decoded = vkl::mesh::decompressVertex(compact[i], quantization);
+
+    for (int c = 0; c < 3; ++c) {
+      // Half a quantization step
+      CHECK(std::abs(decoded.pos[c] - vertices[i].pos[c]) <= quantization.scale[c] / 65535.0f);
+    }
+
+    // Octahedral on 2x16 bits keeps the direction to a few thousandths of a degree
+    CHECK(glm::dot(decoded.normal, vertices[i].normal) > 0.99999f);
+
+    CHECK(std::abs(decoded.texCoord.x - vertices[i].texCoord.x) < 1e-3f);
+    CHECK(std::abs(decoded.texCoord.y - vertices[i].texCoord.y) < 1e-3f);
+  }
+}
+
+TEST_CASE("Quantize degenerate") {
+  // A flat model (every z = 2) and a vertex without normal
+  std::vector<vkl::Vertex> vertices(2);
+  vertices[0].pos = {0.0f, 0.0f, 2.0f};
+  vertices[1].pos = {1.0f, 1.0f, 2.0f};
+
+  const vkl::Quantization quantization = vkl::mesh::computeQuantization(vertices);
+  CHECK(quantization.scale.z == 1.0f);
+
+  const vkl::Vertex decoded = vkl::mesh::decompressVertex(vkl::mesh::compressVertex(vertices[1], quantization),
+                                                          quantization);
+  CHECK(decoded.pos.z == 2.0f);
+  CHECK(std::isfinite(decoded.normal.x));
+}
@@ -0,0 +1,38 @@
+#include <doctest/doctest.h>
+
+#include <common/image/SamplerCache.hpp>
+#include <stdexcept>
+
+TEST_CASE("SamplerCache::MakeKey") {
+  VkSamplerCreateInfo info = {
+      .sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+      .magFilter    = VK_FILTER_LINEAR,
+      .minFilter    = VK_FILTER_LINEAR,
+      .mipmapMode   = VK_SAMPLER_MIPMAP_MODE_LINEAR,
+      .addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+      .addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+      .addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+      .maxLod       = VK_LOD_CLAMP_NONE,
+  };
+  const vkl::SamplerCache::Key key = vkl::SamplerCache::MakeKey(info);
+  const vkl::SamplerCache::Hash hash;
+
+  CHECK(vkl::SamplerCache::MakeKey(info) == key);
+  CHECK(hash(vkl::SamplerCache::MakeKey(info)) == hash(key));
+
+  SUBCASE("Any parameter makes another key") {
+    info.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    CHECK_FALSE(vkl::SamplerCache::MakeKey(info) == key);
+    CHECK(hash(vkl::SamplerCache::MakeKey(info)) != hash(key));
+
+    info.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    info.maxLod       = 1.0f;
+    CHECK_FALSE(vkl::SamplerCache::MakeKey(info) == key);
+  }
+
+  SUBCASE("Extension structures can't be keyed") {
+    const int extension = 0;
+    info.pNext          = &extension;
+    CHECK_THROWS_AS(vkl::SamplerCache::MakeKey(info), std::runtime_error);
+  }
+}
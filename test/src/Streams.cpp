@@ -0,0 +1,56 @@
+#include <doctest/doctest.h>
+
+#include <common/mesh/Quantize.hpp>
+#include <common/mesh/Streams.hpp>
+#include <common/misc/GraphicsPipeline.hpp>
+
+#include <cstring>
+
+TEST_CASE("VertexStreams") {
+  std::vector<vkl::Vertex> vertices(3);
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    vertices[i].pos      = {i + 0.5f, i + 1.5f, i + 2.5f};
+    vertices[i].normal   = {0.0f, 0.0f, 1.0f};
+    vertices[i].color    = {1.0f, 0.0f, 0.0f};
+    vertices[i].texCoord = {i * 0.25f, 1.0f};
+  }
+
+  const vkl::mesh::VertexStreams streams = vkl::mesh::splitStreams(vertices);
+  REQUIRE(streams.positions.size() == vertices.size() * sizeof(glm::vec3));
+  REQUIRE(streams.attributes.size() == vertices.size() * (sizeof(vkl::Vertex) - sizeof(glm::vec3)));
+
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    glm::vec3 pos;
+    std::memcpy(&pos, &streams.positions[i * sizeof(glm::vec3)], sizeof(pos));
+    CHECK(pos == vertices[i].pos);
+
+    const size_t attributeSize = sizeof(vkl::Vertex) - sizeof(glm::vec3);
+    CHECK(std::memcmp(&streams.attributes[i * attributeSize],
+                      reinterpret_cast<const uint8_t*>(&vertices[i]) + sizeof(glm::vec3),
+                      attributeSize)
+          == 0);
+  }
+}
+
+TEST_CASE("splitVertexInput") {
+  std::vector<VkVertexInputBindingDescription> bindings;
+  std::vector<VkVertexInputAttributeDescription> attributes;
+
+  vkl::misc::splitVertexInput<vkl::CompactVertex>(false, bindings, attributes);
+  REQUIRE(bindings.size() == 2);
+  CHECK(bindings[0].stride == 8);
+  CHECK(bindings[1].stride == 8);
+  REQUIRE(attributes.size() == 3);
+  CHECK(attributes[0].binding == 0);
+  CHECK(attributes[0].offset == 0);
+  CHECK(attributes[1].binding == 1);
+  CHECK(attributes[1].offset == 0);
+  CHECK(attributes[2].binding == 1);
+  CHECK(attributes[2].offset == 4);
+
+  vkl::misc::splitVertexInput<vkl::Vertex>(true, bindings, attributes);
+  REQUIRE(bindings.size() == 1);
+  CHECK(bindings[0].stride == sizeof(glm::vec3));
+  REQUIRE(attributes.size() == 1);
+  CHECK(attributes[0].location == 0);
+}
@@ -0,0 +1,83 @@
+#include <doctest/doctest.h>
+
+#include <common/image/SharedCache.hpp>
+#include <common/image/TextureCache.hpp>
+#include <memory>
+#include <stdexcept>
+
+TEST_CASE("TextureCache::MakeKey") {
+  const vkl::TextureCache::Key key = vkl::TextureCache::MakeKey("assets/textures/blank.png");
+
+  // Every path to the same file gives the same key
+  CHECK(vkl::TextureCache::MakeKey("assets/../assets/textures/./blank.png") == key);
+  CHECK(vkl::TextureCache::MakeKey(key.path) == key);
+
+  // But not another file, or another format
+  CHECK_FALSE(vkl::TextureCache::MakeKey("assets/textures/viking_room.png") == key);
+  CHECK_FALSE(vkl::TextureCache::MakeKey("assets/textures/blank.png", VK_FORMAT_R8G8B8A8_UNORM) == key);
+}
+
+namespace {
+
+  // Stands for a Texture, only its size matters to the cache
+  struct FakeTexture {
+    size_t bytes;
+    inline size_t size() const { return bytes; }
+  };
+
+}  // namespace
+
+TEST_CASE("TextureCache::acquire") {
+  vkl::SharedCache<vkl::TextureCache::Key, FakeTexture> cache;
+  int created = 0;
+  const auto create = [&created] {
+    created++;
+    return std::make_shared<FakeTexture>(FakeTexture{1024});
+  };
+
+  const vkl::TextureCache::Key key = vkl::TextureCache::MakeKey("assets/textures/blank.png");
+  const std::shared_ptr<FakeTexture> first = cache.acquire(key, create);
+
+  // The same file through another path is a hit, the texture is created once
+  const std::shared_ptr<FakeTexture> second =
+      cache.acquire(vkl::TextureCache::MakeKey("assets/../assets/textures/blank.png"), create);
+  CHECK(second == first);
+  CHECK(created == 1);
+  CHECK(cache.contains(key));
+
+  auto stats = cache.stats();
+  CHECK(stats.hits == 1);
+  CHECK(stats.misses == 1);
+  CHECK(stats.entries == 1);
+  CHECK(stats.residentBytes == 1024);
+
+  // Another format is another texture
+  std::shared_ptr<FakeTexture> unorm =
+      cache.acquire(vkl::TextureCache::MakeKey("assets/textures/blank.png", VK_FORMAT_R8G8B8A8_UNORM), create);
+  CHECK(unorm != first);
+  stats = cache.stats();
+  CHECK(stats.hits == 1);
+  CHECK(stats.misses == 2);
+  CHECK(stats.residentBytes == 2048);
+
+  SUBCASE("A failed load is neither cached nor counted") {
+    const vkl::TextureCache::Key missing = vkl::TextureCache::MakeKey("assets/textures/missing.png");
+    CHECK_THROWS(cache.acquire(missing, []() -> std::shared_ptr<FakeTexture> { throw std::runtime_error("missing"); }));
+    CHECK_FALSE(cache.contains(missing));
+    CHECK(cache.stats().misses == 2);
+  }
+
+  SUBCASE("trim releases what only the cache holds") {
+    const std::weak_ptr<FakeTexture> released = unorm;
+    cache.trim();
+    CHECK(cache.stats().entries == 2);
+
+    unorm.reset();
+    cache.trim();
+    CHECK(released.expired());
+    CHECK(cache.contains(key));
+    stats = cache.stats();
+    CHECK(stats.entries == 1);
+    CHECK(stats.residentBytes == 1024);
+  }
+}
@@ -0,0 +1,71 @@
+#include <doctest/doctest.h>
+
+#include <common/memory/Tlsf.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+TEST_CASE("Tlsf") {
+  vkl::Tlsf tlsf(1 << 20);
+
+  SUBCASE("Aligned and disjoint") {
+    const vkl::Tlsf::Allocation a = tlsf.allocate(100, 256);
+    const vkl::Tlsf::Allocation b = tlsf.allocate(3, 1);
+    const vkl::Tlsf::Allocation c = tlsf.allocate(1000, 4096);
+    REQUIRE(a.node != vkl::Tlsf::Invalid);
+    REQUIRE(b.node != vkl::Tlsf::Invalid);
+    REQUIRE(c.node != vkl::Tlsf::Invalid);
+
+    CHECK(a.offset % 256 == 0);
+    CHECK(c.offset % 4096 == 0);
+    CHECK((b.offset >= a.offset + a.size || b.offset + b.size <= a.offset));
+    CHECK((c.offset >= b.offset + b.size || c.offset + c.size <= b.offset));
+    CHECK(tlsf.used() == 1103);
+    CHECK(tlsf.count() == 3);
+  }
+
+  SUBCASE("Too large") {
+    CHECK(tlsf.allocate(2 << 20).node == vkl::Tlsf::Invalid);
+
+    const vkl::Tlsf::Allocation half = tlsf.allocate(512 << 10);
+    REQUIRE(half.node != vkl::Tlsf::Invalid);
+    CHECK(tlsf.allocate((512 << 10) + 1).node == vkl::Tlsf::Invalid);
+    CHECK(tlsf.allocate(512 << 10).offset == 512 << 10);
+    CHECK(tlsf.allocate(1).node == vkl::Tlsf::Invalid);
+  }
+
+  SUBCASE("Freed ranges merge") {
+    // Random sizes and alignments, freed in a random order, checked against each other
+    std::mt19937 random(42);
+    std::vector<vkl::Tlsf::Allocation> live;
+    for (int i = 0; i < 2000; ++i) {
+      if (!live.empty() && random() % 3 == 0) {
+        const size_t index = random() % live.size();
+        tlsf.free(live[index].node);
+        live.erase(live.begin() + index);
+        continue;
+      }
+
+      const uint64_t alignment          = uint64_t(1) << (random() % 9);
+      const vkl::Tlsf::Allocation range = tlsf.allocate(1 + random() % 4000, alignment);
+      if (range.node == vkl::Tlsf::Invalid) continue;
+
+      CHECK(range.offset % alignment == 0);
+      CHECK(range.offset + range.size <= tlsf.size());
+      live.push_back(range);
+    }
+
+    std::vector<vkl::Tlsf::Allocation> sorted = live;
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.offset < b.offset; });
+    for (size_t i = 1; i < sorted.size(); ++i) CHECK(sorted[i - 1].offset + sorted[i - 1].size <= sorted[i].offset);
+
+    std::shuffle(live.begin(), live.end(), random);
+    for (const vkl::Tlsf::Allocation& range : live) tlsf.free(range.node);
+    CHECK(tlsf.empty());
+    CHECK(tlsf.used() == 0);
+
+    // A single range again, half the block fits
+    CHECK(tlsf.allocate(512 << 10).offset == 0);
+  }
+}